@@ -0,0 +1,32 @@
+#pragma once
+
+// Small helpers shared by the benchmarks: percentile reporting over collected samples.
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace bench
+{
+
+inline void report(const char* label, std::vector<double>& samples, const char* unit)
+{
+    if (samples.empty())
+    {
+        std::printf("%-40s no samples\n", label);
+        return;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[static_cast<size_t>(q * (samples.size() - 1))]; };
+    double sum = 0;
+    for (double s : samples)
+    {
+        sum += s;
+    }
+
+    std::printf("%-40s n=%-8zu mean=%9.2f p50=%9.2f p99=%9.2f p99.9=%9.2f max=%9.2f %s\n",
+                label, samples.size(), sum / samples.size(), at(0.50), at(0.99), at(0.999), samples.back(), unit);
+}
+
+} // namespace bench
@@ -0,0 +1,87 @@
+// Cost of reading the time: TscClock against steady_clock, system_clock and clock_gettime.
+// Each sample is the mean over a batch of back-to-back calls (throughput, as in a receive loop
+// stamping every message). Tracking reports how far TscClock::now() strays from steady_clock.
+//
+// Usage: clock_benchmark [calls=1000000] [runs=20]
+
+#include <slick/socket/clock.h>
+#include "bench_util.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <time.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+using namespace slick::socket;
+
+template<typename ReadT>
+static void measure(const char* label, size_t calls, int runs, ReadT&& read)
+{
+    std::vector<double> samples;
+    uint64_t sink = 0;
+    for (int run = 0; run < runs; ++run)
+    {
+        auto start = Clock::now();
+        for (size_t i = 0; i < calls; ++i)
+        {
+            sink += static_cast<uint64_t>(read());
+        }
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls);
+    }
+    bench::report(label, samples, "ns/call");
+    if (sink == 42)
+    {
+        std::printf("\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t calls = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    std::printf("invariant counter: %s\n", TscClock::invariant() ? "yes" : "no (steady_clock fallback)");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));    // past the calibration baseline
+
+    measure("steady_clock::now()", calls, runs, [] { return Clock::now().time_since_epoch().count(); });
+    measure("system_clock::now()", calls, runs,
+            [] { return std::chrono::system_clock::now().time_since_epoch().count(); });
+#if !defined(_WIN32)
+    measure("clock_gettime(CLOCK_MONOTONIC)", calls, runs, [] {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_nsec;
+    });
+    measure("clock_gettime(CLOCK_REALTIME)", calls, runs, [] {
+        timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        return ts.tv_nsec;
+    });
+#endif
+    measure("TscClock::ticks()", calls, runs, [] { return TscClock::ticks(); });
+    measure("TscClock::ticks_ordered()", calls, runs, [] { return TscClock::ticks_ordered(); });
+    measure("TscClock::now_ns()", calls, runs, [] { return TscClock::now_ns(); });
+    measure("TscClock::realtime_ns()", calls, runs, [] { return TscClock::realtime_ns(); });
+
+    // Tracking: distance from steady_clock, bracketed by two steady_clock reads
+    std::vector<double> error;
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto before = Clock::now().time_since_epoch().count();
+        int64_t tsc = TscClock::now_ns();
+        auto after = Clock::now().time_since_epoch().count();
+        double middle = (static_cast<double>(before) + static_cast<double>(after)) / 2;
+        double distance = static_cast<double>(tsc) - middle;
+        error.push_back(distance < 0 ? -distance : distance);
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+    bench::report("|TscClock - steady_clock|", error, "ns");
+    return 0;
+}
@@ -0,0 +1,106 @@
+// Cost of false sharing between an event loop and threads that monitor it.
+//
+// One loop thread updates its private state and statistics while monitoring threads poll the
+// running flag, as is_running() does. With the pre-isolation layout the flag, the statistics and
+// the loop state share a cache line, so every monitor read pulls the line away from the loop.
+// The isolated layout mirrors the cache_line_size grouping now used by the socket classes.
+// Run on a machine with at least monitors + 1 free cores; on fewer cores the threads time-slice
+// and the two layouts converge.
+//
+// Usage: false_sharing_benchmark [monitors=3] [batches=50] [iterations_per_batch=1000000]
+
+#include <slick/socket/cache_line.h>
+#include "bench_util.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using slick::socket::cache_line_size;
+
+// Flag, counters and loop state packed together, as before the layout audit
+struct PackedLayout
+{
+    std::atomic_bool running{true};
+    std::atomic<uint64_t> packets{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> loop_state[4]{};
+};
+
+// Control flag, statistics and loop state each on their own cache line
+struct IsolatedLayout
+{
+    alignas(cache_line_size) std::atomic_bool running{true};
+    alignas(cache_line_size) std::atomic<uint64_t> packets{0};
+    std::atomic<uint64_t> bytes{0};
+    alignas(cache_line_size) std::atomic<uint64_t> loop_state[4]{};
+};
+
+template<typename LayoutT>
+void run(const char* label, int monitors, int batches, int iterations)
+{
+    LayoutT layout;
+    std::atomic_bool done{false};
+    std::atomic<uint64_t> monitor_reads{0};
+
+    std::vector<std::thread> threads;
+    for (int m = 0; m < monitors; ++m)
+    {
+        threads.emplace_back([&]() {
+            uint64_t reads = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                reads += layout.running.load(std::memory_order_relaxed) ? 1 : 0;
+            }
+            monitor_reads.fetch_add(reads, std::memory_order_relaxed);
+        });
+    }
+
+    // Loop thread: touch private state every iteration, bump statistics every 16th (one "datagram")
+    std::vector<double> samples;
+    samples.reserve(batches);
+    auto started = Clock::now();
+    for (int b = 0; b < batches; ++b)
+    {
+        auto batch_start = Clock::now();
+        for (int i = 0; i < iterations && layout.running.load(std::memory_order_relaxed); ++i)
+        {
+            auto& slot = layout.loop_state[i & 3];
+            slot.store(slot.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if ((i & 15) == 0)
+            {
+                layout.packets.fetch_add(1, std::memory_order_relaxed);
+                layout.bytes.fetch_add(64, std::memory_order_relaxed);
+            }
+        }
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - batch_start).count() / iterations);
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+
+    done.store(true, std::memory_order_relaxed);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    bench::report(label, samples, "ns/iteration");
+    std::printf("%-40s %.1f M monitor reads/s\n", "", monitor_reads.load() / seconds / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+    int monitors = argc > 1 ? std::atoi(argv[1]) : 3;
+    int batches = argc > 2 ? std::atoi(argv[2]) : 50;
+    int iterations = argc > 3 ? std::atoi(argv[3]) : 1000000;
+
+    std::printf("%d monitoring threads, %u hardware threads, cache line %zu bytes\n",
+                monitors, std::thread::hardware_concurrency(), cache_line_size);
+    run<PackedLayout>("packed layout (loop thread)", monitors, batches, iterations);
+    run<IsolatedLayout>("isolated layout (loop thread)", monitors, batches, iterations);
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Overhead of TraitsT::enable_loop_monitor on the loop thread: the per-wake-up bookkeeping
+// (loop_idle() + loop_busy()) and timing one callback (callback_scope() with its histogram
+// record). Each sample is the mean over a batch of back-to-back iterations.
+//
+// Usage: loop_monitor_benchmark [iterations=1000000] [runs=20]
+
+#include <slick/socket/watchdog.h>
+#include "bench_util.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using namespace slick::socket;
+
+template<typename BodyT>
+static void measure(const char* label, size_t iterations, int runs, BodyT&& body)
+{
+    std::vector<double> samples;
+    for (int run = 0; run < runs; ++run)
+    {
+        auto start = Clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            body(i);
+        }
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations);
+    }
+    bench::report(label, samples, "ns/iteration");
+}
+
+int main(int argc, char** argv)
+{
+    size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));    // past TscClock's calibration baseline
+    auto monitor = std::make_unique<LoopMonitor>();
+    std::atomic<uint64_t> handled{0};
+
+    measure("loop_idle() + loop_busy()", iterations, runs, [&](size_t) {
+        monitor->loop_idle();
+        monitor->loop_busy();
+    });
+    measure("callback_scope()", iterations, runs, [&](size_t i) {
+        auto timing = monitor->callback_scope(LoopCallback::Data, static_cast<int>(i & 63));
+        handled.store(i, std::memory_order_relaxed);
+    });
+    measure("wake-up with one timed callback", iterations, runs, [&](size_t i) {
+        monitor->loop_idle();
+        monitor->loop_busy();
+        auto timing = monitor->callback_scope(LoopCallback::Data, static_cast<int>(i & 63));
+        handled.store(i, std::memory_order_relaxed);
+    });
+
+    // The same loop with the monitor compiled out, for reference
+    NoLoopMonitor none;
+    measure("NoLoopMonitor (disabled)", iterations, runs, [&](size_t i) {
+        none.loop_idle();
+        none.loop_busy();
+        auto timing = none.callback_scope(LoopCallback::Data, static_cast<int>(i & 63));
+        handled.store(i, std::memory_order_relaxed);
+    });
+
+    const LatencyHistogram& data = monitor->callback_histogram(LoopCallback::Data);
+    std::printf("timed callbacks: %llu, p50 %llu ns, p99 %llu ns\n", static_cast<unsigned long long>(data.count()),
+                static_cast<unsigned long long>(data.percentile(0.5)),
+                static_cast<unsigned long long>(data.percentile(0.99)));
+    return 0;
+}
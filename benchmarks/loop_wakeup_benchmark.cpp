@@ -0,0 +1,89 @@
+// Idle CPU cost and cross-thread wake-up latency of the event loops.
+//
+// Usage: loop_wakeup_benchmark [idle_servers=100] [idle_seconds=2] [wakeups=10000]
+
+#include <slick/socket/tcp_server.h>
+#include "bench_util.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+class IdleServer : public slick::socket::TCPServerBase<IdleServer>
+{
+public:
+    using TCPServerBase::TCPServerBase;
+
+    void onClientConnected(int, const std::string&) {}
+    void onClientDisconnected(int) {}
+    void onClientData(int, const uint8_t*, size_t) {}
+};
+
+int main(int argc, char** argv)
+{
+    int server_count = argc > 1 ? std::atoi(argv[1]) : 100;
+    int idle_seconds = argc > 2 ? std::atoi(argv[2]) : 2;
+    int wakeups = argc > 3 ? std::atoi(argv[3]) : 10000;
+
+    slick::socket::TCPServerConfig config;
+    config.port = 0;
+
+    std::vector<std::unique_ptr<IdleServer>> servers;
+    for (int i = 0; i < server_count; ++i)
+    {
+        servers.push_back(std::make_unique<IdleServer>("IdleServer" + std::to_string(i), config));
+        if (!servers.back()->start())
+        {
+            std::fprintf(stderr, "failed to start server %d\n", i);
+            return 1;
+        }
+    }
+
+    // Idle CPU: process CPU time consumed while every loop waits for work
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    std::clock_t cpu_start = std::clock();
+    auto wall_start = Clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(idle_seconds));
+    double cpu_seconds = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    double wall_seconds = std::chrono::duration<double>(Clock::now() - wall_start).count();
+    std::printf("%d idle servers: %.3f CPU-seconds over %.2f s (%.2f%% of one core)\n",
+                server_count, cpu_seconds, wall_seconds, 100.0 * cpu_seconds / wall_seconds);
+
+    // Wake latency: time from post() on this thread until the task runs on the loop thread
+    std::vector<double> latencies;
+    latencies.reserve(wakeups);
+    std::atomic<int64_t> ran_at{0};
+    for (int i = 0; i < wakeups; ++i)
+    {
+        ran_at.store(0, std::memory_order_relaxed);
+        auto posted = Clock::now();
+        servers[0]->post([&ran_at]() {
+            ran_at.store(Clock::now().time_since_epoch().count(), std::memory_order_release);
+        });
+        int64_t t;
+        while ((t = ran_at.load(std::memory_order_acquire)) == 0)
+        {
+        }
+        auto elapsed = Clock::duration(t) - posted.time_since_epoch();
+        latencies.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+    }
+    bench::report("post() -> task start", latencies, "us");
+
+    // Stop latency for idle servers
+    std::vector<double> stop_times;
+    for (auto& server : servers)
+    {
+        auto start = Clock::now();
+        server->stop();
+        stop_times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    bench::report("stop() of an idle server", stop_times, "us");
+    return 0;
+}
@@ -0,0 +1,203 @@
+// Decoding framed binary messages: memcpy into structs vs in-place MessageView accessors.
+//
+// memcpy: what handlers did before, a switch on the type then a memcpy of every field into a
+//         host struct (with byte swaps) that is passed to the handler
+// view:   MessageFramer + MessageDispatcher (compile-time jump table) reading the same fields in place
+// Both decode the same buffer of big-endian messages (three types, mixed) and sum a few fields so
+// the work cannot be optimised away. Reported in ns per message.
+//
+// Usage: message_codec_benchmark [messages=1000000] [runs=20]
+
+#include <slick/socket/message.h>
+#include "bench_util.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using namespace slick::socket;
+
+using AddOrder = MessageSchema<1, ByteOrder::Big,
+    Field<"order_id", uint64_t>,
+    Field<"side", char>,
+    Field<"quantity", uint32_t>,
+    Field<"symbol", char[8]>,
+    Field<"price", int64_t>>;
+
+using ExecuteOrder = MessageSchema<2, ByteOrder::Big,
+    Field<"order_id", uint64_t>,
+    Field<"executed", uint32_t>,
+    Field<"match_id", uint64_t>>;
+
+using DeleteOrder = MessageSchema<3, ByteOrder::Big,
+    Field<"order_id", uint64_t>>;
+
+// Host structs filled field by field, as the memcpy decoders did
+struct AddOrderStruct
+{
+    uint64_t order_id;
+    char side;
+    uint32_t quantity;
+    char symbol[8];
+    int64_t price;
+};
+
+struct ExecuteOrderStruct
+{
+    uint64_t order_id;
+    uint32_t executed;
+    uint64_t match_id;
+};
+
+template<typename T>
+static T read_big(const uint8_t* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return message_detail::byteswap(value);
+}
+
+// The previous pattern: structs handed to the handler after a memcpy of every field
+struct StructHandler
+{
+    void onAddOrder(const AddOrderStruct& order)
+    {
+        sum += order.order_id + order.quantity + static_cast<uint64_t>(order.price) + order.symbol[0];
+    }
+    void onExecuteOrder(const ExecuteOrderStruct& execution)
+    {
+        sum += execution.order_id + execution.executed + execution.match_id;
+    }
+    void onDeleteOrder(uint64_t order_id)
+    {
+        sum += order_id;
+    }
+
+    uint64_t sum = 0;
+};
+
+static void decode_memcpy(const std::vector<uint8_t>& stream, StructHandler& handler)
+{
+    const uint8_t* data = stream.data();
+    const uint8_t* end = data + stream.size();
+    while (data + message_header_size <= end)
+    {
+        uint16_t length, type;
+        std::memcpy(&length, data, 2);
+        std::memcpy(&type, data + 2, 2);
+        const uint8_t* body = data + message_header_size;
+        switch (type)
+        {
+        case 1:
+        {
+            AddOrderStruct order;
+            order.order_id = read_big<uint64_t>(body);
+            order.side = static_cast<char>(body[8]);
+            order.quantity = read_big<uint32_t>(body + 9);
+            std::memcpy(order.symbol, body + 13, 8);
+            order.price = static_cast<int64_t>(read_big<uint64_t>(body + 21));
+            handler.onAddOrder(order);
+            break;
+        }
+        case 2:
+        {
+            ExecuteOrderStruct execution;
+            execution.order_id = read_big<uint64_t>(body);
+            execution.executed = read_big<uint32_t>(body + 8);
+            execution.match_id = read_big<uint64_t>(body + 12);
+            handler.onExecuteOrder(execution);
+            break;
+        }
+        case 3:
+            handler.onDeleteOrder(read_big<uint64_t>(body));
+            break;
+        default:
+            break;
+        }
+        data += message_header_size + length;
+    }
+}
+
+struct SummingHandler
+{
+    void onMessage(MessageView<AddOrder> order)
+    {
+        sum += order.get<"order_id">() + order.get<"quantity">() + static_cast<uint64_t>(order.get<"price">()) +
+               order.get<"symbol">()[0];
+    }
+    void onMessage(MessageView<ExecuteOrder> execution)
+    {
+        sum += execution.get<"order_id">() + execution.get<"executed">() + execution.get<"match_id">();
+    }
+    void onMessage(MessageView<DeleteOrder> deletion)
+    {
+        sum += deletion.get<"order_id">();
+    }
+
+    uint64_t sum = 0;
+};
+
+static void decode_view(const std::vector<uint8_t>& stream, SummingHandler& handler)
+{
+    MessageDispatcher<SummingHandler, AddOrder, ExecuteOrder, DeleteOrder> dispatcher(handler);
+    MessageFramer framer;
+    framer.feed(stream.data(), stream.size(), dispatcher);
+}
+
+int main(int argc, char** argv)
+{
+    size_t messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    std::vector<uint8_t> stream;
+    uint64_t state = 88172645463325252ull;
+    for (size_t i = 0; i < messages; ++i)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        switch (state % 4)
+        {
+        case 0:
+        case 1:
+            append_message<AddOrder>(stream)
+                .set<"order_id">(i)
+                .set<"side">('B')
+                .set<"quantity">(static_cast<uint32_t>(state & 0xFFFF))
+                .set<"symbol">("SYM")
+                .set<"price">(static_cast<int64_t>(state >> 20));
+            break;
+        case 2:
+            append_message<ExecuteOrder>(stream).set<"order_id">(i).set<"executed">(100u).set<"match_id">(state);
+            break;
+        default:
+            append_message<DeleteOrder>(stream).set<"order_id">(i);
+            break;
+        }
+    }
+
+    // Handlers live outside the decode loops, as session objects do
+    StructHandler struct_handler;
+    SummingHandler view_handler;
+    std::vector<double> copied, viewed;
+    for (int run = 0; run < runs; ++run)
+    {
+        auto start = Clock::now();
+        decode_memcpy(stream, struct_handler);
+        copied.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / messages);
+
+        start = Clock::now();
+        decode_view(stream, view_handler);
+        viewed.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / messages);
+    }
+
+    bool match = struct_handler.sum == view_handler.sum;
+    std::printf("%zu messages, %zu bytes, checksums %s\n", messages, stream.size(), match ? "match" : "DIFFER");
+    bench::report("memcpy decode", copied, "ns/msg");
+    bench::report("view + jump table", viewed, "ns/msg");
+    return match ? 0 : 1;
+}
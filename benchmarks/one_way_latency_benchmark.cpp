@@ -0,0 +1,211 @@
+// One-way latency on this host from send timestamps carried in the data, no external tools:
+//
+// tcp:       TCPClientBase sends framed messages stamped with stamp_message(); the server's
+//            MessageFramer records latency into a LatencyHistogram before dispatching
+// multicast: MulticastSender with sequenced + timestamp headers over loopback; the receiver
+//            records latency before its handler runs
+// Messages are spaced by interval_us so each one measures an idle path rather than queueing.
+// The sender spins between messages; with fewer cores than threads that spin delays the loop
+// threads and shows up in the tail.
+//
+// Usage: one_way_latency_benchmark [messages=10000] [interval_us=20]
+
+#include <slick/socket/tcp_server.h>
+#include <slick/socket/tcp_client.h>
+#include <slick/socket/multicast_sender.h>
+#include <slick/socket/multicast_receiver.h>
+#include <slick/socket/message.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using namespace slick::socket;
+
+using Tick = MessageSchema<1, ByteOrder::Little, Field<"sequence", uint64_t>>;
+
+static void print_histogram(const char* label, const LatencyHistogram& histogram)
+{
+    std::printf("%-28s n=%-8llu min=%8llu p50=%8llu p99=%8llu p99.9=%8llu max=%8llu ns\n", label,
+                static_cast<unsigned long long>(histogram.count()), static_cast<unsigned long long>(histogram.min()),
+                static_cast<unsigned long long>(histogram.percentile(0.50)),
+                static_cast<unsigned long long>(histogram.percentile(0.99)),
+                static_cast<unsigned long long>(histogram.percentile(0.999)),
+                static_cast<unsigned long long>(histogram.max()));
+}
+
+static void wait_until(Clock::time_point deadline)
+{
+    while (Clock::now() < deadline)
+    {
+    }
+}
+
+class TickServer : public TCPServerBase<TickServer>
+{
+public:
+    using TCPServerBase::TCPServerBase;
+
+    void onClientConnected(int, const std::string&)
+    {
+        framer_.reset();
+    }
+    void onClientDisconnected(int) {}
+    void onClientData(int, const uint8_t* data, size_t length)
+    {
+        framer_.feed(data, length, [this](uint16_t, const uint8_t*, size_t) {
+            received.store(received.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        });
+    }
+
+    LatencyHistogram latency;
+    std::atomic<uint64_t> received{0};
+
+private:
+    MessageFramer framer_ = make_framer();
+
+    MessageFramer make_framer()
+    {
+        MessageFramer framer(0xFFFF, MessageIntegrity::None, MessageTimestamp::Send);
+        framer.set_latency_histogram(&latency);
+        return framer;
+    }
+};
+
+class TickClient : public TCPClientBase<TickClient>
+{
+public:
+    using TCPClientBase::TCPClientBase;
+
+    void onConnected() {}
+    void onDisconnected() {}
+    void onData(const uint8_t*, size_t) {}
+};
+
+class TickReceiver : public MulticastReceiverBase<TickReceiver>
+{
+public:
+    using MulticastReceiverBase::MulticastReceiverBase;
+    using MulticastReceiverBase::get_latency_histogram;
+
+    void handle_multicast_data(const uint8_t*, size_t, const Endpoint&)
+    {
+        received.store(received.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    std::atomic<uint64_t> received{0};
+};
+
+static bool run_tcp(uint64_t messages, std::chrono::microseconds interval)
+{
+    TCPServerConfig server_config;
+    server_config.port = 0;
+    auto server = std::make_unique<TickServer>("TickServer", server_config);
+    if (!server->start())
+    {
+        std::fprintf(stderr, "failed to start server\n");
+        return false;
+    }
+
+    TCPClientConfig client_config;
+    client_config.server_address = "127.0.0.1";
+    client_config.server_port = server->get_port();
+    TickClient client("TickClient", client_config);
+    if (!client.connect())
+    {
+        std::fprintf(stderr, "connect failed\n");
+        return false;
+    }
+
+    std::vector<uint8_t> buffer;
+    auto next = Clock::now();
+    for (uint64_t i = 0; i < messages; ++i)
+    {
+        next += interval;
+        wait_until(next);
+        buffer.clear();
+        append_message<Tick>(buffer).set<"sequence">(i);
+        stamp_message(buffer);
+        client.send_data(buffer);
+    }
+
+    auto deadline = Clock::now() + std::chrono::seconds(5);
+    while (server->received.load(std::memory_order_acquire) < messages && Clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    print_histogram("tcp framed message", server->latency);
+    client.disconnect();
+    server->stop();
+    return true;
+}
+
+static void run_multicast(uint64_t messages, std::chrono::microseconds interval)
+{
+    MulticastReceiverConfig receiver_config;
+    receiver_config.multicast_address = "224.0.0.103";
+    receiver_config.port = 12348;
+    receiver_config.sequenced = true;
+    auto receiver = std::make_unique<TickReceiver>("TickReceiver", receiver_config);
+    if (!receiver->start())
+    {
+        std::fprintf(stderr, "failed to start multicast receiver\n");
+        return;
+    }
+
+    MulticastSenderConfig sender_config;
+    sender_config.multicast_address = receiver_config.multicast_address;
+    sender_config.port = receiver_config.port;
+    sender_config.enable_loopback = true;
+    sender_config.sequenced = true;
+    sender_config.timestamp = true;
+    MulticastSender sender("TickSender", sender_config);
+    if (!sender.start())
+    {
+        std::fprintf(stderr, "failed to start multicast sender\n");
+        return;
+    }
+
+    std::vector<uint8_t> payload(32, 'x');
+    auto next = Clock::now();
+    for (uint64_t i = 0; i < messages; ++i)
+    {
+        next += interval;
+        wait_until(next);
+        sender.send_data(payload);
+    }
+
+    auto deadline = Clock::now() + std::chrono::seconds(2);
+    while (receiver->received.load(std::memory_order_acquire) < messages && Clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (receiver->received.load() == 0)
+    {
+        std::printf("multicast: nothing received (no loopback route?)\n");
+    }
+    else
+    {
+        print_histogram("multicast datagram", receiver->get_latency_histogram());
+    }
+    sender.stop();
+    receiver->stop();
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    std::chrono::microseconds interval(argc > 2 ? std::atoi(argv[2]) : 20);
+
+    if (!run_tcp(messages, interval))
+    {
+        return 1;
+    }
+    run_multicast(messages, interval);
+    return 0;
+}
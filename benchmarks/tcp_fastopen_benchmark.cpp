@@ -0,0 +1,104 @@
+// Time from connect() to the first response byte, with and without TCP Fast Open.
+//
+// Fast Open only saves a round trip when the client kernel allows it:
+// net.ipv4.tcp_fastopen must include bit 0x1 (client) and 0x2 (server), i.e. 3.
+//
+// Usage: tcp_fastopen_benchmark [iterations=1000]
+
+#include <slick/socket/tcp_server.h>
+#include <slick/socket/tcp_client.h>
+#include "bench_util.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+class EchoServer : public slick::socket::TCPServerBase<EchoServer>
+{
+public:
+    using TCPServerBase::TCPServerBase;
+
+    void onClientConnected(int, const std::string&) {}
+    void onClientDisconnected(int) {}
+    void onClientData(int client_id, const uint8_t* data, size_t length)
+    {
+        send_data(client_id, std::vector<uint8_t>(data, data + length));
+    }
+};
+
+class ProbeClient : public slick::socket::TCPClientBase<ProbeClient>
+{
+public:
+    using TCPClientBase::TCPClientBase;
+
+    void onConnected() {}
+    void onDisconnected() {}
+    void onData(const uint8_t*, size_t)
+    {
+        responded.store(true, std::memory_order_release);
+    }
+
+    std::atomic_bool responded{false};
+};
+
+static void run(const char* label, uint16_t port, bool fast_open, int iterations)
+{
+    slick::socket::TCPClientConfig config;
+    config.server_address = "127.0.0.1";
+    config.server_port = port;
+    config.fast_open = fast_open;
+
+    const std::vector<uint8_t> request(64, 'x');
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    for (int i = 0; i < iterations; ++i)
+    {
+        ProbeClient client("ProbeClient", config);
+        auto start = Clock::now();
+        if (!client.connect(request))
+        {
+            std::fprintf(stderr, "%s: connect failed\n", label);
+            return;
+        }
+        while (!client.responded.load(std::memory_order_acquire))
+        {
+        }
+        samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        client.disconnect();
+    }
+    bench::report(label, samples, "us");
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 1000;
+
+    std::ifstream sysctl("/proc/sys/net/ipv4/tcp_fastopen");
+    int mode = 0;
+    if (sysctl >> mode && (mode & 3) != 3)
+    {
+        std::printf("warning: net.ipv4.tcp_fastopen=%d, set it to 3 to exercise Fast Open on loopback\n", mode);
+    }
+
+    slick::socket::TCPServerConfig server_config;
+    server_config.port = 0;
+    server_config.tcp_fastopen_queue = 256;
+    EchoServer server("EchoServer", server_config);
+    if (!server.start())
+    {
+        std::fprintf(stderr, "failed to start server\n");
+        return 1;
+    }
+
+    run("connect + request -> response", server.get_port(), false, iterations);
+    run("fast open connect -> response", server.get_port(), true, iterations);
+
+    server.stop();
+    return 0;
+}
@@ -0,0 +1,72 @@
+// Cost of recording one span with TraitsT::enable_tracing: a TraceSpan around no work (two counter
+// reads and the ring write) against the compiled-out NoTraceSpan, and the time to dump a full ring
+// as Chrome trace JSON. Each sample is the mean over a batch of back-to-back spans.
+//
+// Usage: trace_benchmark [spans=1000000] [runs=20]
+
+#include <slick/socket/trace.h>
+#include "bench_util.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using namespace slick::socket;
+
+template<typename BodyT>
+static void measure(const char* label, size_t spans, int runs, BodyT&& body)
+{
+    std::vector<double> samples;
+    for (int run = 0; run < runs; ++run)
+    {
+        auto start = Clock::now();
+        for (size_t i = 0; i < spans; ++i)
+        {
+            body(i);
+        }
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / spans);
+    }
+    bench::report(label, samples, "ns/span");
+}
+
+int main(int argc, char** argv)
+{
+    size_t spans = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));    // past TscClock's calibration baseline
+    Tracer::attach_thread("benchmark");
+    std::atomic<uint64_t> sink{0};
+
+    measure("TraceSpan", spans, runs, [&](size_t i) {
+        TraceSpan span(TraceKind::Send, static_cast<int>(i & 63));
+        sink.store(i, std::memory_order_relaxed);
+        span.end(i & 0xFFFF);
+    });
+    measure("TraceSpan callback (destructor)", spans, runs, [&](size_t i) {
+        TraceSpan span(TraceKind::Callback, static_cast<int>(i & 63), LoopCallback::Data);
+        sink.store(i, std::memory_order_relaxed);
+    });
+    measure("NoTraceSpan (disabled)", spans, runs, [&](size_t i) {
+        NoTraceSpan span(TraceKind::Send, static_cast<int>(i & 63));
+        sink.store(i, std::memory_order_relaxed);
+        span.end(i & 0xFFFF);
+    });
+
+    std::vector<double> dump;
+    size_t bytes = 0;
+    for (int run = 0; run < 5; ++run)
+    {
+        auto start = Clock::now();
+        bytes = Tracer::chrome_trace_json().size();
+        dump.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    bench::report("chrome_trace_json() of a full ring", dump, "ms");
+    std::printf("JSON size: %zu bytes\n", bytes);
+    return 0;
+}
@@ -0,0 +1,235 @@
+// WebSocket layer cost against the raw TCP path, over loopback.
+//
+// unmask: scalar kernel vs the dispatched SIMD kernel (AVX2/SSE2/NEON), GB/s
+// upstream: client -> server messages (masked by the client, unmasked by the server), MB/s
+// downstream: server -> client messages (header + payload via writev, no masking), MB/s
+//
+// Usage: websocket_benchmark [message_size=1024] [messages=200000]
+
+#include <slick/socket/tcp_server.h>
+#include <slick/socket/tcp_client.h>
+#include <slick/socket/websocket_server.h>
+#include <slick/socket/websocket_client.h>
+#include "bench_util.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static std::atomic<uint64_t> server_received{0};
+static std::atomic<uint64_t> client_received{0};
+
+class RawServer : public slick::socket::TCPServerBase<RawServer>
+{
+public:
+    using TCPServerBase::TCPServerBase;
+
+    void onClientConnected(int client_id, const std::string&) { client_id_ = client_id; }
+    void onClientDisconnected(int) {}
+    void onClientData(int, const uint8_t*, size_t length)
+    {
+        server_received.fetch_add(length, std::memory_order_relaxed);
+    }
+
+    void push(const std::vector<uint8_t>& message, size_t count)
+    {
+        post([this, &message, count]() {
+            for (size_t i = 0; i < count; ++i)
+            {
+                send_data(client_id_, message);
+            }
+        });
+    }
+
+private:
+    int client_id_ = -1;
+};
+
+class RawClient : public slick::socket::TCPClientBase<RawClient>
+{
+public:
+    using TCPClientBase::TCPClientBase;
+
+    void onConnected() {}
+    void onDisconnected() {}
+    void onData(const uint8_t*, size_t length)
+    {
+        client_received.fetch_add(length, std::memory_order_relaxed);
+    }
+
+    bool send_message(const std::vector<uint8_t>& message) { return send_data(message); }
+};
+
+class WsServer : public slick::socket::WebSocketServerBase<WsServer>
+{
+public:
+    using WebSocketServerBase::WebSocketServerBase;
+
+    void onWebSocketOpen(int client_id, const std::string&) { client_id_ = client_id; }
+    void onMessage(int, const uint8_t*, size_t length, bool)
+    {
+        server_received.fetch_add(length, std::memory_order_relaxed);
+    }
+
+    void push(const std::vector<uint8_t>& message, size_t count)
+    {
+        post([this, &message, count]() {
+            for (size_t i = 0; i < count; ++i)
+            {
+                send_binary(client_id_, message.data(), message.size());
+            }
+        });
+    }
+
+private:
+    int client_id_ = -1;
+};
+
+class WsClient : public slick::socket::WebSocketClientBase<WsClient>
+{
+public:
+    using WebSocketClientBase::WebSocketClientBase;
+
+    void onMessage(const uint8_t*, size_t length, bool)
+    {
+        client_received.fetch_add(length, std::memory_order_relaxed);
+    }
+
+    bool send_message(const std::vector<uint8_t>& message) { return send_binary(message.data(), message.size()); }
+};
+
+static bool wait_for(std::atomic<uint64_t>& counter, uint64_t target)
+{
+    auto deadline = Clock::now() + std::chrono::seconds(30);
+    while (counter.load(std::memory_order_relaxed) < target)
+    {
+        if (Clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+static double mb_per_second(uint64_t bytes, Clock::time_point start)
+{
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return bytes / seconds / 1e6;
+}
+
+template<typename ServerT, typename ClientT>
+static void run_stream(const char* name, size_t message_size, size_t messages, int runs)
+{
+    slick::socket::TCPServerConfig server_config;
+    server_config.port = 0;
+    server_config.bind_address = "127.0.0.1";
+    server_config.receive_buffer_size = 64 * 1024;
+    ServerT server(name, server_config);
+    if (!server.start())
+    {
+        std::fprintf(stderr, "server start failed\n");
+        return;
+    }
+
+    slick::socket::TCPClientConfig client_config;
+    client_config.server_address = "127.0.0.1";
+    client_config.server_port = server.get_port();
+    client_config.receive_buffer_size = 64 * 1024;
+    ClientT client(name, client_config);
+    if (!client.connect())
+    {
+        std::fprintf(stderr, "connect failed\n");
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const std::vector<uint8_t> message(message_size, 0x42);
+    const uint64_t total = static_cast<uint64_t>(message_size) * messages;
+    std::vector<double> upstream, downstream;
+    for (int run = 0; run < runs; ++run)
+    {
+        server_received.store(0);
+        auto start = Clock::now();
+        for (size_t i = 0; i < messages; ++i)
+        {
+            while (!client.send_message(message))
+            {
+                std::this_thread::yield();
+            }
+        }
+        if (!wait_for(server_received, total))
+        {
+            std::fprintf(stderr, "upstream stalled\n");
+            break;
+        }
+        upstream.push_back(mb_per_second(total, start));
+
+        client_received.store(0);
+        start = Clock::now();
+        server.push(message, messages);
+        if (!wait_for(client_received, total))
+        {
+            std::fprintf(stderr, "downstream stalled\n");
+            break;
+        }
+        downstream.push_back(mb_per_second(total, start));
+    }
+
+    std::string label = std::string(name) + " upstream";
+    bench::report(label.c_str(), upstream, "MB/s");
+    label = std::string(name) + " downstream";
+    bench::report(label.c_str(), downstream, "MB/s");
+
+    client.disconnect();
+    server.stop();
+}
+
+static void run_unmask(size_t size, int runs)
+{
+    const uint8_t key[4] = {0x12, 0x34, 0x56, 0x78};
+    std::vector<uint8_t> source(size, 0x5A), target(size);
+    const int reps = static_cast<int>((256u << 20) / size) + 1;
+
+    std::vector<double> scalar, simd;
+    for (int run = 0; run < runs; ++run)
+    {
+        auto start = Clock::now();
+        for (int i = 0; i < reps; ++i)
+        {
+            slick::socket::websocket_detail::unmask_scalar(target.data(), source.data(), size, key, i & 3);
+        }
+        scalar.push_back(double(size) * reps / std::chrono::duration<double>(Clock::now() - start).count() / 1e9);
+
+        start = Clock::now();
+        for (int i = 0; i < reps; ++i)
+        {
+            slick::socket::websocket_unmask(target.data(), source.data(), size, key, i & 3);
+        }
+        simd.push_back(double(size) * reps / std::chrono::duration<double>(Clock::now() - start).count() / 1e9);
+    }
+    std::printf("(checksum %u)\n", target[size / 2]);
+    std::string label = "unmask scalar " + std::to_string(size) + "B";
+    bench::report(label.c_str(), scalar, "GB/s");
+    label = "unmask simd " + std::to_string(size) + "B";
+    bench::report(label.c_str(), simd, "GB/s");
+}
+
+int main(int argc, char** argv)
+{
+    size_t message_size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1024;
+    size_t messages = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+
+    run_unmask(message_size, 10);
+    run_unmask(64 * 1024, 10);
+
+    run_stream<RawServer, RawClient>("raw tcp", message_size, messages, 5);
+    run_stream<WsServer, WsClient>("websocket", message_size, messages, 5);
+    return 0;
+}
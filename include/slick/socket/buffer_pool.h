@@ -0,0 +1,544 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <slick/socket/cache_line.h>
+#include <slick/socket/numa.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <winsock2.h>   // must precede windows.h
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace slick::socket
+{
+
+struct BufferPoolConfig
+{
+    size_t arena_size = 8 * 1024 * 1024;    // Bytes reserved for slabs, rounded up to the huge page size
+    bool huge_pages = true;                 // Try 2 MB pages first, fall back to normal pages
+    bool prefault = true;                   // Touch every page when the arena is mapped
+    size_t thread_cache_limit = 32;         // Free buffers kept per slab class and thread before spilling
+};
+
+class BufferPool;
+
+// Move-only handle to a buffer taken from BufferPool; returned to the pool on destruction.
+// size() is the requested size, capacity() the slab class size.
+class PooledBuffer
+{
+public:
+    PooledBuffer() = default;
+    ~PooledBuffer() { reset(); }
+
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+    PooledBuffer(PooledBuffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , size_class_(other.size_class_)
+    {
+    }
+
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            size_class_ = other.size_class_;
+        }
+        return *this;
+    }
+
+    uint8_t* data() noexcept { return data_; }
+    const uint8_t* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept;
+    bool empty() const noexcept { return data_ == nullptr; }
+
+    void reset() noexcept;
+
+private:
+    friend class BufferPool;
+
+    PooledBuffer(uint8_t* data, size_t size, uint8_t size_class) noexcept
+        : data_(data), size_(size), size_class_(size_class)
+    {
+    }
+
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    uint8_t size_class_ = 0;
+};
+
+// Process-wide slab allocator for receive and send buffers.
+// Slabs are carved from arenas backed by 2 MB huge pages where available, so the loops'
+// buffers share a handful of TLB entries. Each slab class is a power of two from 1 KB to 1 MB.
+// acquire() and release() touch only the calling thread's free lists; the shared spill list is
+// locked only when a thread cache runs empty or overflows. Requests larger than the largest class,
+// or made after the arena is exhausted, fall back to the heap.
+// A thread bound to a NUMA node with set_thread_node() draws from an arena placed on that node.
+class BufferPool
+{
+public:
+    static constexpr size_t min_class_size = 1024;
+    static constexpr size_t class_count = 11;
+    static constexpr size_t max_class_size = min_class_size << (class_count - 1);
+    static constexpr size_t huge_page_size = 2 * 1024 * 1024;
+    static constexpr uint8_t heap_class = 0xFF;
+    static constexpr int max_arena_nodes = 8;   // nodes 0-7 get their own arena, others share the default
+
+    static BufferPool& instance()
+    {
+        static BufferPool pool;
+        return pool;
+    }
+
+    // Map and pre-fault the default arena with the given settings. Call once at start-up, before any
+    // buffer is acquired; returns false if an arena is already mapped. Node arenas use the same
+    // settings and are mapped when the first thread bound to the node acquires a buffer.
+    bool configure(const BufferPoolConfig& config)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const Arena& arena : arenas_)
+        {
+            if (arena.base)
+            {
+                return false;
+            }
+        }
+        config_ = config;
+        thread_cache_limit_.store(config.thread_cache_limit, std::memory_order_relaxed);
+        return map_arena(arenas_[0]);
+    }
+
+    // Serve the calling thread's later acquire() calls from the arena of node (-1 = default arena).
+    // Buffers already cached by the thread are handed back to their arena.
+    void set_thread_node(int node)
+    {
+        ThreadCache& cache = thread_cache();
+        if (cache.arena)
+        {
+            for (size_t i = 0; i < class_count; ++i)
+            {
+                spill(*cache.arena, cache.lists[i], i, cache.lists[i].count);
+            }
+            cache.arena = nullptr;
+        }
+        cache.node = node;
+    }
+
+    PooledBuffer acquire(size_t size)
+    {
+        size_t size_class = class_for(size);
+        if (size_class >= class_count)
+        {
+            return heap_buffer(size);
+        }
+
+        ThreadCache& cache = thread_cache();
+        if (!cache.arena && !attach(cache))
+        {
+            return heap_buffer(size);
+        }
+
+        FreeList& list = cache.lists[size_class];
+        if (!list.head && !refill(*cache.arena, list, size_class))
+        {
+            return heap_buffer(size);
+        }
+
+        FreeBlock* block = list.head;
+        list.head = block->next;
+        --list.count;
+        return PooledBuffer(reinterpret_cast<uint8_t*>(block), size, static_cast<uint8_t>(size_class));
+    }
+
+    // Arena statistics; node -1 is the default arena
+    bool uses_huge_pages(int node = -1) const noexcept { return arena_for(node).huge; }
+    size_t arena_size(int node = -1) const noexcept { return arena_for(node).size; }
+    size_t arena_used(int node = -1) const noexcept
+    {
+        return arena_for(node).used.load(std::memory_order_relaxed);
+    }
+    uint64_t heap_fallbacks() const noexcept { return heap_fallbacks_.load(std::memory_order_relaxed); }
+
+    static constexpr size_t class_size(size_t size_class) noexcept { return min_class_size << size_class; }
+
+    // Lock every mapped arena into RAM. Returns the number of bytes locked.
+    size_t lock_memory()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t locked = 0;
+        for (Arena& arena : arenas_)
+        {
+            if (!arena.base)
+            {
+                continue;
+            }
+#if defined(_WIN32) || defined(_WIN64)
+            if (VirtualLock(arena.base, arena.size))
+#else
+            if (mlock(arena.base, arena.size) == 0)
+#endif
+            {
+                locked += arena.size;
+            }
+        }
+        return locked;
+    }
+
+    ~BufferPool()
+    {
+        for (Arena& arena : arenas_)
+        {
+            unmap_arena(arena);
+        }
+    }
+
+private:
+    friend class PooledBuffer;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct FreeList
+    {
+        FreeBlock* head = nullptr;
+        size_t count = 0;
+    };
+
+    struct Arena
+    {
+        uint8_t* base = nullptr;
+        size_t size = 0;
+        int node = -1;
+        bool huge = false;
+        bool mapped = false;                // mapping attempted, base is null if it failed
+        std::atomic<size_t> used{0};        // bump offset, never past size
+        FreeList shared[class_count];       // spilled blocks, guarded by mutex_; linked through the blocks
+
+        bool contains(const void* p) const noexcept
+        {
+            return base && p >= base && p < base + size;
+        }
+    };
+
+    struct ThreadCache
+    {
+        FreeList lists[class_count];
+        Arena* arena = nullptr;
+        int node = -1;
+
+        ~ThreadCache()
+        {
+            if (arena)
+            {
+                BufferPool& pool = BufferPool::instance();
+                for (size_t i = 0; i < class_count; ++i)
+                {
+                    pool.spill(*arena, lists[i], i, lists[i].count);
+                }
+            }
+        }
+    };
+
+    BufferPool()
+    {
+        for (int i = 1; i <= max_arena_nodes; ++i)
+        {
+            arenas_[i].node = i - 1;
+        }
+    }
+
+    static ThreadCache& thread_cache()
+    {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    static size_t class_for(size_t size) noexcept
+    {
+        size_t size_class = 0;
+        while (size_class < class_count && class_size(size_class) < size)
+        {
+            ++size_class;
+        }
+        return size_class;
+    }
+
+    Arena& arena_for(int node) noexcept
+    {
+        return arenas_[node >= 0 && node < max_arena_nodes ? node + 1 : 0];
+    }
+
+    const Arena& arena_for(int node) const noexcept
+    {
+        return arenas_[node >= 0 && node < max_arena_nodes ? node + 1 : 0];
+    }
+
+    // Connect a thread cache to the arena of its node, mapping the arena on first use
+    bool attach(ThreadCache& cache)
+    {
+        Arena& arena = arena_for(cache.node);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!arena.mapped)
+        {
+            map_arena(arena);
+        }
+        if (!arena.base)
+        {
+            return false;
+        }
+        cache.arena = &arena;
+        return true;
+    }
+
+    PooledBuffer heap_buffer(size_t size)
+    {
+        heap_fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        return PooledBuffer(new uint8_t[size ? size : 1], size, heap_class);
+    }
+
+    void release(uint8_t* data, uint8_t size_class) noexcept
+    {
+        if (size_class == heap_class)
+        {
+            delete[] data;
+            return;
+        }
+
+        ThreadCache& cache = thread_cache();
+        auto* block = reinterpret_cast<FreeBlock*>(data);
+        if (!cache.arena || !cache.arena->contains(data))
+        {
+            // Released away from its arena: hand it straight back to the owner. map_arena() may be
+            // publishing another arena's base concurrently, so the scan holds the lock too.
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (Arena& arena : arenas_)
+            {
+                if (arena.contains(data))
+                {
+                    FreeList& shared = arena.shared[size_class];
+                    block->next = shared.head;
+                    shared.head = block;
+                    ++shared.count;
+                    return;
+                }
+            }
+            return;
+        }
+
+        FreeList& list = cache.lists[size_class];
+        block->next = list.head;
+        list.head = block;
+        if (++list.count > thread_cache_limit_.load(std::memory_order_relaxed))
+        {
+            spill(*cache.arena, list, size_class, list.count / 2);
+        }
+    }
+
+    // Move count blocks from a thread cache to the arena's shared list
+    void spill(Arena& arena, FreeList& list, size_t size_class, size_t count) noexcept
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        FreeList& shared = arena.shared[size_class];
+        while (count-- && list.head)
+        {
+            FreeBlock* block = list.head;
+            list.head = block->next;
+            --list.count;
+            block->next = shared.head;
+            shared.head = block;
+            ++shared.count;
+        }
+    }
+
+    // Take a batch from the shared list, or carve fresh slabs from the arena
+    bool refill(Arena& arena, FreeList& list, size_t size_class)
+    {
+        size_t batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batch = config_.thread_cache_limit / 2 ? config_.thread_cache_limit / 2 : 1;
+            FreeList& shared = arena.shared[size_class];
+            while (batch && shared.head)
+            {
+                FreeBlock* block = shared.head;
+                shared.head = block->next;
+                --shared.count;
+                block->next = list.head;
+                list.head = block;
+                ++list.count;
+                --batch;
+            }
+        }
+        if (list.head)
+        {
+            return true;
+        }
+
+        // Carve no more than 64 KB at once so large classes do not drain the arena. Slabs start on
+        // a boundary of their class size up to a page, and never share a cache line with a neighbour.
+        size_t bytes = class_size(size_class);
+        size_t wanted = (std::max<size_t>)(1, (std::min)(batch, (64 * 1024) / bytes));
+        size_t align = (std::max)(cache_line_size, (std::min<size_t>)(bytes, 4096));
+        size_t used = arena.used.load(std::memory_order_relaxed);
+        size_t offset;
+        size_t carve;
+        do
+        {
+            offset = (used + align - 1) / align * align;
+            if (offset > arena.size || arena.size - offset < bytes)
+            {
+                return false;
+            }
+            carve = (std::min)(wanted, (arena.size - offset) / bytes);
+        } while (!arena.used.compare_exchange_weak(used, offset + carve * bytes, std::memory_order_relaxed));
+
+        for (size_t i = 0; i < carve; ++i)
+        {
+            auto* block = reinterpret_cast<FreeBlock*>(arena.base + offset + i * bytes);
+            block->next = list.head;
+            list.head = block;
+            ++list.count;
+        }
+        return true;
+    }
+
+    bool map_arena(Arena& arena)
+    {
+        size_t size = (config_.arena_size + huge_page_size - 1) / huge_page_size * huge_page_size;
+        uint8_t* base = nullptr;
+        bool huge = false;
+
+#if defined(_WIN32) || defined(_WIN64)
+        // Large pages need SeLockMemoryPrivilege; without it VirtualAlloc fails and we fall back
+        DWORD node = arena.node >= 0 ? static_cast<DWORD>(arena.node) : NUMA_NO_PREFERRED_NODE;
+        SIZE_T large_page = GetLargePageMinimum();
+        if (config_.huge_pages && large_page)
+        {
+            size_t large_size = (size + large_page - 1) / large_page * large_page;
+            base = static_cast<uint8_t*>(VirtualAllocExNuma(GetCurrentProcess(), nullptr, large_size,
+                MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, node));
+            if (base)
+            {
+                size = large_size;
+                huge = true;
+            }
+        }
+        if (!base)
+        {
+            base = static_cast<uint8_t*>(VirtualAllocExNuma(GetCurrentProcess(), nullptr, size,
+                MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, node));
+        }
+#else
+#ifdef MAP_HUGETLB
+        if (config_.huge_pages)
+        {
+            // Explicit huge pages need vm.nr_hugepages reserved; fall back when none are available
+            void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED)
+            {
+                base = static_cast<uint8_t*>(p);
+                huge = true;
+            }
+        }
+#endif
+        if (!base)
+        {
+            void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p != MAP_FAILED)
+            {
+                base = static_cast<uint8_t*>(p);
+#ifdef MADV_HUGEPAGE
+                // Transparent huge pages, honoured before the pages are faulted in below
+                if (config_.huge_pages)
+                {
+                    madvise(p, size, MADV_HUGEPAGE);
+                }
+#endif
+            }
+        }
+
+        // Place the pages before they are first touched
+        if (base && arena.node >= 0)
+        {
+            bind_memory_to_numa_node(base, size, arena.node);
+        }
+#endif
+
+        if (base && config_.prefault)
+        {
+            // First touch commits the pages now instead of on the hot path
+            for (size_t offset = 0; offset < size; offset += 4096)
+            {
+                reinterpret_cast<volatile uint8_t*>(base)[offset] = 0;
+            }
+        }
+
+        arena.base = base;
+        arena.size = base ? size : 0;
+        arena.huge = huge;
+        arena.mapped = true;
+        return base != nullptr;
+    }
+
+    void unmap_arena(Arena& arena) noexcept
+    {
+        if (!arena.base)
+        {
+            return;
+        }
+#if defined(_WIN32) || defined(_WIN64)
+        VirtualFree(arena.base, 0, MEM_RELEASE);
+#else
+        munmap(arena.base, arena.size);
+#endif
+        arena.base = nullptr;
+    }
+
+    BufferPoolConfig config_;
+    std::mutex mutex_;
+    Arena arenas_[max_arena_nodes + 1];     // [0] default, [n + 1] node n
+    std::atomic<uint64_t> heap_fallbacks_{0};
+    std::atomic<size_t> thread_cache_limit_{BufferPoolConfig{}.thread_cache_limit};   // config_ copy for release()
+};
+
+inline size_t PooledBuffer::capacity() const noexcept
+{
+    return size_class_ == BufferPool::heap_class ? size_ : BufferPool::class_size(size_class_);
+}
+
+inline void PooledBuffer::reset() noexcept
+{
+    if (data_)
+    {
+        BufferPool::instance().release(data_, size_class_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+} // namespace slick::socket
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <cstddef>
+
+namespace slick::socket
+{
+
+// Alignment that keeps members written by different threads off each other's cache lines.
+// Spelled out instead of std::hardware_destructive_interference_size, whose value may change
+// between compiler versions and flags (GCC warns when it is used in a class layout).
+// Apple silicon has 128-byte lines; everything else supported here uses 64.
+#if defined(__APPLE__) && defined(__aarch64__)
+constexpr size_t cache_line_size = 128;
+#else
+constexpr size_t cache_line_size = 64;
+#endif
+
+} // namespace slick::socket
@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#define SLICK_SOCKET_CLOCK_TSC 1
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define SLICK_SOCKET_CLOCK_CNTVCT 1
+#endif
+
+namespace slick::socket
+{
+
+// steady_clock and system_clock cost ~20 ns per call through the vDSO (far more on hosts whose
+// clocksource is not the TSC); the counter read here costs a few.
+//
+// TscClock reads the invariant TSC on x86-64 (CPUID 0x80000007 EDX bit 8) or the generic timer
+// (CNTVCT_EL0) on ARM64 and converts to steady_clock's time base. Nothing spins to calibrate:
+// each thread keeps an anchor (counter, steady_clock, system_clock) refreshed every 10 ms, and the
+// tick rate is measured against the process-wide first reading, so it tracks NTP slewing and its
+// error shrinks as the process runs. Until 2 ms have passed, and on CPUs without an invariant
+// counter, every call reads steady_clock instead.
+class TscClock
+{
+public:
+    using rep = std::chrono::nanoseconds::rep;
+    using period = std::chrono::nanoseconds::period;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::steady_clock::time_point;   // interchangeable with steady_clock
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept
+    {
+        return time_point(std::chrono::duration_cast<time_point::duration>(duration(now_ns())));
+    }
+
+    // steady_clock time in nanoseconds
+    static int64_t now_ns() noexcept
+    {
+        if (!invariant())
+        {
+            return steady_ns();
+        }
+        uint64_t t = ticks();
+        Anchor& a = anchor();
+        uint64_t elapsed = t - a.ticks;
+        if (elapsed >= a.resync_ticks)
+        {
+            return resync(a, t);
+        }
+        int64_t value = a.steady + static_cast<int64_t>(static_cast<double>(elapsed) * a.ns_per_tick);
+        return value < a.floor ? a.floor : value;
+    }
+
+    // system_clock time (nanoseconds since the Unix epoch), for timestamps compared across
+    // processes and hosts. Follows clock steps within one resync interval.
+    static int64_t realtime_ns() noexcept
+    {
+        if (!invariant())
+        {
+            return system_ns();
+        }
+        int64_t steady = now_ns();
+        return steady + anchor().realtime_offset;
+    }
+
+    // Raw counter; steady_clock nanoseconds when there is no invariant counter. Differences
+    // convert with to_ns(). Not ordered: may execute before earlier instructions finish.
+    static uint64_t ticks() noexcept
+    {
+#if defined(SLICK_SOCKET_CLOCK_TSC)
+        return __rdtsc();
+#elif defined(SLICK_SOCKET_CLOCK_CNTVCT)
+        uint64_t value;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return static_cast<uint64_t>(steady_ns());
+#endif
+    }
+
+    // As ticks(), read after all earlier instructions have executed (rdtscp); use to close a
+    // measured region
+    static uint64_t ticks_ordered() noexcept
+    {
+#if defined(SLICK_SOCKET_CLOCK_TSC)
+        unsigned int aux;
+        return __rdtscp(&aux);
+#elif defined(SLICK_SOCKET_CLOCK_CNTVCT)
+        uint64_t value;
+        asm volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(value) : : "memory");
+        return value;
+#else
+        return ticks();
+#endif
+    }
+
+    // Nanoseconds in a difference of ticks()
+    static uint64_t to_ns(uint64_t tick_delta) noexcept
+    {
+        if (!invariant())
+        {
+            return tick_delta;
+        }
+        Anchor& a = anchor();
+        if (a.resync_ticks == 0)
+        {
+            resync(a, ticks());
+        }
+        double rate = a.resync_ticks != 0 ? a.ns_per_tick : current_rate();
+        return static_cast<uint64_t>(static_cast<double>(tick_delta) * rate);
+    }
+
+    // True when reads come from the invariant counter rather than steady_clock
+    static bool invariant() noexcept
+    {
+        static const bool supported = detect_invariant();
+        return supported;
+    }
+
+private:
+    static constexpr int64_t resync_interval_ns = 10'000'000;
+    static constexpr int64_t min_baseline_ns = 2'000'000;
+
+    struct Anchor
+    {
+        uint64_t ticks = 0;
+        int64_t steady = 0;
+        int64_t realtime_offset = 0;    // system_clock - steady_clock at the last resync
+        double ns_per_tick = 0.0;
+        uint64_t resync_ticks = 0;      // 0 until the baseline is long enough: read steady_clock
+        int64_t floor = 0;              // last reading before the resync, so readings never step back
+    };
+
+    struct Baseline
+    {
+        uint64_t ticks;
+        int64_t steady;
+    };
+
+    static int64_t steady_ns() noexcept
+    {
+        return std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static int64_t system_ns() noexcept
+    {
+        return std::chrono::duration_cast<duration>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static Anchor& anchor() noexcept
+    {
+        thread_local Anchor a;
+        return a;
+    }
+
+    static const Baseline& baseline() noexcept
+    {
+        static const Baseline first = []() {
+            steady_ns();    // the first call can take microseconds (symbol binding, vDSO page)
+            uint64_t before = ticks();
+            int64_t steady = steady_ns();
+            uint64_t after = ticks();
+            return Baseline{before + (after - before) / 2, steady};
+        }();
+        return first;
+    }
+
+    // Tick rate over the baseline so far, however short (to_ns() in the first milliseconds)
+    static double current_rate() noexcept
+    {
+        const Baseline& base = baseline();
+        int64_t steady = steady_ns();
+        uint64_t t = ticks();
+        if (steady <= base.steady || t <= base.ticks)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(steady - base.steady) / static_cast<double>(t - base.ticks);
+    }
+
+    // Re-anchors the thread on steady_clock. The old anchor's extrapolation becomes a floor for
+    // the readings that follow, without carrying its error into the new anchor.
+    static int64_t resync(Anchor& a, uint64_t before) noexcept
+    {
+        const Baseline& base = baseline();
+        int64_t steady = steady_ns();
+        int64_t system = system_ns();
+        uint64_t after = ticks();
+        uint64_t mid = before + (after - before) / 2;
+
+        a.floor = 0;
+        if (a.resync_ticks != 0)
+        {
+            a.floor = a.steady + static_cast<int64_t>(static_cast<double>(mid - a.ticks) * a.ns_per_tick);
+        }
+        a.ticks = mid;
+        a.steady = steady;
+        a.realtime_offset = system - steady;
+        if (steady - base.steady >= min_baseline_ns && mid > base.ticks)
+        {
+            a.ns_per_tick = static_cast<double>(steady - base.steady) / static_cast<double>(mid - base.ticks);
+            a.resync_ticks = static_cast<uint64_t>(static_cast<double>(resync_interval_ns) / a.ns_per_tick);
+        }
+        return steady < a.floor ? a.floor : steady;
+    }
+
+    static bool detect_invariant() noexcept
+    {
+#if defined(SLICK_SOCKET_CLOCK_TSC)
+#if defined(_MSC_VER)
+        int regs[4];
+        __cpuid(regs, 0x80000000);
+        if (static_cast<unsigned>(regs[0]) < 0x80000007u)
+        {
+            return false;
+        }
+        __cpuid(regs, 0x80000007);
+        bool invariant = (regs[3] & (1 << 8)) != 0;
+#else
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+        {
+            return false;
+        }
+        bool invariant = (edx & (1u << 8)) != 0;
+#endif
+        if (invariant)
+        {
+            baseline();     // start measuring the rate now
+        }
+        return invariant;
+#elif defined(SLICK_SOCKET_CLOCK_CNTVCT)
+        baseline();
+        return true;        // the generic timer runs at a constant rate by definition
+#else
+        return false;
+#endif
+    }
+};
+
+} // namespace slick::socket
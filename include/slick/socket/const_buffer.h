@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace slick::socket
+{
+
+// One piece of a gathered send. The pieces of a send_data(std::span<const ConstBuffer>) call are
+// written with writev/WSASend, so a header and a payload go out without being concatenated first.
+struct ConstBuffer
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+// Position within a sequence of ConstBuffers, advanced as bytes are accepted by the socket
+struct GatherCursor
+{
+    size_t index = 0;
+    size_t offset = 0;
+
+    template<typename BuffersT>
+    void advance(const BuffersT& buffers, size_t bytes) noexcept
+    {
+        while (bytes > 0 && index < buffers.size())
+        {
+            size_t left = buffers[index].size - offset;
+            if (bytes < left)
+            {
+                offset += bytes;
+                return;
+            }
+            bytes -= left;
+            ++index;
+            offset = 0;
+        }
+        // Skip empty pieces so done() is exact
+        while (index < buffers.size() && buffers[index].size == offset)
+        {
+            ++index;
+            offset = 0;
+        }
+    }
+
+    template<typename BuffersT>
+    bool done(const BuffersT& buffers) const noexcept
+    {
+        return index >= buffers.size();
+    }
+};
+
+} // namespace slick::socket
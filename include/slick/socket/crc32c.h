@@ -0,0 +1,302 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <nmmintrin.h>
+#define SLICK_SOCKET_CRC32C_X86 1
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define SLICK_SOCKET_CRC32C_ARM 1
+#endif
+
+namespace slick::socket
+{
+
+namespace crc32c_detail
+{
+
+inline constexpr uint32_t polynomial = 0x82F63B78;     // Castagnoli, reflected
+
+// Slicing-by-8 tables for the portable path
+inline constexpr std::array<std::array<uint32_t, 256>, 8> tables = []() {
+    std::array<std::array<uint32_t, 256>, 8> result{};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? polynomial : 0);
+        }
+        result[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        for (size_t t = 1; t < 8; ++t)
+        {
+            result[t][i] = (result[t - 1][i] >> 8) ^ result[0][result[t - 1][i] & 0xFF];
+        }
+    }
+    return result;
+}();
+
+// Raw register update (no inversion), the operation the crc32 instructions perform
+inline uint32_t update_software(uint32_t crc, const uint8_t* data, size_t length) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        for (; length >= 8; data += 8, length -= 8)
+        {
+            uint32_t low, high;
+            std::memcpy(&low, data, 4);
+            std::memcpy(&high, data + 4, 4);
+            low ^= crc;
+            crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^
+                  tables[4][low >> 24] ^ tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^
+                  tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+        }
+    }
+    for (; length > 0; ++data, --length)
+    {
+        crc = (crc >> 8) ^ tables[0][(crc ^ *data) & 0xFF];
+    }
+    return crc;
+}
+
+// Advancing a CRC register over zero bytes is linear, so it can be applied through a table:
+// shift(crc) equals the register after feeding Bytes zero bytes. Used to join CRCs computed
+// over adjacent blocks in parallel.
+template<size_t Bytes>
+class ZeroShift
+{
+public:
+    ZeroShift() noexcept
+    {
+        // Matrix of one zero bit, squared up to 8 * Bytes bits (Bytes is a power of two)
+        Matrix step{};
+        step[0] = polynomial;
+        for (int i = 1; i < 32; ++i)
+        {
+            step[i] = 1u << (i - 1);
+        }
+        for (size_t bits = 1; bits < 8 * Bytes; bits *= 2)
+        {
+            step = multiply(step, step);
+        }
+        for (int j = 0; j < 4; ++j)
+        {
+            for (uint32_t b = 0; b < 256; ++b)
+            {
+                table_[j][b] = apply(step, b << (8 * j));
+            }
+        }
+    }
+
+    uint32_t operator()(uint32_t crc) const noexcept
+    {
+        return table_[0][crc & 0xFF] ^ table_[1][(crc >> 8) & 0xFF] ^ table_[2][(crc >> 16) & 0xFF] ^
+               table_[3][crc >> 24];
+    }
+
+private:
+    static_assert((Bytes & (Bytes - 1)) == 0, "ZeroShift length must be a power of two");
+    using Matrix = std::array<uint32_t, 32>;    // column i: image of bit i
+
+    static uint32_t apply(const Matrix& matrix, uint32_t vector) noexcept
+    {
+        uint32_t result = 0;
+        for (int i = 0; vector != 0; ++i, vector >>= 1)
+        {
+            if (vector & 1)
+            {
+                result ^= matrix[i];
+            }
+        }
+        return result;
+    }
+
+    static Matrix multiply(const Matrix& a, const Matrix& b) noexcept
+    {
+        Matrix result{};
+        for (int i = 0; i < 32; ++i)
+        {
+            result[i] = apply(a, b[i]);
+        }
+        return result;
+    }
+
+    std::array<std::array<uint32_t, 256>, 4> table_{};
+};
+
+#if defined(SLICK_SOCKET_CRC32C_X86)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SLICK_SOCKET_CRC32C_TARGET __attribute__((target("sse4.2")))
+#else
+#define SLICK_SOCKET_CRC32C_TARGET
+#endif
+
+SLICK_SOCKET_CRC32C_TARGET
+inline uint32_t update_words(uint32_t crc, const uint8_t* data, size_t words) noexcept
+{
+    uint64_t value = crc;
+    for (size_t i = 0; i < words; ++i)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + 8 * i, 8);
+        value = _mm_crc32_u64(value, word);
+    }
+    return static_cast<uint32_t>(value);
+}
+
+// Three independent blocks of Block bytes at a time. The crc32 instruction has a latency of 3
+// cycles but a throughput of 1 per cycle, so a single chain leaves two thirds of it idle.
+template<size_t Block>
+SLICK_SOCKET_CRC32C_TARGET
+inline uint32_t update_interleaved(uint32_t crc, const uint8_t*& data, size_t& length) noexcept
+{
+    if (length < 3 * Block)
+    {
+        return crc;
+    }
+    static const ZeroShift<Block> shift;
+    while (length >= 3 * Block)
+    {
+        uint64_t a = crc, b = 0, c = 0;
+        for (size_t i = 0; i < Block; i += 8)
+        {
+            uint64_t wa, wb, wc;
+            std::memcpy(&wa, data + i, 8);
+            std::memcpy(&wb, data + Block + i, 8);
+            std::memcpy(&wc, data + 2 * Block + i, 8);
+            a = _mm_crc32_u64(a, wa);
+            b = _mm_crc32_u64(b, wb);
+            c = _mm_crc32_u64(c, wc);
+        }
+        crc = shift(shift(static_cast<uint32_t>(a)) ^ static_cast<uint32_t>(b)) ^ static_cast<uint32_t>(c);
+        data += 3 * Block;
+        length -= 3 * Block;
+    }
+    return crc;
+}
+
+// Out of line so that the short-message path below stays free of its stack frame
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#elif defined(_MSC_VER)
+__declspec(noinline)
+#endif
+SLICK_SOCKET_CRC32C_TARGET
+inline uint32_t update_long(uint32_t crc, const uint8_t*& data, size_t& length) noexcept
+{
+    crc = update_interleaved<1024>(crc, data, length);
+    return update_interleaved<128>(crc, data, length);
+}
+
+SLICK_SOCKET_CRC32C_TARGET
+inline uint32_t update_sse42(uint32_t crc, const uint8_t* data, size_t length) noexcept
+{
+    // Short messages take a single chain; out-of-order execution already overlaps
+    // consecutive messages, and the joins would cost more than they save
+    if (length >= 3 * 128)
+    {
+        crc = update_long(crc, data, length);
+    }
+    crc = update_words(crc, data, length / 8);
+    data += length & ~size_t(7);
+    if (length & 4)
+    {
+        uint32_t word;
+        std::memcpy(&word, data, 4);
+        crc = _mm_crc32_u32(crc, word);
+        data += 4;
+    }
+    if (length & 2)
+    {
+        uint16_t half;
+        std::memcpy(&half, data, 2);
+        crc = _mm_crc32_u16(crc, half);
+        data += 2;
+    }
+    if (length & 1)
+    {
+        crc = _mm_crc32_u8(crc, *data);
+    }
+    return crc;
+}
+
+#undef SLICK_SOCKET_CRC32C_TARGET
+
+inline bool cpu_has_sse42() noexcept
+{
+#if defined(__SSE4_2__)
+    return true;
+#elif defined(__GNUC__) || defined(__clang__)
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+#else
+    return true;    // MSVC x64 targets: every CPU that runs them in practice has SSE4.2
+#endif
+}
+
+#elif defined(SLICK_SOCKET_CRC32C_ARM)
+
+inline uint32_t update_arm(uint32_t crc, const uint8_t* data, size_t length) noexcept
+{
+    for (; length >= 8; data += 8, length -= 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        crc = __crc32cd(crc, word);
+    }
+    for (; length > 0; ++data, --length)
+    {
+        crc = __crc32cb(crc, *data);
+    }
+    return crc;
+}
+
+#endif
+
+} // namespace crc32c_detail
+
+// True when crc32c() runs on the CPU's CRC32C instructions rather than tables
+inline bool crc32c_hardware() noexcept
+{
+#if defined(SLICK_SOCKET_CRC32C_X86)
+    return crc32c_detail::cpu_has_sse42();
+#elif defined(SLICK_SOCKET_CRC32C_ARM)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// CRC32C (Castagnoli), as in iSCSI, SCTP and ext4: crc32c("123456789", 9) == 0xE3069283.
+// Pass a previous result as crc to continue it: crc32c(b, crc32c(a)) == crc32c(a + b).
+// SSE4.2 on x86-64 (checked once) or the ARMv8 CRC extension, slicing-by-8 tables otherwise.
+inline uint32_t crc32c(const void* data, size_t length, uint32_t crc = 0) noexcept
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+#if defined(SLICK_SOCKET_CRC32C_X86)
+    if (crc32c_detail::cpu_has_sse42())
+    {
+        return ~crc32c_detail::update_sse42(~crc, bytes, length);
+    }
+    return ~crc32c_detail::update_software(~crc, bytes, length);
+#elif defined(SLICK_SOCKET_CRC32C_ARM)
+    return ~crc32c_detail::update_arm(~crc, bytes, length);
+#else
+    return ~crc32c_detail::update_software(~crc, bytes, length);
+#endif
+}
+
+} // namespace slick::socket
@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <slick/socket/numa.h>
+#endif
+
+namespace slick::socket
+{
+
+enum class AddressFamily : uint8_t
+{
+    None,
+    IPv4,
+    IPv6,
+};
+
+// IPv4 or IPv6 address and port in binary form: fixed size, trivially copyable, no allocation.
+// Converting from and to sockaddr is a copy; text is only produced by to_string()/address_string().
+// IPv4-mapped IPv6 addresses (::ffff:a.b.c.d, seen on dual-stack sockets) are stored as IPv4.
+struct Endpoint
+{
+    std::array<uint8_t, 16> address{};  // network byte order; IPv4 uses the first 4 bytes
+    uint32_t scope_id = 0;              // IPv6 interface index for link-local addresses
+    uint16_t port = 0;                  // host byte order
+    AddressFamily family = AddressFamily::None;
+
+    bool is_v4() const noexcept { return family == AddressFamily::IPv4; }
+    bool is_v6() const noexcept { return family == AddressFamily::IPv6; }
+
+    bool is_multicast() const noexcept
+    {
+        return (is_v4() && (address[0] & 0xF0) == 0xE0) || (is_v6() && address[0] == 0xFF);
+    }
+
+    bool is_loopback() const noexcept
+    {
+        static constexpr std::array<uint8_t, 16> v6_loopback{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+        return (is_v4() && address[0] == 127) || (is_v6() && address == v6_loopback);
+    }
+
+    bool is_unspecified() const noexcept
+    {
+        size_t length = is_v4() ? 4 : 16;
+        for (size_t i = 0; i < length; ++i)
+        {
+            if (address[i] != 0)
+            {
+                return false;
+            }
+        }
+        return family != AddressFamily::None;
+    }
+
+    // AF_INET/AF_INET6 for socket(); AF_UNSPEC when unset
+    int socket_family() const noexcept
+    {
+        return is_v6() ? AF_INET6 : is_v4() ? AF_INET : AF_UNSPEC;
+    }
+
+    bool operator==(const Endpoint&) const = default;
+
+    // Returns false for families other than AF_INET/AF_INET6
+    bool from_sockaddr(const sockaddr* addr) noexcept
+    {
+        if (addr->sa_family == AF_INET)
+        {
+            const auto* in = reinterpret_cast<const sockaddr_in*>(addr);
+            *this = Endpoint{};
+            family = AddressFamily::IPv4;
+            std::memcpy(address.data(), &in->sin_addr, 4);
+            port = ntohs(in->sin_port);
+            return true;
+        }
+        if (addr->sa_family == AF_INET6)
+        {
+            const auto* in6 = reinterpret_cast<const sockaddr_in6*>(addr);
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&in6->sin6_addr);
+            static constexpr uint8_t v4_mapped_prefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+            *this = Endpoint{};
+            port = ntohs(in6->sin6_port);
+            if (std::memcmp(bytes, v4_mapped_prefix, sizeof(v4_mapped_prefix)) == 0)
+            {
+                family = AddressFamily::IPv4;
+                std::memcpy(address.data(), bytes + 12, 4);
+            }
+            else
+            {
+                family = AddressFamily::IPv6;
+                std::memcpy(address.data(), bytes, 16);
+                scope_id = in6->sin6_scope_id;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // Fills storage and returns the length to pass to bind/connect/sendto, 0 when unset
+    socklen_t to_sockaddr(sockaddr_storage& storage) const noexcept
+    {
+        std::memset(&storage, 0, sizeof(storage));
+        if (is_v4())
+        {
+            auto* in = reinterpret_cast<sockaddr_in*>(&storage);
+            in->sin_family = AF_INET;
+            in->sin_port = htons(port);
+            std::memcpy(&in->sin_addr, address.data(), 4);
+            return sizeof(sockaddr_in);
+        }
+        if (is_v6())
+        {
+            auto* in6 = reinterpret_cast<sockaddr_in6*>(&storage);
+            in6->sin6_family = AF_INET6;
+            in6->sin6_port = htons(port);
+            in6->sin6_scope_id = scope_id;
+            std::memcpy(&in6->sin6_addr, address.data(), 16);
+            return sizeof(sockaddr_in6);
+        }
+        return 0;
+    }
+
+    // "10.0.0.1" or "fe80::1"
+    std::string address_string() const
+    {
+        char text[INET6_ADDRSTRLEN] = {};
+        if (is_v4())
+        {
+            inet_ntop(AF_INET, address.data(), text, sizeof(text));
+        }
+        else if (is_v6())
+        {
+            inet_ntop(AF_INET6, address.data(), text, sizeof(text));
+        }
+        return text;
+    }
+
+    // "10.0.0.1:5000" or "[fe80::1]:5000"
+    std::string to_string() const
+    {
+        return is_v6() ? "[" + address_string() + "]:" + std::to_string(port)
+                       : address_string() + ":" + std::to_string(port);
+    }
+
+    // Numeric IPv4 or IPv6 address, optionally bracketed and with a "%scope" suffix
+    // ("fe80::1%eth0", "[ff02::1%2]"). Host names are not resolved.
+    static bool parse(std::string_view host, uint16_t port, Endpoint& out);
+};
+
+// Interface index for IPv6 multicast and scope ids: a number, an interface name or one of
+// its IPv4 addresses. Empty and the wildcard addresses give 0 (any interface).
+// Names and addresses are only resolved on Unix.
+inline unsigned interface_index(const std::string& interface_name)
+{
+    if (interface_name.empty() || interface_name == "0.0.0.0" || interface_name == "::")
+    {
+        return 0;
+    }
+    if (interface_name.find_first_not_of("0123456789") == std::string::npos)
+    {
+        return static_cast<unsigned>(std::stoul(interface_name));
+    }
+#if defined(_WIN32) || defined(_WIN64)
+    return 0;
+#else
+    std::string name = interface_of_address(interface_name);
+    return if_nametoindex(name.empty() ? interface_name.c_str() : name.c_str());
+#endif
+}
+
+inline bool Endpoint::parse(std::string_view host, uint16_t port, Endpoint& out)
+{
+    if (host.size() >= 2 && host.front() == '[' && host.back() == ']')
+    {
+        host = host.substr(1, host.size() - 2);
+    }
+
+    std::string scope;
+    size_t percent = host.find('%');
+    if (percent != std::string_view::npos)
+    {
+        scope = std::string(host.substr(percent + 1));
+        host = host.substr(0, percent);
+    }
+
+    std::string text(host);
+    Endpoint result;
+    result.port = port;
+    if (scope.empty() && inet_pton(AF_INET, text.c_str(), result.address.data()) == 1)
+    {
+        result.family = AddressFamily::IPv4;
+    }
+    else if (inet_pton(AF_INET6, text.c_str(), result.address.data()) == 1)
+    {
+        result.family = AddressFamily::IPv6;
+        if (!scope.empty())
+        {
+            result.scope_id = interface_index(scope);
+            if (result.scope_id == 0)
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    out = result;
+    return true;
+}
+
+} // namespace slick::socket
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstdint>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+namespace slick::socket
+{
+
+// Cross-thread wake-up for the event loops.
+// Linux uses an eventfd; other Unix platforms fall back to a non-blocking self-pipe.
+// fd() is registered in the loop's epoll/kqueue set, notify() may be called from any thread.
+class EventNotifier
+{
+public:
+    EventNotifier() = default;
+    ~EventNotifier() { close(); }
+
+    EventNotifier(const EventNotifier&) = delete;
+    EventNotifier& operator=(const EventNotifier&) = delete;
+
+    bool open() noexcept
+    {
+        if (read_fd_ >= 0)
+        {
+            return true;
+        }
+#ifdef __linux__
+        read_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        write_fd_ = read_fd_;
+        return read_fd_ >= 0;
+#else
+        int fds[2];
+        if (pipe(fds) < 0)
+        {
+            return false;
+        }
+        for (int fd : fds)
+        {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        read_fd_ = fds[0];
+        write_fd_ = fds[1];
+        return true;
+#endif
+    }
+
+    void close() noexcept
+    {
+        if (write_fd_ >= 0 && write_fd_ != read_fd_)
+        {
+            ::close(write_fd_);
+        }
+        if (read_fd_ >= 0)
+        {
+            ::close(read_fd_);
+        }
+        read_fd_ = -1;
+        write_fd_ = -1;
+    }
+
+    bool is_open() const noexcept { return read_fd_ >= 0; }
+    int fd() const noexcept { return read_fd_; }
+
+    void notify() noexcept
+    {
+#ifdef __linux__
+        uint64_t one = 1;
+        ssize_t rc = ::write(write_fd_, &one, sizeof(one));
+#else
+        uint8_t one = 1;
+        ssize_t rc = ::write(write_fd_, &one, sizeof(one));
+#endif
+        (void)rc;   // EAGAIN means a wake-up is already pending
+    }
+
+    // Consume pending notifications. Call from the loop thread when fd() is readable.
+    void drain() noexcept
+    {
+#ifdef __linux__
+        uint64_t value;
+        ssize_t rc = ::read(read_fd_, &value, sizeof(value));
+        (void)rc;
+#else
+        uint8_t scratch[64];
+        while (::read(read_fd_, scratch, sizeof(scratch)) > 0)
+        {
+        }
+#endif
+    }
+
+private:
+    int read_fd_ = -1;
+    int write_fd_ = -1;
+};
+
+} // namespace slick::socket
+
+#endif // !_WIN32 && !_WIN64
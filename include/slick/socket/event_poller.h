@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+#include <unistd.h>
+#include <cerrno>
+
+#ifdef __APPLE__
+#include <sys/event.h>
+#include <sys/time.h>
+#else
+#include <sys/epoll.h>
+#endif
+
+namespace slick::socket
+{
+
+// Thin wrapper over epoll (Linux) / kqueue (macOS) shared by all event loops.
+class EventPoller
+{
+public:
+    static constexpr int max_batch = 256;
+
+    struct Event
+    {
+        int fd;
+        bool readable;
+        bool writable;
+    };
+
+    EventPoller() = default;
+    ~EventPoller() { close(); }
+
+    EventPoller(const EventPoller&) = delete;
+    EventPoller& operator=(const EventPoller&) = delete;
+
+    bool open() noexcept
+    {
+        if (fd_ >= 0)
+        {
+            return true;
+        }
+#ifdef __APPLE__
+        fd_ = kqueue();
+#else
+        fd_ = epoll_create1(EPOLL_CLOEXEC);
+#endif
+        return fd_ >= 0;
+    }
+
+    void close() noexcept
+    {
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    bool is_open() const noexcept { return fd_ >= 0; }
+
+    bool add(int fd, bool read, bool write, bool edge_triggered = false) noexcept
+    {
+#ifdef __APPLE__
+        return apply(fd, read, write, edge_triggered);
+#else
+        return control(EPOLL_CTL_ADD, fd, read, write, edge_triggered);
+#endif
+    }
+
+    bool modify(int fd, bool read, bool write, bool edge_triggered = false) noexcept
+    {
+#ifdef __APPLE__
+        return apply(fd, read, write, edge_triggered);
+#else
+        return control(EPOLL_CTL_MOD, fd, read, write, edge_triggered);
+#endif
+    }
+
+    void remove(int fd) noexcept
+    {
+#ifdef __APPLE__
+        apply(fd, false, false, false);
+#else
+        epoll_ctl(fd_, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+    }
+
+    // Wait for up to max_events (capped at max_batch); timeout_ms < 0 blocks indefinitely.
+    // Returns the number of events written to out, or -1 with errno set.
+    int wait(Event* out, int max_events, int timeout_ms) noexcept
+    {
+        if (max_events > max_batch)
+        {
+            max_events = max_batch;
+        }
+#ifdef __APPLE__
+        struct timespec ts;
+        struct timespec* ts_ptr = nullptr;
+        if (timeout_ms >= 0)
+        {
+            ts.tv_sec = timeout_ms / 1000;
+            ts.tv_nsec = (timeout_ms % 1000) * 1000000L;
+            ts_ptr = &ts;
+        }
+        int n = kevent(fd_, nullptr, 0, native_, max_events, ts_ptr);
+        for (int i = 0; i < n; ++i)
+        {
+            out[i].fd = static_cast<int>(native_[i].ident);
+            out[i].readable = native_[i].filter == EVFILT_READ;
+            out[i].writable = native_[i].filter == EVFILT_WRITE;
+        }
+#else
+        int n = epoll_wait(fd_, native_, max_events, timeout_ms);
+        for (int i = 0; i < n; ++i)
+        {
+            out[i].fd = native_[i].data.fd;
+            out[i].readable = (native_[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLRDHUP)) != 0;
+            out[i].writable = (native_[i].events & EPOLLOUT) != 0;
+        }
+#endif
+        return n;
+    }
+
+private:
+#ifdef __APPLE__
+    bool apply(int fd, bool read, bool write, bool edge_triggered) noexcept
+    {
+        // Submit filters one at a time so deleting an absent filter does not abort the other
+        unsigned short clear = edge_triggered ? EV_CLEAR : 0;
+        struct kevent ev;
+        EV_SET(&ev, fd, EVFILT_READ, read ? (EV_ADD | clear) : EV_DELETE, 0, 0, 0);
+        int rc_read = kevent(fd_, &ev, 1, nullptr, 0, nullptr);
+        EV_SET(&ev, fd, EVFILT_WRITE, write ? (EV_ADD | clear) : EV_DELETE, 0, 0, 0);
+        int rc_write = kevent(fd_, &ev, 1, nullptr, 0, nullptr);
+        return (!read || rc_read == 0) && (!write || rc_write == 0);
+    }
+
+    struct kevent native_[max_batch];
+#else
+    bool control(int op, int fd, bool read, bool write, bool edge_triggered) noexcept
+    {
+        struct epoll_event ev{};
+        ev.events = (read ? EPOLLIN : 0u) | (write ? EPOLLOUT : 0u) | (edge_triggered ? EPOLLET : 0u);
+        ev.data.fd = fd;
+        return epoll_ctl(fd_, op, fd, &ev) == 0;
+    }
+
+    struct epoll_event native_[max_batch];
+#endif
+
+    int fd_ = -1;
+};
+
+} // namespace slick::socket
+
+#endif // !_WIN32 && !_WIN64
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+namespace slick::socket
+{
+
+// Application heartbeats, driven by the loop thread's wait timeout
+struct HeartbeatConfig
+{
+    std::chrono::milliseconds idle_interval{0};  // send frame after this long without outbound data, 0 = never
+    std::chrono::milliseconds peer_timeout{0};   // close after this long without inbound data, 0 = never
+    std::vector<uint8_t> frame;                  // heartbeat payload, sent as-is
+
+    bool sends() const noexcept { return idle_interval.count() > 0 && !frame.empty(); }
+    bool checks_peer() const noexcept { return peer_timeout.count() > 0; }
+    bool enabled() const noexcept { return sends() || checks_peer(); }
+};
+
+// Connections ordered by their last activity. With a single timeout per list the head is always
+// the next to expire, so touch() and each expiry are O(1) regardless of the connection count.
+// Closed connections are unlinked with erase(), also O(1).
+class ActivityList
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        int id;
+        Clock::time_point at;
+    };
+    using Iterator = std::list<Entry>::iterator;
+
+    Iterator insert(int id, Clock::time_point now)
+    {
+        return entries_.insert(entries_.end(), Entry{id, now});
+    }
+
+    // Move to the tail with a new time; the iterator stays valid
+    void touch(Iterator it, Clock::time_point now)
+    {
+        it->at = now;
+        if (std::next(it) != entries_.end())
+        {
+            entries_.splice(entries_.end(), entries_, it);
+        }
+    }
+
+    void erase(Iterator it) { entries_.erase(it); }
+
+    bool empty() const noexcept { return entries_.empty(); }
+    const Entry& front() const { return entries_.front(); }
+    void pop_front() { entries_.pop_front(); }
+    void clear() { entries_.clear(); }
+
+private:
+    std::list<Entry> entries_;
+};
+
+} // namespace slick::socket
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <slick/socket/clock.h>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace slick::socket
+{
+
+// Send timestamps: nanoseconds since the Unix epoch (system_clock, read through TscClock). One-way
+// latencies between hosts are only as good as their clock synchronisation (PTP); on the same host
+// they are within TscClock's tracking error, typically well under a microsecond.
+inline uint64_t timestamp_ns() noexcept
+{
+    return static_cast<uint64_t>(TscClock::realtime_ns());
+}
+
+// Log-linear histogram of nanosecond values: exact below 16 ns, then 16 buckets per power of two
+// (relative error under 6.25%), covering the full 64-bit range in under 8 KB. record() is a
+// few relaxed loads and stores. One thread records; any thread may read. reset() must not race
+// with record().
+class LatencyHistogram
+{
+public:
+    static constexpr size_t sub_buckets = 16;
+    static constexpr size_t bucket_count = (64 - 3) * sub_buckets;
+
+    void record(uint64_t value) noexcept
+    {
+        increment(buckets_[bucket_of(value)], 1);
+        increment(count_, 1);
+        increment(sum_, value);
+        if (value < min_.load(std::memory_order_relaxed))
+        {
+            min_.store(value, std::memory_order_relaxed);
+        }
+        if (value > max_.load(std::memory_order_relaxed))
+        {
+            max_.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    // Send timestamp against now; a sender clock ahead of ours records 0 and is counted in clock_skew()
+    void record_since(uint64_t sent_ns, uint64_t now_ns) noexcept
+    {
+        if (now_ns < sent_ns)
+        {
+            increment(skewed_, 1);
+            record(0);
+            return;
+        }
+        record(now_ns - sent_ns);
+    }
+
+    uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+    uint64_t clock_skew() const noexcept { return skewed_.load(std::memory_order_relaxed); }
+    uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+    uint64_t min() const noexcept
+    {
+        return count() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+    }
+
+    double mean() const noexcept
+    {
+        uint64_t samples = count();
+        return samples == 0 ? 0.0 : static_cast<double>(sum_.load(std::memory_order_relaxed)) / samples;
+    }
+
+    // Upper bound of the bucket holding quantile q (0..1), clamped to the largest value seen
+    uint64_t percentile(double q) const noexcept
+    {
+        uint64_t samples = count();
+        if (samples == 0)
+        {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(samples - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < bucket_count; ++i)
+        {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank)
+            {
+                uint64_t upper = bucket_upper(i);
+                return upper < max() ? upper : max();
+            }
+        }
+        return max();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& bucket : buckets_)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        skewed_.store(0, std::memory_order_relaxed);
+        min_.store(UINT64_MAX, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    static size_t bucket_of(uint64_t value) noexcept
+    {
+        if (value < sub_buckets)
+        {
+            return static_cast<size_t>(value);
+        }
+        unsigned exponent = static_cast<unsigned>(std::bit_width(value)) - 1;     // >= 4
+        size_t sub = static_cast<size_t>(value >> (exponent - 4)) & (sub_buckets - 1);
+        return (exponent - 3) * sub_buckets + sub;
+    }
+
+    // Largest value that falls in bucket i
+    static uint64_t bucket_upper(size_t i) noexcept
+    {
+        if (i < sub_buckets)
+        {
+            return i;
+        }
+        unsigned exponent = static_cast<unsigned>(i / sub_buckets) + 3;
+        uint64_t base = (sub_buckets + i % sub_buckets) << (exponent - 4);
+        return base + ((uint64_t(1) << (exponent - 4)) - 1);
+    }
+
+private:
+    // Single writer: a load and a store, not a locked read-modify-write
+    static void increment(std::atomic<uint64_t>& counter, uint64_t by) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, bucket_count> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> skewed_{0};
+    std::atomic<uint64_t> min_{UINT64_MAX};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace slick::socket
@@ -0,0 +1,672 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "crc32c.h"
+#include "latency.h"
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+namespace slick::socket
+{
+
+// Fixed-layout binary messages read in place from receive buffers.
+//
+// A schema lists the fields in wire order; offsets and the message size are computed at compile
+// time and fields are looked up by name, so an accessor compiles to one unaligned load (plus a
+// byte swap when the wire order differs from the host):
+//
+//   using AddOrder = MessageSchema<1, ByteOrder::Big,
+//       Field<"order_id", uint64_t>,
+//       Field<"side", char>,
+//       Field<"quantity", uint32_t>,
+//       Field<"symbol", char[8]>,
+//       Field<"price", int64_t>>;
+//
+//   MessageView<AddOrder> order(body);
+//   int64_t price = order.get<"price">();
+//   std::string_view symbol = order.get<"symbol">();   // up to the first NUL, no copy
+//
+// Field types: integers, bool, enums, float, double and char[N].
+
+enum class ByteOrder : uint8_t
+{
+    Little,
+    Big,
+};
+
+// Field name as a template argument: Field<"price", int64_t>
+template<size_t N>
+struct FieldName
+{
+    constexpr FieldName(const char (&text)[N])
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            value[i] = text[i];
+        }
+    }
+
+    constexpr std::string_view view() const noexcept { return std::string_view(value, N - 1); }
+
+    char value[N]{};
+};
+
+template<FieldName Name, typename T>
+struct Field
+{
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+                  (std::is_array_v<T> && std::is_same_v<std::remove_extent_t<T>, char> && std::rank_v<T> == 1),
+                  "message fields are arithmetic, enum or char[N]");
+
+    using type = T;
+    static constexpr std::string_view name = Name.view();
+    static constexpr size_t size = sizeof(T);
+};
+
+namespace message_detail
+{
+
+template<size_t Size>
+struct unsigned_of_size;
+template<> struct unsigned_of_size<1> { using type = uint8_t; };
+template<> struct unsigned_of_size<2> { using type = uint16_t; };
+template<> struct unsigned_of_size<4> { using type = uint32_t; };
+template<> struct unsigned_of_size<8> { using type = uint64_t; };
+
+template<typename T>
+inline T byteswap(T value) noexcept
+{
+    if constexpr (sizeof(T) == 1)
+    {
+        return value;
+    }
+#if defined(_MSC_VER)
+    else if constexpr (sizeof(T) == 2)
+    {
+        return _byteswap_ushort(value);
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        return _byteswap_ulong(value);
+    }
+    else
+    {
+        return _byteswap_uint64(value);
+    }
+#else
+    else if constexpr (sizeof(T) == 2)
+    {
+        return __builtin_bswap16(value);
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        return __builtin_bswap32(value);
+    }
+    else
+    {
+        return __builtin_bswap64(value);
+    }
+#endif
+}
+
+template<ByteOrder Order>
+inline constexpr bool needs_swap = (Order == ByteOrder::Little) != (std::endian::native == std::endian::little);
+
+// memcpy of a fixed size is a single unaligned load on every target we build for
+template<typename T, ByteOrder Order>
+inline auto load(const uint8_t* data) noexcept
+{
+    if constexpr (std::is_array_v<T>)
+    {
+        // Text fields are short; a loop the compiler can unroll beats a memchr call
+        const char* text = reinterpret_cast<const char*>(data);
+        size_t length = 0;
+        while (length < sizeof(T) && text[length] != '\0')
+        {
+            ++length;
+        }
+        return std::string_view(text, length);
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        return static_cast<T>(load<std::underlying_type_t<T>, Order>(data));
+    }
+    else
+    {
+        using Bits = typename unsigned_of_size<sizeof(T)>::type;
+        Bits bits;
+        std::memcpy(&bits, data, sizeof(bits));
+        if constexpr (needs_swap<Order>)
+        {
+            bits = byteswap(bits);
+        }
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            return bits != 0;
+        }
+        else
+        {
+            return std::bit_cast<T>(bits);
+        }
+    }
+}
+
+template<typename T, ByteOrder Order, typename ValueT>
+inline void store(uint8_t* data, const ValueT& value) noexcept
+{
+    if constexpr (std::is_array_v<T>)
+    {
+        // NUL padded, truncated to the field
+        std::string_view text(value);
+        size_t length = text.size() < sizeof(T) ? text.size() : sizeof(T);
+        std::memcpy(data, text.data(), length);
+        std::memset(data + length, 0, sizeof(T) - length);
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        store<std::underlying_type_t<T>, Order>(data, static_cast<std::underlying_type_t<T>>(value));
+    }
+    else
+    {
+        using Bits = typename unsigned_of_size<sizeof(T)>::type;
+        Bits bits = std::is_same_v<T, bool> ? Bits(value ? 1 : 0) : std::bit_cast<Bits>(static_cast<T>(value));
+        if constexpr (needs_swap<Order>)
+        {
+            bits = byteswap(bits);
+        }
+        std::memcpy(data, &bits, sizeof(bits));
+    }
+}
+
+} // namespace message_detail
+
+template<uint16_t TypeId, ByteOrder Order, typename... Fields>
+struct MessageSchema
+{
+    static constexpr uint16_t type_id = TypeId;
+    static constexpr ByteOrder byte_order = Order;
+    static constexpr size_t field_count = sizeof...(Fields);
+    static constexpr size_t size = (size_t(0) + ... + Fields::size);
+
+    static constexpr std::array<std::string_view, field_count> names{Fields::name...};
+    static constexpr std::array<size_t, field_count> offsets = []() {
+        std::array<size_t, field_count> result{};
+        constexpr std::array<size_t, field_count> sizes{Fields::size...};
+        size_t offset = 0;
+        for (size_t i = 0; i < field_count; ++i)
+        {
+            result[i] = offset;
+            offset += sizes[i];
+        }
+        return result;
+    }();
+
+    // field_count when there is no such field
+    static constexpr size_t index_of(std::string_view name) noexcept
+    {
+        for (size_t i = 0; i < field_count; ++i)
+        {
+            if (names[i] == name)
+            {
+                return i;
+            }
+        }
+        return field_count;
+    }
+
+    template<size_t Index>
+    using field_type = typename std::tuple_element_t<Index, std::tuple<Fields...>>::type;
+
+    static_assert([]() {
+        for (size_t i = 0; i < field_count; ++i)
+        {
+            for (size_t j = i + 1; j < field_count; ++j)
+            {
+                if (names[i] == names[j])
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }(), "duplicate field name in message schema");
+};
+
+// Read-only accessors over a message body. The view does not own or copy the bytes; the
+// caller checks that at least SchemaT::size bytes are readable (MessageDispatcher does).
+template<typename SchemaT>
+class MessageView
+{
+public:
+    using Schema = SchemaT;
+
+    explicit MessageView(const uint8_t* data) noexcept
+        : data_(data)
+    {
+    }
+
+    template<FieldName Name>
+    auto get() const noexcept
+    {
+        constexpr size_t index = SchemaT::index_of(Name.view());
+        static_assert(index < SchemaT::field_count, "no such field in message schema");
+        using T = typename SchemaT::template field_type<index>;
+        return message_detail::load<T, SchemaT::byte_order>(data_ + SchemaT::offsets[index]);
+    }
+
+    const uint8_t* data() const noexcept { return data_; }
+    static constexpr size_t size() noexcept { return SchemaT::size; }
+
+private:
+    const uint8_t* data_;
+};
+
+// Writes fields in place, e.g. into the body returned by append_message()
+template<typename SchemaT>
+class MessageWriter
+{
+public:
+    using Schema = SchemaT;
+
+    explicit MessageWriter(uint8_t* data) noexcept
+        : data_(data)
+    {
+    }
+
+    template<FieldName Name, typename ValueT>
+    MessageWriter& set(const ValueT& value) noexcept
+    {
+        constexpr size_t index = SchemaT::index_of(Name.view());
+        static_assert(index < SchemaT::field_count, "no such field in message schema");
+        using T = typename SchemaT::template field_type<index>;
+        message_detail::store<T, SchemaT::byte_order>(data_ + SchemaT::offsets[index], value);
+        return *this;
+    }
+
+    MessageView<SchemaT> view() const noexcept { return MessageView<SchemaT>(data_); }
+    uint8_t* data() const noexcept { return data_; }
+
+private:
+    uint8_t* data_;
+};
+
+// Framing: every message is preceded by a 4-byte little-endian header,
+// uint16 body length then uint16 type id.
+inline constexpr size_t message_header_size = 4;
+
+// Optional trailer after each message body. CRC32C covers the header and body and is stored
+// little endian; TCP's own 16-bit checksum misses some corruption that crosses NICs, offload
+// engines and middleboxes.
+enum class MessageIntegrity : uint8_t
+{
+    None,
+    CRC32C,
+};
+
+// Optional send time after the body, ahead of any CRC: timestamp_ns() as a little-endian uint64,
+// appended by stamp_message(). The receiving framer records one-way latency before delivering.
+enum class MessageTimestamp : uint8_t
+{
+    None,
+    Send,
+};
+
+inline constexpr size_t message_trailer_size(MessageIntegrity integrity,
+                                             MessageTimestamp timestamp = MessageTimestamp::None) noexcept
+{
+    return (integrity == MessageIntegrity::CRC32C ? 4 : 0) + (timestamp == MessageTimestamp::Send ? 8 : 0);
+}
+
+// Appends a zeroed message with its header to out and returns a writer for the body.
+// The writer is valid until out is modified again.
+template<typename SchemaT>
+inline MessageWriter<SchemaT> append_message(std::vector<uint8_t>& out)
+{
+    static_assert(SchemaT::size <= 0xFFFF, "message body does not fit the 16-bit length");
+    size_t at = out.size();
+    out.resize(at + message_header_size + SchemaT::size);
+    message_detail::store<uint16_t, ByteOrder::Little>(out.data() + at, static_cast<uint16_t>(SchemaT::size));
+    message_detail::store<uint16_t, ByteOrder::Little>(out.data() + at + 2, SchemaT::type_id);
+    std::memset(out.data() + at + message_header_size, 0, SchemaT::size);
+    return MessageWriter<SchemaT>(out.data() + at + message_header_size);
+}
+
+// Appends the send time to the message just appended, once its fields are set
+inline void stamp_message(std::vector<uint8_t>& out)
+{
+    size_t at = out.size();
+    out.resize(at + 8);
+    message_detail::store<uint64_t, ByteOrder::Little>(out.data() + at, timestamp_ns());
+}
+
+// Appends the CRC32C trailer for the message starting at frame_start, last of all:
+//   size_t at = out.size();
+//   append_message<AddOrder>(out).set<"price">(100);
+//   stamp_message(out);      // with MessageTimestamp::Send
+//   seal_message(out, at);
+inline void seal_message(std::vector<uint8_t>& out, size_t frame_start)
+{
+    uint32_t crc = crc32c(out.data() + frame_start, out.size() - frame_start);
+    size_t at = out.size();
+    out.resize(at + 4);
+    message_detail::store<uint32_t, ByteOrder::Little>(out.data() + at, crc);
+}
+
+namespace message_detail
+{
+
+template<typename HandlerT>
+inline bool deliver(HandlerT& on_message, uint16_t type, const uint8_t* body, size_t length)
+{
+    if constexpr (std::is_same_v<std::invoke_result_t<HandlerT&, uint16_t, const uint8_t*, size_t>, bool>)
+    {
+        return on_message(type, body, length);
+    }
+    else
+    {
+        on_message(type, body, length);
+        return true;
+    }
+}
+
+// The 4-byte CRC follows the covered bytes of the frame
+inline bool crc_matches(const uint8_t* frame, size_t covered) noexcept
+{
+    return crc32c(frame, covered) == load<uint32_t, ByteOrder::Little>(frame + covered);
+}
+
+} // namespace message_detail
+
+// Splits a TCP byte stream into framed messages. on_message(uint16_t type, const uint8_t* body,
+// size_t length) may return bool; false stops delivery (e.g. the connection was closed).
+// Whole messages are delivered in place from the caller's buffer; only a message split across
+// reads is copied, once, into an internal buffer.
+// With MessageIntegrity::CRC32C every message must carry a trailer (see seal_message); messages
+// whose CRC does not match are dropped and counted in corrupt_count(). With MessageTimestamp::Send
+// every message carries its send time (stamp_message), recorded against the time feed() was called
+// into the histogram given to set_latency_histogram().
+class MessageFramer
+{
+public:
+    explicit MessageFramer(size_t max_message_size = 0xFFFF, MessageIntegrity integrity = MessageIntegrity::None,
+                           MessageTimestamp timestamp = MessageTimestamp::None)
+        : max_message_size_(max_message_size)
+        , trailer_size_(message_trailer_size(integrity, timestamp))
+        , timestamp_size_(message_trailer_size(MessageIntegrity::None, timestamp))
+        , checks_crc_(integrity == MessageIntegrity::CRC32C)
+    {
+    }
+
+    // Histogram for the one-way latency of timestamped messages; may be shared by the framers of
+    // one loop thread, nullptr to stop recording
+    void set_latency_histogram(LatencyHistogram* histogram) noexcept { latency_ = histogram; }
+
+    // Returns false when a header announces more than max_message_size; the stream is unusable
+    template<typename MessageHandlerT>
+    bool feed(const uint8_t* data, size_t length, MessageHandlerT&& on_message)
+    {
+        uint64_t now = 0;   // arrival time, read once per call and only when needed
+        if (!pending_.empty())
+        {
+            while (length > 0)
+            {
+                size_t wanted = pending_wanted();
+                size_t chunk = wanted < length ? wanted : length;
+                pending_.insert(pending_.end(), data, data + chunk);
+                data += chunk;
+                length -= chunk;
+                if (pending_.size() == message_header_size && body_length(pending_.data()) > max_message_size_)
+                {
+                    return false;
+                }
+                if (pending_wanted() == 0)
+                {
+                    break;
+                }
+            }
+            if (pending_wanted() > 0)
+            {
+                return true;
+            }
+
+            size_t body = body_length(pending_.data());
+            bool more = true;
+            if (trailer_size_ == 0 || accept_trailer(pending_.data(), body, now))
+            {
+                more = message_detail::deliver(on_message, type_of(pending_.data()),
+                                               pending_.data() + message_header_size, body);
+            }
+            pending_.clear();
+            if (!more)
+            {
+                return true;
+            }
+        }
+
+        // Local copies: handler stores could alias the members and force a reload per message
+        const size_t max_message_size = max_message_size_;
+        const size_t trailer_size = trailer_size_;
+        while (length >= message_header_size)
+        {
+            size_t body = body_length(data);
+            if (body > max_message_size)
+            {
+                return false;
+            }
+            size_t frame = message_header_size + body + trailer_size;
+            if (length < frame)
+            {
+                break;
+            }
+            if ((trailer_size == 0 || accept_trailer(data, body, now)) &&
+                !message_detail::deliver(on_message, type_of(data), data + message_header_size, body))
+            {
+                return true;
+            }
+            data += frame;
+            length -= frame;
+        }
+
+        pending_.assign(data, data + length);
+        return true;
+    }
+
+    // Datagrams carry whole messages, so nothing is kept between calls. False when the
+    // datagram ends in a truncated message, or on the first message failing its CRC (a
+    // damaged length would misplace everything after it).
+    template<typename MessageHandlerT>
+    static bool for_each_message(const uint8_t* data, size_t length, MessageHandlerT&& on_message,
+                                 MessageIntegrity integrity = MessageIntegrity::None,
+                                 MessageTimestamp timestamp = MessageTimestamp::None)
+    {
+        const size_t trailer_size = message_trailer_size(integrity, timestamp);
+        const size_t crc_size = trailer_size - message_trailer_size(MessageIntegrity::None, timestamp);
+        while (length >= message_header_size)
+        {
+            size_t body = body_length(data);
+            size_t frame = message_header_size + body + trailer_size;
+            if (length < frame)
+            {
+                return false;
+            }
+            if (crc_size != 0 && !message_detail::crc_matches(data, frame - crc_size))
+            {
+                return false;
+            }
+            if (!message_detail::deliver(on_message, type_of(data), data + message_header_size, body))
+            {
+                return true;
+            }
+            data += frame;
+            length -= frame;
+        }
+        return length == 0;
+    }
+
+    size_t buffered() const noexcept { return pending_.size(); }
+    void reset() { pending_.clear(); }
+
+    // Messages dropped because their CRC32C trailer did not match
+    uint64_t corrupt_count() const noexcept { return corrupt_count_; }
+
+private:
+    static size_t body_length(const uint8_t* header) noexcept
+    {
+        return message_detail::load<uint16_t, ByteOrder::Little>(header);
+    }
+
+    static uint16_t type_of(const uint8_t* header) noexcept
+    {
+        return message_detail::load<uint16_t, ByteOrder::Little>(header + 2);
+    }
+
+    // Checks the trailer of a complete frame and records its latency; false when the CRC fails
+    bool accept_trailer(const uint8_t* frame, size_t body, uint64_t& now) noexcept
+    {
+        size_t covered = message_header_size + body + timestamp_size_;
+        if (checks_crc_ && !message_detail::crc_matches(frame, covered))
+        {
+            ++corrupt_count_;
+            return false;
+        }
+        if (timestamp_size_ != 0 && latency_ != nullptr)
+        {
+            if (now == 0)
+            {
+                now = timestamp_ns();
+            }
+            latency_->record_since(message_detail::load<uint64_t, ByteOrder::Little>(frame + covered - 8), now);
+        }
+        return true;
+    }
+
+    // Bytes still missing from the buffered message
+    size_t pending_wanted() const noexcept
+    {
+        if (pending_.size() < message_header_size)
+        {
+            return message_header_size - pending_.size();
+        }
+        return message_header_size + body_length(pending_.data()) + trailer_size_ - pending_.size();
+    }
+
+    size_t max_message_size_;
+    size_t trailer_size_;
+    size_t timestamp_size_;
+    bool checks_crc_;
+    LatencyHistogram* latency_ = nullptr;
+    uint64_t corrupt_count_ = 0;
+    std::vector<uint8_t> pending_;
+};
+
+// Routes framed messages to HandlerT::onMessage(MessageView<Schema>) through a table indexed by
+// type id, built at compile time; there is no search or chain of comparisons per message.
+// Usable directly as the MessageFramer callback. Optional handler members:
+//   void onUnknownMessage(uint16_t type, const uint8_t* body, size_t length);
+//   void onMalformedMessage(uint16_t type, const uint8_t* body, size_t length);  // body shorter than the schema
+// onMessage may return bool; false stops delivery. Bodies longer than the schema are accepted,
+// so fields can be appended to a message without breaking older readers.
+template<typename HandlerT, typename... Schemas>
+class MessageDispatcher
+{
+public:
+    static constexpr size_t table_size = (std::max)({size_t(Schemas::type_id)...}) + 1;
+    static_assert(table_size <= 4096, "type ids index a table; keep them small and dense");
+    static_assert([]() {
+        std::array<uint16_t, sizeof...(Schemas)> ids{Schemas::type_id...};
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            for (size_t j = i + 1; j < ids.size(); ++j)
+            {
+                if (ids[i] == ids[j])
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }(), "duplicate type id in MessageDispatcher");
+
+    explicit MessageDispatcher(HandlerT& handler) noexcept
+        : handler_(handler)
+    {
+    }
+
+    bool operator()(uint16_t type, const uint8_t* body, size_t length)
+    {
+        Entry entry = type < table_size ? table_[type] : nullptr;
+        if (entry)
+        {
+            return entry(*this, body, length);
+        }
+
+        ++unknown_count_;
+        if constexpr (requires { handler_.onUnknownMessage(type, body, length); })
+        {
+            handler_.onUnknownMessage(type, body, length);
+        }
+        return true;
+    }
+
+    uint64_t unknown_count() const noexcept { return unknown_count_; }
+    uint64_t malformed_count() const noexcept { return malformed_count_; }
+
+private:
+    using Entry = bool (*)(MessageDispatcher&, const uint8_t*, size_t);
+
+    template<typename SchemaT>
+    static bool invoke(MessageDispatcher& self, const uint8_t* body, size_t length)
+    {
+        if (length < SchemaT::size)
+        {
+            ++self.malformed_count_;
+            if constexpr (requires { self.handler_.onMalformedMessage(SchemaT::type_id, body, length); })
+            {
+                self.handler_.onMalformedMessage(SchemaT::type_id, body, length);
+            }
+            return true;
+        }
+
+        MessageView<SchemaT> view(body);
+        if constexpr (std::is_same_v<decltype(self.handler_.onMessage(view)), bool>)
+        {
+            return self.handler_.onMessage(view);
+        }
+        else
+        {
+            self.handler_.onMessage(view);
+            return true;
+        }
+    }
+
+    static constexpr std::array<Entry, table_size> make_table()
+    {
+        std::array<Entry, table_size> table{};
+        ((table[Schemas::type_id] = &invoke<Schemas>), ...);
+        return table;
+    }
+
+    static constexpr std::array<Entry, table_size> table_ = make_table();
+
+    HandlerT& handler_;
+    uint64_t unknown_count_ = 0;
+    uint64_t malformed_count_ = 0;
+};
+
+} // namespace slick::socket
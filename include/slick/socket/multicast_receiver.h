@@ -5,7 +5,19 @@
 #pragma once
 
 #include <slick/socket/logger.h>
+#include <slick/socket/buffer_pool.h>
+#include <slick/socket/cache_line.h>
+#include <slick/socket/clock.h>
+#include <slick/socket/endpoint.h>
+#include <slick/socket/latency.h>
+#include <slick/socket/socket_traits.h>
+#include <slick/socket/numa.h>
+#include <slick/socket/packet_header.h>
+#include <slick/socket/warmup.h>
+#include <slick/socket/trace.h>
+#include <slick/socket/watchdog.h>
 #include <vector>
+#include <cstring>
 #include <string>
 #include <chrono>
 #include <atomic>
@@ -14,6 +26,9 @@
 #if defined(_WIN32) || defined(_WIN64)
 #include <winsock2.h>
 #include <ws2tcpip.h>
+#else
+#include <slick/socket/event_notifier.h>
+#include <slick/socket/event_poller.h>
 #endif
 
 namespace slick::socket
@@ -21,15 +36,20 @@ namespace slick::socket
 
 struct MulticastReceiverConfig
 {
-    std::string multicast_address = "224.0.0.1"; // Multicast group to join
+    std::string multicast_address = "224.0.0.1"; // IPv4 or IPv6 (ff0x::) multicast group to join
     uint16_t port = 5000;
-    std::string interface_address = "0.0.0.0"; // Interface to receive on (0.0.0.0 = any)
+    std::string interface_address = "0.0.0.0"; // Interface to receive on (0.0.0.0 = any); IPv6: name or index
     bool reuse_address = true; // Allow multiple receivers on same port
-    int receive_buffer_size = 65536; // Socket receive buffer size
-    std::chrono::milliseconds receive_timeout{1000}; // Timeout for receive operations
+    int receive_buffer_size = 65536; // Socket and loop receive buffer size (loop buffer fixed by traits if set)
+    std::chrono::milliseconds receive_timeout{1000}; // Receive poll interval (Windows only, Unix wakes on stop())
+    int numa_node = -1;         // NUMA node for the receiver thread and its buffers, -1 = none
+    std::string numa_interface; // Detect numa_node from this NIC (name or local IPv4 address) when numa_node is -1
+    WarmupConfig warmup;        // Optional warm-up before start() returns; loopback_messages is not used
+    bool sequenced = false;     // Datagrams carry a PacketHeader (MulticastSenderConfig::sequenced), stripped before delivery
+    bool verify_checksum = true; // With sequenced: drop datagrams whose CRC32C does not match
 };
 
-template<typename DerivedT>
+template<typename DerivedT, typename TraitsT = DefaultSocketTraits>
 class MulticastReceiverBase
 {
 public:
@@ -53,7 +73,7 @@ public:
         return running_.load(std::memory_order_relaxed);
     }
 
-    // Statistics
+    // Statistics, always 0 when TraitsT::enable_stats is false
     uint64_t get_packets_received() const noexcept
     {
         return packets_received_.load(std::memory_order_relaxed);
@@ -69,14 +89,225 @@ public:
         return receive_errors_.load(std::memory_order_relaxed);
     }
 
+    // Integrity (sequenced groups only), counted even when TraitsT::enable_stats is false.
+    // Gaps assume a single sender per group.
+    uint64_t get_corrupt_packets() const noexcept
+    {
+        return corrupt_packets_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t get_sequence_gaps() const noexcept
+    {
+        return sequence_gaps_.load(std::memory_order_relaxed);
+    }
+
+    // One-way latency of datagrams stamped by the sender (MulticastSenderConfig::timestamp),
+    // measured before the handler runs
+    const LatencyHistogram& get_latency_histogram() const noexcept
+    {
+        return latency_;
+    }
+
+    // Phase timings of the last start()
+    const StartupReport& get_startup_report() const noexcept
+    {
+        return startup_report_;
+    }
+
+    // What the receiver thread is running and how long its handler takes (TraitsT::enable_loop_monitor)
+    const LoopMonitor& get_loop_monitor() const noexcept
+        requires TraitsT::enable_loop_monitor
+    {
+        return loop_monitor_;
+    }
+
 protected:
     DerivedT& derived() { return static_cast<DerivedT&>(*this); }
     const DerivedT& derived() const { return static_cast<const DerivedT&>(*this); }
 
     // Virtual methods to be implemented by derived class
     void receiver_loop();
+
+    // Time the current batch of events was returned by the wait (loop thread, TraitsT::enable_timestamps)
+    std::chrono::steady_clock::time_point last_receive_time() const noexcept
+        requires TraitsT::enable_timestamps
+    {
+        return receive_time_;
+    }
+
+    void stamp_receive_time() noexcept
+    {
+        if constexpr (TraitsT::enable_timestamps)
+        {
+            receive_time_ = TscClock::now();
+        }
+    }
+
+    // Times a user callback for the loop monitor and the trace until the result goes out of scope
+    CallbackScope<TraitsT> callback_scope(LoopCallback callback, int client_id) noexcept
+    {
+        return {loop_monitor_.callback_scope(callback, client_id),
+                TraceSpanFor<TraitsT>(TraceKind::Callback, client_id, callback)};
+    }
+
+    void count_packet(size_t bytes) noexcept
+    {
+        if constexpr (TraitsT::enable_stats)
+        {
+            packets_received_.fetch_add(1, std::memory_order_relaxed);
+            bytes_received_.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    void count_receive_error() noexcept
+    {
+        if constexpr (TraitsT::enable_stats)
+        {
+            receive_errors_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Receiver thread, before the first wait
+    void signal_loop_ready(uint8_t* buffer, size_t size, int numa_node)
+    {
+        if (config_.warmup.enabled)
+        {
+            std::memset(buffer, 0, size);
+            startup_report_.bytes_prefaulted = BufferPool::instance().arena_size(numa_node) + size;
+        }
+        have_sequence_ = false;
+        if constexpr (TraitsT::enable_tracing)
+        {
+            Tracer::attach_thread(name_);
+        }
+        loop_ready_.store(true, std::memory_order_release);
+        loop_ready_.notify_all();
+    }
+
+    // Caller of start(), once the receiver thread is launched
+    void complete_startup(std::chrono::steady_clock::time_point started_at)
+    {
+        if (config_.warmup.enabled)
+        {
+            auto phase = std::chrono::steady_clock::now();
+            loop_ready_.wait(false, std::memory_order_acquire);
+            startup_report_.loop_ready = elapsed_since(phase);
+
+            if (config_.warmup.lock_memory)
+            {
+                phase = std::chrono::steady_clock::now();
+                startup_report_.bytes_locked = BufferPool::instance().lock_memory();
+                if (startup_report_.bytes_locked == 0)
+                {
+                    LOG_WARN("{} failed to lock buffer memory", name_);
+                }
+                startup_report_.memory_lock = elapsed_since(phase);
+            }
+        }
+        startup_report_.total = elapsed_since(started_at);
+    }
     void handle_multicast_data(const std::vector<uint8_t>& data, const std::string& sender_address);
 
+    // Derived handler forms, most preferred first:
+    //   handle_multicast_data(const uint8_t* data, size_t length, const Endpoint& sender)
+    //   handle_multicast_data(const uint8_t* data, size_t length, const std::string& sender_address)
+    //   handle_multicast_data(const std::vector<uint8_t>& data, const std::string& sender_address)
+    // Optional, for sequenced groups:
+    //   void onCorruptPacket(const uint8_t* data, size_t length, const Endpoint& sender);  // dropped
+    //   void onSequenceGap(uint64_t expected, uint64_t received);  // datagrams lost before received
+    // The raw forms receive into the loop buffer and pass it without a copy. The Endpoint form also
+    // skips formatting the sender address, for IPv4 and IPv6 alike.
+    static constexpr bool has_endpoint_handler()
+    {
+        return requires(DerivedT& d, const uint8_t* data, size_t length, const Endpoint& sender) {
+            d.handle_multicast_data(data, length, sender);
+        };
+    }
+
+    static constexpr bool has_raw_data_handler()
+    {
+        return has_endpoint_handler() ||
+               requires(DerivedT& d, const uint8_t* data, size_t length, const std::string& sender) {
+                   d.handle_multicast_data(data, length, sender);
+               };
+    }
+
+    // Delivers one datagram to the derived handler; the sender is formatted only for string handlers
+    void dispatch_datagram(uint8_t* data, size_t length, std::vector<uint8_t>& buffer, const Endpoint& sender)
+    {
+        if constexpr (TraitsT::enable_logging)
+        {
+            LOG_TRACE("Received {} bytes from {}", length, sender.to_string());
+        }
+
+        if (config_.sequenced && !strip_packet_header(data, length, sender))
+        {
+            return;
+        }
+
+        auto timing = callback_scope(LoopCallback::Data, -1);
+        if constexpr (has_endpoint_handler())
+        {
+            derived().handle_multicast_data(data, length, sender);
+        }
+        else if constexpr (has_raw_data_handler())
+        {
+            derived().handle_multicast_data(data, length, sender.address_string());
+        }
+        else
+        {
+            // Resize buffer to actual data size and call handler
+            size_t capacity = buffer.size();
+            buffer.resize(length);
+            derived().handle_multicast_data(buffer, sender.address_string());
+            buffer.resize(capacity); // Reset buffer size
+        }
+    }
+
+    // Checks and removes the PacketHeader; false when the datagram is dropped
+    bool strip_packet_header(uint8_t*& data, size_t& length, const Endpoint& sender)
+    {
+        PacketHeader header;
+        if (!read_packet_header(data, length, header) ||
+            (config_.verify_checksum && !verify_packet(data, length, header)))
+        {
+            corrupt_packets_.fetch_add(1, std::memory_order_relaxed);
+            if constexpr (TraitsT::enable_logging)
+            {
+                LOG_WARN("{} dropped a corrupt datagram of {} bytes from {}", name_, length, sender.to_string());
+            }
+            if constexpr (requires { derived().onCorruptPacket(data, length, sender); })
+            {
+                derived().onCorruptPacket(data, length, sender);
+            }
+            return false;
+        }
+
+        if (header.flags & packet_flag_timestamp)
+        {
+            latency_.record_since(header.send_time, timestamp_ns());
+        }
+
+        // Late or duplicate datagrams are delivered but do not move the expected sequence back
+        if (have_sequence_ && header.sequence > next_sequence_)
+        {
+            sequence_gaps_.fetch_add(header.sequence - next_sequence_, std::memory_order_relaxed);
+            if constexpr (requires { derived().onSequenceGap(next_sequence_, header.sequence); })
+            {
+                derived().onSequenceGap(next_sequence_, header.sequence);
+            }
+        }
+        if (!have_sequence_ || header.sequence >= next_sequence_)
+        {
+            next_sequence_ = header.sequence + 1;
+            have_sequence_ = true;
+        }
+
+        data += header.size();
+        length -= header.size();
+        return true;
+    }
+
 #if defined(_WIN32) || defined(_WIN64)
     using SocketT = SOCKET;
     static constexpr SocketT invalid_socket = INVALID_SOCKET;
@@ -85,17 +316,41 @@ protected:
     static constexpr SocketT invalid_socket = -1;
 #endif
 
+    // Grouped by writer, one cache line apart, as in TCPServerBase
+
+    // Cold: set up before the loop starts
     std::string name_;
     MulticastReceiverConfig config_;
-    std::atomic_bool running_{false};
-
-    SocketT socket_ = invalid_socket;
     std::thread receiver_thread_;
-    
-    // Statistics
-    std::atomic<uint64_t> packets_received_{0};
+    StartupReport startup_report_;
+    Endpoint group_;    // parsed multicast_address
+
+    // Polled by the loop and by monitoring threads
+    alignas(cache_line_size) std::atomic_bool running_{false};
+    std::atomic_bool loop_ready_{false};
+
+    // Statistics: written per datagram by the receiver thread, read by monitoring threads
+    alignas(cache_line_size) std::atomic<uint64_t> packets_received_{0};
     std::atomic<uint64_t> bytes_received_{0};
     std::atomic<uint64_t> receive_errors_{0};
+    std::atomic<uint64_t> corrupt_packets_{0};
+    std::atomic<uint64_t> sequence_gaps_{0};
+
+    // Written by the receiver thread, read by monitoring threads
+    alignas(cache_line_size) LatencyHistogram latency_;
+
+    // Receiver thread, read by a Watchdog; empty without TraitsT::enable_loop_monitor
+    LoopMonitorFor<TraitsT> loop_monitor_;
+
+    // Receiver thread only
+    alignas(cache_line_size) SocketT socket_ = invalid_socket;
+    std::chrono::steady_clock::time_point receive_time_{};   // written only with TraitsT::enable_timestamps
+    uint64_t next_sequence_ = 0;    // expected on a sequenced group
+    bool have_sequence_ = false;
+#if !defined(_WIN32) && !defined(_WIN64)
+    EventPoller poller_;
+    EventNotifier wakeup_;  // wakes receiver_loop() for stop()
+#endif
 
 private:
     bool initialize_socket();
@@ -12,15 +12,15 @@
 namespace slick::socket
 {
 
-template<typename DerivedT>
-MulticastReceiverBase<DerivedT>::MulticastReceiverBase(std::string name, const MulticastReceiverConfig& config)
+template<typename DerivedT, typename TraitsT>
+MulticastReceiverBase<DerivedT, TraitsT>::MulticastReceiverBase(std::string name, const MulticastReceiverConfig& config)
     : name_(std::move(name)), config_(config)
 {
     LOG_DEBUG("MulticastReceiver {} created for group {}:{}", name_, config_.multicast_address, config_.port);
 }
 
-template<typename DerivedT>
-MulticastReceiverBase<DerivedT>::~MulticastReceiverBase()
+template<typename DerivedT, typename TraitsT>
+MulticastReceiverBase<DerivedT, TraitsT>::~MulticastReceiverBase()
 {
     if (running_.load(std::memory_order_relaxed))
     {
@@ -28,8 +28,8 @@ MulticastReceiverBase<DerivedT>::~MulticastReceiverBase()
     }
 }
 
-template<typename DerivedT>
-bool MulticastReceiverBase<DerivedT>::start()
+template<typename DerivedT, typename TraitsT>
+bool MulticastReceiverBase<DerivedT, TraitsT>::start()
 {
     if (running_.load(std::memory_order_relaxed))
     {
@@ -37,6 +37,9 @@ bool MulticastReceiverBase<DerivedT>::start()
         return true;
     }
 
+    auto started_at = std::chrono::steady_clock::now();
+    startup_report_ = StartupReport{};
+
     LOG_INFO("Starting {} for group {}:{}...", name_, config_.multicast_address, config_.port);
 
     // Initialize Winsock if not already done
@@ -68,17 +71,20 @@ bool MulticastReceiverBase<DerivedT>::start()
         return false;
     }
 
+    startup_report_.socket_setup = elapsed_since(started_at);
+    loop_ready_.store(false, std::memory_order_relaxed);
     running_.store(true, std::memory_order_relaxed);
 
     // Start receiver thread
     receiver_thread_ = std::thread(&MulticastReceiverBase::receiver_loop, this);
+    complete_startup(started_at);
 
-    LOG_INFO("{} started successfully", name_);
+    LOG_INFO("{} started successfully in {} us", name_, startup_report_.total.count());
     return true;
 }
 
-template<typename DerivedT>
-void MulticastReceiverBase<DerivedT>::stop()
+template<typename DerivedT, typename TraitsT>
+void MulticastReceiverBase<DerivedT, TraitsT>::stop()
 {
     if (!running_.load(std::memory_order_relaxed))
     {
@@ -101,12 +107,43 @@ void MulticastReceiverBase<DerivedT>::stop()
     LOG_INFO("{} stopped", name_);
 }
 
-template<typename DerivedT>
-void MulticastReceiverBase<DerivedT>::receiver_loop()
+template<typename DerivedT, typename TraitsT>
+void MulticastReceiverBase<DerivedT, TraitsT>::receiver_loop()
 {
-    std::vector<uint8_t> buffer(config_.receive_buffer_size);
-    sockaddr_in sender_addr{};
+    // Keep the loop thread, its buffers and its connection state on one NUMA node
+    int numa_node = resolve_numa_node(config_.numa_node, config_.numa_interface);
+    if (numa_node >= 0)
+    {
+        if (!pin_thread_to_numa_node(numa_node))
+        {
+            LOG_WARN("Failed to pin receiver thread to NUMA node {}", numa_node);
+        }
+        if (!prefer_numa_node_for_thread(numa_node))
+        {
+            LOG_WARN("Failed to set memory policy for NUMA node {}", numa_node);
+        }
+        BufferPool::instance().set_thread_node(numa_node);
+        LOG_INFO("Receiver thread placed on NUMA node {}", numa_node);
+    }
+    else if (!config_.numa_interface.empty())
+    {
+        LOG_WARN("NUMA node of {} unknown, receiver thread left unplaced", config_.numa_interface);
+    }
+
+    // Raw handlers read straight from the loop's receive buffer; the vector handler keeps its own buffer
+    const size_t receive_size = TraitsT::receive_buffer_size > 0 ? TraitsT::receive_buffer_size
+                                                                 : static_cast<size_t>(config_.receive_buffer_size);
+    auto raw_buffer = make_receive_buffer<TraitsT>(has_raw_data_handler() ? receive_size : 0);
+    std::vector<uint8_t> buffer;
+    if constexpr (!has_raw_data_handler())
+    {
+        buffer.resize(receive_size);
+    }
+    uint8_t* receive_data = has_raw_data_handler() ? raw_buffer.data() : buffer.data();
+    signal_loop_ready(receive_data, receive_size, numa_node);
+    sockaddr_storage sender_addr{};
     int sender_addr_len = sizeof(sender_addr);
+    Endpoint sender;
 
     LOG_DEBUG("Receiver loop started for {}", name_);
 
@@ -120,12 +157,15 @@ void MulticastReceiverBase<DerivedT>::receiver_loop()
             LOG_WARN("Failed to set receive timeout");
         }
 
+        sender_addr_len = sizeof(sender_addr);
+        loop_monitor_.loop_idle();
         int bytes_received = recvfrom(socket_, 
-                                     reinterpret_cast<char*>(buffer.data()), 
-                                     static_cast<int>(buffer.size()),
+                                     reinterpret_cast<char*>(receive_data),
+                                     static_cast<int>(receive_size),
                                      0,
                                      reinterpret_cast<sockaddr*>(&sender_addr),
                                      &sender_addr_len);
+        loop_monitor_.loop_busy();
 
         if (bytes_received == SOCKET_ERROR)
         {
@@ -138,45 +178,43 @@ void MulticastReceiverBase<DerivedT>::receiver_loop()
             else if (running_.load(std::memory_order_relaxed))
             {
                 LOG_ERROR("Failed to receive multicast data. error={}", error);
-                receive_errors_.fetch_add(1, std::memory_order_relaxed);
+                count_receive_error();
             }
             continue;
         }
 
         if (bytes_received > 0)
         {
-            packets_received_.fetch_add(1, std::memory_order_relaxed);
-            bytes_received_.fetch_add(static_cast<uint64_t>(bytes_received), std::memory_order_relaxed);
-
-            // Get sender address as string
-            char sender_ip[INET_ADDRSTRLEN];
-            inet_ntop(AF_INET, &sender_addr.sin_addr, sender_ip, INET_ADDRSTRLEN);
-            std::string sender_address = sender_ip;
-
-            LOG_TRACE("Received {} bytes from {}", bytes_received, sender_address);
+            stamp_receive_time();
+            count_packet(static_cast<size_t>(bytes_received));
 
-            // Resize buffer to actual data size and call handler
-            buffer.resize(static_cast<size_t>(bytes_received));
-            derived().handle_multicast_data(buffer, sender_address);
-            buffer.resize(config_.receive_buffer_size); // Reset buffer size
+            sender.from_sockaddr(reinterpret_cast<const sockaddr*>(&sender_addr));
+            dispatch_datagram(receive_data, static_cast<size_t>(bytes_received), buffer, sender);
         }
     }
+    loop_monitor_.loop_idle();
 
     LOG_DEBUG("Receiver loop ended for {}", name_);
 }
 
-template<typename DerivedT>
-void MulticastReceiverBase<DerivedT>::handle_multicast_data(const std::vector<uint8_t>& data, const std::string& sender_address)
+template<typename DerivedT, typename TraitsT>
+void MulticastReceiverBase<DerivedT, TraitsT>::handle_multicast_data(const std::vector<uint8_t>& data, const std::string& sender_address)
 {
     // Default implementation - derived classes should override this
     LOG_TRACE("Received {} bytes from {} (no handler implemented)", data.size(), sender_address);
 }
 
-template<typename DerivedT>
-bool MulticastReceiverBase<DerivedT>::initialize_socket()
+template<typename DerivedT, typename TraitsT>
+bool MulticastReceiverBase<DerivedT, TraitsT>::initialize_socket()
 {
+    if (!Endpoint::parse(config_.multicast_address, config_.port, group_) || !group_.is_multicast())
+    {
+        LOG_ERROR("Invalid multicast address: {}", config_.multicast_address);
+        return false;
+    }
+
     // Create UDP socket
-    socket_ = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    socket_ = ::socket(group_.socket_family(), SOCK_DGRAM, IPPROTO_UDP);
     if (socket_ == invalid_socket)
     {
         int error = WSAGetLastError();
@@ -196,8 +234,8 @@ bool MulticastReceiverBase<DerivedT>::initialize_socket()
     return true;
 }
 
-template<typename DerivedT>
-void MulticastReceiverBase<DerivedT>::cleanup_socket()
+template<typename DerivedT, typename TraitsT>
+void MulticastReceiverBase<DerivedT, TraitsT>::cleanup_socket()
 {
     if (socket_ != invalid_socket)
     {
@@ -206,8 +244,8 @@ void MulticastReceiverBase<DerivedT>::cleanup_socket()
     }
 }
 
-template<typename DerivedT>
-bool MulticastReceiverBase<DerivedT>::setup_multicast_options()
+template<typename DerivedT, typename TraitsT>
+bool MulticastReceiverBase<DerivedT, TraitsT>::setup_multicast_options()
 {
     // Enable address reuse
     if (config_.reuse_address)
@@ -221,13 +259,13 @@ bool MulticastReceiverBase<DerivedT>::setup_multicast_options()
         }
     }
 
-    // Bind to the multicast port
-    sockaddr_in bind_addr{};
-    bind_addr.sin_family = AF_INET;
-    bind_addr.sin_port = htons(config_.port);
-    bind_addr.sin_addr.s_addr = INADDR_ANY; // Bind to any interface
+    // Bind to the multicast port on any interface
+    Endpoint any;
+    Endpoint::parse(group_.is_v6() ? "::" : "0.0.0.0", config_.port, any);
+    sockaddr_storage bind_addr{};
+    int bind_len = any.to_sockaddr(bind_addr);
 
-    if (bind(socket_, reinterpret_cast<const sockaddr*>(&bind_addr), sizeof(bind_addr)) == SOCKET_ERROR)
+    if (bind(socket_, reinterpret_cast<const sockaddr*>(&bind_addr), bind_len) == SOCKET_ERROR)
     {
         int error = WSAGetLastError();
         LOG_ERROR("Failed to bind socket to port {}. error={}", config_.port, error);
@@ -237,19 +275,29 @@ bool MulticastReceiverBase<DerivedT>::setup_multicast_options()
     return true;
 }
 
-template<typename DerivedT>
-bool MulticastReceiverBase<DerivedT>::join_multicast_group()
+template<typename DerivedT, typename TraitsT>
+bool MulticastReceiverBase<DerivedT, TraitsT>::join_multicast_group()
 {
-    ip_mreq mreq{};
-    
-    // Set multicast group address
-    int result = inet_pton(AF_INET, config_.multicast_address.c_str(), &mreq.imr_multiaddr);
-    if (result != 1)
+    if (group_.is_v6())
     {
-        LOG_ERROR("Invalid multicast address: {}", config_.multicast_address);
-        return false;
+        // Only numeric interface indexes are understood here
+        ipv6_mreq mreq6{};
+        std::memcpy(&mreq6.ipv6mr_multiaddr, group_.address.data(), sizeof(mreq6.ipv6mr_multiaddr));
+        mreq6.ipv6mr_interface = interface_index(config_.interface_address);
+        if (setsockopt(socket_, IPPROTO_IPV6, IPV6_JOIN_GROUP,
+                       reinterpret_cast<const char*>(&mreq6), sizeof(mreq6)) == SOCKET_ERROR)
+        {
+            int error = WSAGetLastError();
+            LOG_ERROR("Failed to join multicast group {}. error={}", config_.multicast_address, error);
+            return false;
+        }
+        LOG_DEBUG("Joined multicast group {}", config_.multicast_address);
+        return true;
     }
 
+    ip_mreq mreq{};
+    std::memcpy(&mreq.imr_multiaddr, group_.address.data(), sizeof(mreq.imr_multiaddr));
+
     // Set interface address
     if (config_.interface_address == "0.0.0.0")
     {
@@ -257,7 +305,7 @@ bool MulticastReceiverBase<DerivedT>::join_multicast_group()
     }
     else
     {
-        result = inet_pton(AF_INET, config_.interface_address.c_str(), &mreq.imr_interface);
+        int result = inet_pton(AF_INET, config_.interface_address.c_str(), &mreq.imr_interface);
         if (result != 1)
         {
             LOG_WARN("Invalid interface address: {}, using any interface", config_.interface_address);
@@ -278,31 +326,19 @@ bool MulticastReceiverBase<DerivedT>::join_multicast_group()
     return true;
 }
 
-template<typename DerivedT>
-void MulticastReceiverBase<DerivedT>::leave_multicast_group()
+template<typename DerivedT, typename TraitsT>
+void MulticastReceiverBase<DerivedT, TraitsT>::leave_multicast_group()
 {
     if (socket_ == invalid_socket)
         return;
 
-    ip_mreq mreq{};
-    
-    // Set multicast group address
-    int result = inet_pton(AF_INET, config_.multicast_address.c_str(), &mreq.imr_multiaddr);
-    if (result == 1)
+    if (group_.is_v6())
     {
-        // Set interface address
-        if (config_.interface_address == "0.0.0.0")
-        {
-            mreq.imr_interface.s_addr = INADDR_ANY;
-        }
-        else
-        {
-            inet_pton(AF_INET, config_.interface_address.c_str(), &mreq.imr_interface);
-        }
-
-        // Leave multicast group
-        if (setsockopt(socket_, IPPROTO_IP, IP_DROP_MEMBERSHIP,
-                       reinterpret_cast<const char*>(&mreq), sizeof(mreq)) == SOCKET_ERROR)
+        ipv6_mreq mreq6{};
+        std::memcpy(&mreq6.ipv6mr_multiaddr, group_.address.data(), sizeof(mreq6.ipv6mr_multiaddr));
+        mreq6.ipv6mr_interface = interface_index(config_.interface_address);
+        if (setsockopt(socket_, IPPROTO_IPV6, IPV6_LEAVE_GROUP,
+                       reinterpret_cast<const char*>(&mreq6), sizeof(mreq6)) == SOCKET_ERROR)
         {
             int error = WSAGetLastError();
             LOG_WARN("Failed to leave multicast group {}. error={}", config_.multicast_address, error);
@@ -311,6 +347,32 @@ void MulticastReceiverBase<DerivedT>::leave_multicast_group()
         {
             LOG_DEBUG("Left multicast group {}", config_.multicast_address);
         }
+        return;
+    }
+
+    ip_mreq mreq{};
+    std::memcpy(&mreq.imr_multiaddr, group_.address.data(), sizeof(mreq.imr_multiaddr));
+
+    // Set interface address
+    if (config_.interface_address == "0.0.0.0")
+    {
+        mreq.imr_interface.s_addr = INADDR_ANY;
+    }
+    else
+    {
+        inet_pton(AF_INET, config_.interface_address.c_str(), &mreq.imr_interface);
+    }
+
+    // Leave multicast group
+    if (setsockopt(socket_, IPPROTO_IP, IP_DROP_MEMBERSHIP,
+                   reinterpret_cast<const char*>(&mreq), sizeof(mreq)) == SOCKET_ERROR)
+    {
+        int error = WSAGetLastError();
+        LOG_WARN("Failed to leave multicast group {}. error={}", config_.multicast_address, error);
+    }
+    else
+    {
+        LOG_DEBUG("Left multicast group {}", config_.multicast_address);
     }
 }
 
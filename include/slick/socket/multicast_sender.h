@@ -5,6 +5,11 @@
 #pragma once
 
 #include "logger.h"
+#include <slick/socket/cache_line.h>
+#include <slick/socket/clock.h>
+#include <slick/socket/endpoint.h>
+#include <slick/socket/packet_header.h>
+#include <slick/socket/pacing.h>
 #include <vector>
 #include <string>
 #include <chrono>
@@ -20,12 +25,16 @@ namespace slick::socket
 
 struct MulticastSenderConfig
 {
-    std::string multicast_address = "224.0.0.1"; // Default multicast address
+    std::string multicast_address = "224.0.0.1"; // IPv4 or IPv6 (ff0x::) group address
     uint16_t port = 5000;
-    std::string interface_address = "0.0.0.0"; // Interface to send from (0.0.0.0 = any)
-    int ttl = 1; // Time-to-live for multicast packets
+    std::string interface_address = "0.0.0.0"; // Interface to send from (0.0.0.0 = any); IPv6: name or index
+    int ttl = 1; // Time-to-live (IPv6 hop limit) for multicast packets
     bool enable_loopback = false; // Enable loopback of multicast packets
     int send_buffer_size = 65536; // Socket send buffer size
+    bool sequenced = false; // Prepend a PacketHeader (sequence number) to every datagram
+    bool checksum = false;  // With sequenced: fill in the header's CRC32C over the payload
+    bool timestamp = false; // With sequenced: stamp the send time, for receivers' latency histograms
+    PacingConfig pacing;    // Spread bursts out to a rate, see PacingMode
 };
 
 class MulticastSender
@@ -75,7 +84,67 @@ public:
         return send_errors_.load(std::memory_order_relaxed);
     }
 
+    // Sequence number the next sequenced datagram will carry
+    uint64_t get_next_sequence() const noexcept
+    {
+        return next_sequence_.load(std::memory_order_relaxed);
+    }
+
+    // Pacing in effect after start(): Kernel and TxTime fall back to TokenBucket where unsupported
+    PacingMode get_pacing_mode() const noexcept
+    {
+        return pacing_mode_;
+    }
+
+    // Queuing delay added by TokenBucket/TxTime pacing: datagrams held back, and their total and
+    // largest delay. Kernel pacing happens in the qdisc and is not counted here.
+    uint64_t get_paced_packets() const noexcept
+    {
+        return paced_packets_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t get_pacing_delay_ns() const noexcept
+    {
+        return pacing_delay_ns_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t get_max_pacing_delay_ns() const noexcept
+    {
+        return max_pacing_delay_ns_.load(std::memory_order_relaxed);
+    }
+
 protected:
+    // Schedules a datagram of bytes: TokenBucket waits until its departure time, TxTime returns it
+    // for SO_TXTIME. 0 when the datagram leaves now without a departure time.
+    int64_t pace(size_t bytes) noexcept
+    {
+        if (pacing_mode_ != PacingMode::TokenBucket && pacing_mode_ != PacingMode::TxTime)
+        {
+            return 0;
+        }
+        const int64_t now = TscClock::now_ns();
+        const int64_t departure = pacing_.schedule(bytes, now);
+        const uint64_t delay = static_cast<uint64_t>(departure - now);
+        if (delay > 0)
+        {
+            paced_packets_.fetch_add(1, std::memory_order_relaxed);
+            pacing_delay_ns_.fetch_add(delay, std::memory_order_relaxed);
+            uint64_t longest = max_pacing_delay_ns_.load(std::memory_order_relaxed);
+            while (delay > longest &&
+                   !max_pacing_delay_ns_.compare_exchange_weak(longest, delay, std::memory_order_relaxed))
+            {
+            }
+        }
+        if (pacing_mode_ == PacingMode::TxTime)
+        {
+            return departure;
+        }
+        if (delay > 0)
+        {
+            wait_until_ns(departure);
+        }
+        return 0;
+    }
 
 #if defined(_WIN32) || defined(_WIN64)
     using SocketT = SOCKET;
@@ -85,21 +154,39 @@ protected:
     static constexpr SocketT invalid_socket = -1;
 #endif
 
+    // Cold: set up by start() and read-only afterwards
     std::string name_;
     MulticastSenderConfig config_;
-    std::atomic_bool running_{false};
+    PacingMode pacing_mode_ = PacingMode::None;
 
+    // Read on every send_data(), written only by start()/stop()
+    alignas(cache_line_size) std::atomic_bool running_{false};
     SocketT socket_ = invalid_socket;
-    
-    // Statistics
-    std::atomic<uint64_t> packets_sent_{0};
+    sockaddr_storage destination_{};    // group address, resolved once by start()
+    socklen_t destination_len_ = 0;     // 0 when multicast_address is invalid
+
+    // Statistics: written by the sending threads, read by monitoring threads
+    alignas(cache_line_size) std::atomic<uint64_t> packets_sent_{0};
     std::atomic<uint64_t> bytes_sent_{0};
     std::atomic<uint64_t> send_errors_{0};
+    std::atomic<uint64_t> next_sequence_{0};
+    std::atomic<uint64_t> paced_packets_{0};
+    std::atomic<uint64_t> pacing_delay_ns_{0};
+    std::atomic<uint64_t> max_pacing_delay_ns_{0};
+
+    // Token bucket shared by the sending threads
+    alignas(cache_line_size) PacingSchedule pacing_;
 
 private:
+    // Sends header (may be empty) and payload as one datagram, with an SO_TXTIME departure time
+    // (steady_clock ns) unless departure_ns is 0; returns bytes sent or -1
+    int64_t send_datagram(const uint8_t* header, size_t header_length, const uint8_t* payload, size_t length,
+                          int64_t departure_ns);
+    void setup_pacing();
     bool initialize_socket();
     void cleanup_socket();
     bool setup_multicast_options();
+    bool setup_ipv6_multicast_options();
 };
 
 } // namespace slick::socket
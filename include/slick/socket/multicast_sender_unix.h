@@ -6,22 +6,28 @@
 
 #include "multicast_sender.h"
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <errno.h>
+#include <time.h>
 #include <cstring>
 
+#if defined(__linux__)
+#include <linux/net_tstamp.h>
+#endif
+
 namespace slick::socket
 {
 
-MulticastSender::MulticastSender(std::string name, const MulticastSenderConfig& config)
+inline MulticastSender::MulticastSender(std::string name, const MulticastSenderConfig& config)
     : name_(std::move(name)), config_(config)
 {
     LOG_DEBUG("MulticastSender {} created with address {}:{}", name_, config_.multicast_address, config_.port);
 }
 
-MulticastSender::~MulticastSender()
+inline MulticastSender::~MulticastSender()
 {
     if (running_.load(std::memory_order_relaxed))
     {
@@ -29,7 +35,7 @@ MulticastSender::~MulticastSender()
     }
 }
 
-bool MulticastSender::start()
+inline bool MulticastSender::start()
 {
     if (running_.load(std::memory_order_relaxed))
     {
@@ -39,6 +45,18 @@ bool MulticastSender::start()
 
     LOG_INFO("Starting {} on {}:{}...", name_, config_.multicast_address, config_.port);
 
+    // Resolved once; an invalid group is reported by send_data() as a send error
+    Endpoint group;
+    destination_len_ = 0;
+    if (Endpoint::parse(config_.multicast_address, config_.port, group))
+    {
+        destination_len_ = group.to_sockaddr(destination_);
+    }
+    else
+    {
+        LOG_ERROR("Invalid multicast address: {}", config_.multicast_address);
+    }
+
     if (!initialize_socket())
     {
         return false;
@@ -49,13 +67,14 @@ bool MulticastSender::start()
         cleanup_socket();
         return false;
     }
+    setup_pacing();
 
     running_.store(true, std::memory_order_relaxed);
     LOG_INFO("{} started successfully", name_);
     return true;
 }
 
-void MulticastSender::stop()
+inline void MulticastSender::stop()
 {
     if (!running_.load(std::memory_order_relaxed))
     {
@@ -70,7 +89,7 @@ void MulticastSender::stop()
     LOG_INFO("{} stopped", name_);
 }
 
-bool MulticastSender::send_data(const std::vector<uint8_t>& data)
+inline bool MulticastSender::send_data(const std::vector<uint8_t>& data)
 {
     if (!running_.load(std::memory_order_relaxed))
     {
@@ -84,26 +103,38 @@ bool MulticastSender::send_data(const std::vector<uint8_t>& data)
         return false;
     }
 
-    // Create destination address
-    sockaddr_in dest_addr{};
-    dest_addr.sin_family = AF_INET;
-    dest_addr.sin_port = htons(config_.port);
-    
-    int result = inet_pton(AF_INET, config_.multicast_address.c_str(), &dest_addr.sin_addr);
-    if (result != 1)
+    if (destination_len_ == 0)
     {
         LOG_ERROR("Invalid multicast address: {}", config_.multicast_address);
         send_errors_.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
 
-    // Send the data
-    ssize_t bytes_sent = sendto(socket_, 
-                               data.data(), 
-                               data.size(),
-                               0,
-                               reinterpret_cast<const sockaddr*>(&dest_addr),
-                               sizeof(dest_addr));
+    // Paced before the header is written, so a timestamp reflects the actual departure: taken after
+    // the TokenBucket wait, or the scheduled departure itself under TxTime, where the qdisc holds
+    // the datagram after send_data() returns
+    size_t datagram_size = data.size();
+    if (config_.sequenced)
+    {
+        datagram_size += packet_header_size + (config_.timestamp ? packet_timestamp_size : 0);
+    }
+    int64_t departure_ns = pace(datagram_size);
+
+    // Send the data, behind a sequence header when configured (gathered, not copied)
+    uint8_t header[packet_header_max_size];
+    size_t header_length = 0;
+    if (config_.sequenced)
+    {
+        uint16_t flags = (config_.checksum ? packet_flag_checksum : 0) | (config_.timestamp ? packet_flag_timestamp : 0);
+        uint64_t sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+        uint64_t send_time = 0;
+        if (departure_ns != 0 && config_.timestamp)
+        {
+            send_time = static_cast<uint64_t>(departure_ns + (TscClock::realtime_ns() - TscClock::now_ns()));
+        }
+        header_length = write_packet_header(header, sequence, flags, data.data(), data.size(), send_time);
+    }
+    int64_t bytes_sent = send_datagram(header, header_length, data.data(), data.size(), departure_ns);
 
     if (bytes_sent < 0)
     {
@@ -113,9 +144,9 @@ bool MulticastSender::send_data(const std::vector<uint8_t>& data)
         return false;
     }
 
-    if (static_cast<size_t>(bytes_sent) != data.size())
+    if (static_cast<size_t>(bytes_sent) != header_length + data.size())
     {
-        LOG_WARN("Partial send: {} bytes sent out of {}", bytes_sent, data.size());
+        LOG_WARN("Partial send: {} bytes sent out of {}", bytes_sent, header_length + data.size());
     }
 
     packets_sent_.fetch_add(1, std::memory_order_relaxed);
@@ -125,10 +156,99 @@ bool MulticastSender::send_data(const std::vector<uint8_t>& data)
     return true;
 }
 
-bool MulticastSender::initialize_socket()
+inline int64_t MulticastSender::send_datagram(const uint8_t* header, size_t header_length, const uint8_t* payload,
+                                              size_t length, int64_t departure_ns)
+{
+    if (header_length == 0 && departure_ns == 0)
+    {
+        return sendto(socket_, payload, length, 0, reinterpret_cast<const sockaddr*>(&destination_), destination_len_);
+    }
+
+    iovec parts[2];
+    size_t count = 0;
+    if (header_length != 0)
+    {
+        parts[count].iov_base = const_cast<uint8_t*>(header);
+        parts[count].iov_len = header_length;
+        ++count;
+    }
+    parts[count].iov_base = const_cast<uint8_t*>(payload);
+    parts[count].iov_len = length;
+    ++count;
+    msghdr message{};
+    message.msg_name = &destination_;
+    message.msg_namelen = destination_len_;
+    message.msg_iov = parts;
+    message.msg_iovlen = count;
+
+#if defined(SO_TXTIME)
+    // Departure time for the fq qdisc, on the CLOCK_MONOTONIC timeline steady_clock uses
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint64_t))];
+    if (departure_ns != 0)
+    {
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        cmsghdr* txtime = CMSG_FIRSTHDR(&message);
+        txtime->cmsg_level = SOL_SOCKET;
+        txtime->cmsg_type = SCM_TXTIME;
+        txtime->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+        const uint64_t departure = static_cast<uint64_t>(departure_ns);
+        std::memcpy(CMSG_DATA(txtime), &departure, sizeof(departure));
+    }
+#endif
+    return sendmsg(socket_, &message, 0);
+}
+
+inline void MulticastSender::setup_pacing()
+{
+    pacing_mode_ = config_.pacing.enabled() ? config_.pacing.mode : PacingMode::None;
+    pacing_.configure(config_.pacing.rate, config_.pacing.burst);
+
+    if (pacing_mode_ == PacingMode::Kernel)
+    {
+#if defined(SO_MAX_PACING_RATE)
+        // The option takes a 32-bit rate; newer kernels also accept 64 bits for faster links
+        const uint64_t rate = config_.pacing.rate;
+        const uint32_t rate32 = static_cast<uint32_t>(rate);
+        const int result = rate > UINT32_MAX ? setsockopt(socket_, SOL_SOCKET, SO_MAX_PACING_RATE, &rate, sizeof(rate))
+                                             : setsockopt(socket_, SOL_SOCKET, SO_MAX_PACING_RATE, &rate32, sizeof(rate32));
+        if (result == 0)
+        {
+            LOG_DEBUG("{} paced by the kernel at {} bytes/s", name_, rate);
+            return;
+        }
+        int error = errno;
+        LOG_WARN("{}: failed to set SO_MAX_PACING_RATE, using a token bucket. error={} ({})", name_, error,
+                 strerror(error));
+#else
+        LOG_WARN("{}: SO_MAX_PACING_RATE is not available, using a token bucket", name_);
+#endif
+        pacing_mode_ = PacingMode::TokenBucket;
+    }
+    else if (pacing_mode_ == PacingMode::TxTime)
+    {
+#if defined(SO_TXTIME)
+        sock_txtime txtime{};
+        txtime.clockid = CLOCK_MONOTONIC;
+        txtime.flags = 0;
+        if (setsockopt(socket_, SOL_SOCKET, SO_TXTIME, &txtime, sizeof(txtime)) == 0)
+        {
+            return;
+        }
+        int error = errno;
+        LOG_WARN("{}: failed to set SO_TXTIME, using a token bucket. error={} ({})", name_, error, strerror(error));
+#else
+        LOG_WARN("{}: SO_TXTIME is not available, using a token bucket", name_);
+#endif
+        pacing_mode_ = PacingMode::TokenBucket;
+    }
+}
+
+inline bool MulticastSender::initialize_socket()
 {
     // Create UDP socket
-    socket_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    const bool ipv6 = destination_.ss_family == AF_INET6;
+    socket_ = ::socket(ipv6 ? AF_INET6 : AF_INET, SOCK_DGRAM, 0);
     if (socket_ == invalid_socket)
     {
         int error = errno;
@@ -147,7 +267,7 @@ bool MulticastSender::initialize_socket()
     return true;
 }
 
-void MulticastSender::cleanup_socket()
+inline void MulticastSender::cleanup_socket()
 {
     if (socket_ != invalid_socket)
     {
@@ -156,21 +276,28 @@ void MulticastSender::cleanup_socket()
     }
 }
 
-bool MulticastSender::setup_multicast_options()
+inline bool MulticastSender::setup_multicast_options()
 {
+    const bool ipv6 = destination_.ss_family == AF_INET6;
+
     // Bind to local address for sending (required on some platforms like macOS)
-    sockaddr_in local_addr{};
-    local_addr.sin_family = AF_INET;
-    local_addr.sin_port = 0; // Let OS choose ephemeral port
-    local_addr.sin_addr.s_addr = INADDR_ANY;
+    Endpoint local;
+    Endpoint::parse(ipv6 ? "::" : "0.0.0.0", 0, local);   // Let OS choose ephemeral port
+    sockaddr_storage local_addr{};
+    socklen_t local_len = local.to_sockaddr(local_addr);
 
-    if (bind(socket_, reinterpret_cast<const sockaddr*>(&local_addr), sizeof(local_addr)) < 0)
+    if (bind(socket_, reinterpret_cast<const sockaddr*>(&local_addr), local_len) < 0)
     {
         int error = errno;
         LOG_WARN("Failed to bind socket to local address. error={} ({})", error, strerror(error));
         // Don't fail on this, as it might work without binding
     }
 
+    if (ipv6)
+    {
+        return setup_ipv6_multicast_options();
+    }
+
     // Set TTL for multicast packets
     int ttl = config_.ttl;
     if (setsockopt(socket_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0)
@@ -212,4 +339,30 @@ bool MulticastSender::setup_multicast_options()
     return true;
 }
 
+inline bool MulticastSender::setup_ipv6_multicast_options()
+{
+    int hops = config_.ttl;
+    if (setsockopt(socket_, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, &hops, sizeof(hops)) < 0)
+    {
+        int error = errno;
+        LOG_WARN("Failed to set multicast hop limit. error={} ({})", error, strerror(error));
+    }
+
+    unsigned int loopback = config_.enable_loopback ? 1 : 0;
+    if (setsockopt(socket_, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, &loopback, sizeof(loopback)) < 0)
+    {
+        int error = errno;
+        LOG_WARN("Failed to set multicast loopback. error={} ({})", error, strerror(error));
+    }
+
+    unsigned int index = interface_index(config_.interface_address);
+    if (index != 0 && setsockopt(socket_, IPPROTO_IPV6, IPV6_MULTICAST_IF, &index, sizeof(index)) < 0)
+    {
+        int error = errno;
+        LOG_WARN("Failed to set multicast interface. error={} ({})", error, strerror(error));
+    }
+
+    return true;
+}
+
 } // namespace slick::socket
\ No newline at end of file
@@ -12,13 +12,13 @@
 namespace slick::socket
 {
 
-MulticastSender::MulticastSender(std::string name, const MulticastSenderConfig& config)
+inline MulticastSender::MulticastSender(std::string name, const MulticastSenderConfig& config)
     : name_(std::move(name)), config_(config)
 {
     LOG_DEBUG("MulticastSender {} created with address {}:{}", name_, config_.multicast_address, config_.port);
 }
 
-MulticastSender::~MulticastSender()
+inline MulticastSender::~MulticastSender()
 {
     if (running_.load(std::memory_order_relaxed))
     {
@@ -26,7 +26,7 @@ MulticastSender::~MulticastSender()
     }
 }
 
-bool MulticastSender::start()
+inline bool MulticastSender::start()
 {
     if (running_.load(std::memory_order_relaxed))
     {
@@ -45,6 +45,18 @@ bool MulticastSender::start()
         return false;
     }
 
+    // Resolved once; an invalid group is reported by send_data() as a send error
+    Endpoint group;
+    destination_len_ = 0;
+    if (Endpoint::parse(config_.multicast_address, config_.port, group))
+    {
+        destination_len_ = group.to_sockaddr(destination_);
+    }
+    else
+    {
+        LOG_ERROR("Invalid multicast address: {}", config_.multicast_address);
+    }
+
     if (!initialize_socket())
     {
         WSACleanup();
@@ -57,13 +69,14 @@ bool MulticastSender::start()
         WSACleanup();
         return false;
     }
+    setup_pacing();
 
     running_.store(true, std::memory_order_relaxed);
     LOG_INFO("{} started successfully", name_);
     return true;
 }
 
-void MulticastSender::stop()
+inline void MulticastSender::stop()
 {
     if (!running_.load(std::memory_order_relaxed))
     {
@@ -79,7 +92,7 @@ void MulticastSender::stop()
     LOG_INFO("{} stopped", name_);
 }
 
-bool MulticastSender::send_data(const std::vector<uint8_t>& data)
+inline bool MulticastSender::send_data(const std::vector<uint8_t>& data)
 {
     if (!running_.load(std::memory_order_relaxed))
     {
@@ -93,28 +106,34 @@ bool MulticastSender::send_data(const std::vector<uint8_t>& data)
         return false;
     }
 
-    // Create destination address
-    sockaddr_in dest_addr{};
-    dest_addr.sin_family = AF_INET;
-    dest_addr.sin_port = htons(config_.port);
-    
-    int result = inet_pton(AF_INET, config_.multicast_address.c_str(), &dest_addr.sin_addr);
-    if (result != 1)
+    if (destination_len_ == 0)
     {
         LOG_ERROR("Invalid multicast address: {}", config_.multicast_address);
         send_errors_.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
 
-    // Send the data
-    int bytes_sent = sendto(socket_, 
-                           reinterpret_cast<const char*>(data.data()), 
-                           static_cast<int>(data.size()),
-                           0,
-                           reinterpret_cast<const sockaddr*>(&dest_addr),
-                           sizeof(dest_addr));
+    // Paced before the header is written, so a timestamp reflects the actual departure (TxTime
+    // falls back to TokenBucket here, so the wait is always over)
+    size_t datagram_size = data.size();
+    if (config_.sequenced)
+    {
+        datagram_size += packet_header_size + (config_.timestamp ? packet_timestamp_size : 0);
+    }
+    int64_t departure_ns = pace(datagram_size);
+
+    // Send the data, behind a sequence header when configured (gathered, not copied)
+    uint8_t header[packet_header_max_size];
+    size_t header_length = 0;
+    if (config_.sequenced)
+    {
+        uint16_t flags = (config_.checksum ? packet_flag_checksum : 0) | (config_.timestamp ? packet_flag_timestamp : 0);
+        uint64_t sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+        header_length = write_packet_header(header, sequence, flags, data.data(), data.size());
+    }
+    int64_t bytes_sent = send_datagram(header, header_length, data.data(), data.size(), departure_ns);
 
-    if (bytes_sent == SOCKET_ERROR)
+    if (bytes_sent < 0)
     {
         int error = WSAGetLastError();
         LOG_ERROR("Failed to send multicast data. error={}", error);
@@ -122,9 +141,9 @@ bool MulticastSender::send_data(const std::vector<uint8_t>& data)
         return false;
     }
 
-    if (static_cast<size_t>(bytes_sent) != data.size())
+    if (static_cast<size_t>(bytes_sent) != header_length + data.size())
     {
-        LOG_WARN("Partial send: {} bytes sent out of {}", bytes_sent, data.size());
+        LOG_WARN("Partial send: {} bytes sent out of {}", bytes_sent, header_length + data.size());
     }
 
     packets_sent_.fetch_add(1, std::memory_order_relaxed);
@@ -134,10 +153,47 @@ bool MulticastSender::send_data(const std::vector<uint8_t>& data)
     return true;
 }
 
-bool MulticastSender::initialize_socket()
+inline int64_t MulticastSender::send_datagram(const uint8_t* header, size_t header_length, const uint8_t* payload,
+                                              size_t length, int64_t departure_ns)
+{
+    WSABUF parts[2];
+    DWORD count = 0;
+    if (header_length != 0)
+    {
+        parts[count].buf = reinterpret_cast<char*>(const_cast<uint8_t*>(header));
+        parts[count].len = static_cast<ULONG>(header_length);
+        ++count;
+    }
+    parts[count].buf = reinterpret_cast<char*>(const_cast<uint8_t*>(payload));
+    parts[count].len = static_cast<ULONG>(length);
+    ++count;
+
+    (void)departure_ns;     // pace() never returns one here: TxTime falls back to TokenBucket
+    DWORD bytes_sent = 0;
+    if (WSASendTo(socket_, parts, count, &bytes_sent, 0, reinterpret_cast<const sockaddr*>(&destination_),
+                  destination_len_, nullptr, nullptr) == SOCKET_ERROR)
+    {
+        return -1;
+    }
+    return bytes_sent;
+}
+
+inline void MulticastSender::setup_pacing()
+{
+    pacing_mode_ = config_.pacing.enabled() ? config_.pacing.mode : PacingMode::None;
+    pacing_.configure(config_.pacing.rate, config_.pacing.burst);
+    if (pacing_mode_ == PacingMode::Kernel || pacing_mode_ == PacingMode::TxTime)
+    {
+        LOG_WARN("{}: kernel pacing is not available on Windows, using a token bucket", name_);
+        pacing_mode_ = PacingMode::TokenBucket;
+    }
+}
+
+inline bool MulticastSender::initialize_socket()
 {
     // Create UDP socket
-    socket_ = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    const bool ipv6 = destination_.ss_family == AF_INET6;
+    socket_ = ::socket(ipv6 ? AF_INET6 : AF_INET, SOCK_DGRAM, IPPROTO_UDP);
     if (socket_ == invalid_socket)
     {
         int error = WSAGetLastError();
@@ -157,7 +213,7 @@ bool MulticastSender::initialize_socket()
     return true;
 }
 
-void MulticastSender::cleanup_socket()
+inline void MulticastSender::cleanup_socket()
 {
     if (socket_ != invalid_socket)
     {
@@ -166,8 +222,13 @@ void MulticastSender::cleanup_socket()
     }
 }
 
-bool MulticastSender::setup_multicast_options()
+inline bool MulticastSender::setup_multicast_options()
 {
+    if (destination_.ss_family == AF_INET6)
+    {
+        return setup_ipv6_multicast_options();
+    }
+
     // Set TTL for multicast packets
     DWORD ttl = static_cast<DWORD>(config_.ttl);
     if (setsockopt(socket_, IPPROTO_IP, IP_MULTICAST_TTL,
@@ -212,4 +273,37 @@ bool MulticastSender::setup_multicast_options()
     return true;
 }
 
+inline bool MulticastSender::setup_ipv6_multicast_options()
+{
+    DWORD hops = static_cast<DWORD>(config_.ttl);
+    if (setsockopt(socket_, IPPROTO_IPV6, IPV6_MULTICAST_HOPS,
+                   reinterpret_cast<const char*>(&hops), sizeof(hops)) == SOCKET_ERROR)
+    {
+        int error = WSAGetLastError();
+        LOG_ERROR("Failed to set multicast hop limit. error={}", error);
+        return false;
+    }
+
+    DWORD loopback = config_.enable_loopback ? 1 : 0;
+    if (setsockopt(socket_, IPPROTO_IPV6, IPV6_MULTICAST_LOOP,
+                   reinterpret_cast<const char*>(&loopback), sizeof(loopback)) == SOCKET_ERROR)
+    {
+        int error = WSAGetLastError();
+        LOG_ERROR("Failed to set multicast loopback. error={}", error);
+        return false;
+    }
+
+    // Only numeric interface indexes are understood here
+    DWORD index = interface_index(config_.interface_address);
+    if (index != 0 && setsockopt(socket_, IPPROTO_IPV6, IPV6_MULTICAST_IF,
+                                 reinterpret_cast<const char*>(&index), sizeof(index)) == SOCKET_ERROR)
+    {
+        int error = WSAGetLastError();
+        LOG_ERROR("Failed to set multicast interface. error={}", error);
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace slick::socket
\ No newline at end of file
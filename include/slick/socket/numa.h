@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <winsock2.h>
+#include <windows.h>
+#else
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace slick::socket
+{
+
+// NUMA placement helpers for the event loops.
+// Nodes are numbered as in /sys/devices/system/node; only nodes 0-63 are supported.
+// On platforms without NUMA support the helpers report failure and callers carry on unbound.
+constexpr int numa_max_nodes = 64;
+
+#if defined(__linux__)
+// From <linux/mempolicy.h>; spelled out to avoid depending on kernel headers
+constexpr int numa_mpol_preferred = 1;
+constexpr int numa_mpol_bind = 2;
+constexpr unsigned numa_mpol_mf_move = 1u << 1;
+#endif
+
+// Node the NIC is attached to, read from /sys/class/net/<ifname>/device/numa_node.
+// Returns -1 for virtual interfaces, single-node machines and non-Linux platforms.
+inline int numa_node_of_interface(const std::string& interface_name)
+{
+#if defined(__linux__)
+    std::ifstream file("/sys/class/net/" + interface_name + "/device/numa_node");
+    int node = -1;
+    if (file >> node && node >= 0 && node < numa_max_nodes)
+    {
+        return node;
+    }
+#else
+    (void)interface_name;
+#endif
+    return -1;
+}
+
+// Name of the interface that owns a local IPv4 address, empty if none does
+inline std::string interface_of_address(const std::string& address)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    (void)address;
+    return {};
+#else
+    in_addr target{};
+    if (inet_pton(AF_INET, address.c_str(), &target) != 1)
+    {
+        return {};
+    }
+
+    ifaddrs* list = nullptr;
+    if (getifaddrs(&list) != 0)
+    {
+        return {};
+    }
+
+    std::string name;
+    for (ifaddrs* it = list; it; it = it->ifa_next)
+    {
+        if (it->ifa_addr && it->ifa_addr->sa_family == AF_INET &&
+            reinterpret_cast<sockaddr_in*>(it->ifa_addr)->sin_addr.s_addr == target.s_addr)
+        {
+            name = it->ifa_name;
+            break;
+        }
+    }
+    freeifaddrs(list);
+    return name;
+#endif
+}
+
+// Node to use for a loop: an explicit node wins, otherwise it is detected from interface_name,
+// which may be an interface name ("eth0") or one of its IPv4 addresses. -1 = no placement.
+inline int resolve_numa_node(int node, const std::string& interface_name)
+{
+    if (node >= 0)
+    {
+        return node < numa_max_nodes ? node : -1;
+    }
+    if (interface_name.empty())
+    {
+        return -1;
+    }
+
+    std::string name = interface_of_address(interface_name);
+    return numa_node_of_interface(name.empty() ? interface_name : name);
+}
+
+// CPUs in a sysfs cpulist ("0-7,16-23"). A malformed list yields no CPUs, i.e. no NUMA information.
+inline std::vector<int> parse_cpu_list(const std::string& list)
+{
+    std::vector<int> cpus;
+    auto parse = [](std::string_view text, int& value) {
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc() && end == text.data() + text.size() && value >= 0;
+    };
+
+    std::string_view rest(list);
+    while (!rest.empty())
+    {
+        size_t comma = rest.find(',');
+        std::string_view range = rest.substr(0, comma);
+        rest = comma == std::string_view::npos ? std::string_view() : rest.substr(comma + 1);
+        if (range.empty())
+        {
+            continue;
+        }
+
+        size_t dash = range.find('-');
+        int first = 0;
+        int last = 0;
+        if (!parse(range.substr(0, dash), first) ||
+            !parse(dash == std::string_view::npos ? range : range.substr(dash + 1), last) || last < first)
+        {
+            return {};
+        }
+        for (int cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// CPUs of a node, read from /sys/devices/system/node/node<N>/cpulist
+inline std::vector<int> numa_node_cpus(int node)
+{
+#if defined(__linux__)
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string list;
+    if (std::getline(file, list))
+    {
+        return parse_cpu_list(list);
+    }
+#else
+    (void)node;
+#endif
+    return {};
+}
+
+// Restrict the calling thread to the CPUs of node
+inline bool pin_thread_to_numa_node(int node)
+{
+#if defined(__linux__)
+    std::vector<int> cpus = numa_node_cpus(node);
+    if (cpus.empty())
+    {
+        return false;
+    }
+
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (int cpu : cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &cpuset);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0;
+#elif defined(_WIN32) || defined(_WIN64)
+    ULONGLONG mask = 0;
+    if (!GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &mask) || mask == 0)
+    {
+        return false;
+    }
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask)) != 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+// Prefer node for every page the calling thread faults in from now on (first touch)
+inline bool prefer_numa_node_for_thread(int node)
+{
+#if defined(__linux__)
+    unsigned long mask = 1UL << node;
+    return syscall(SYS_set_mempolicy, numa_mpol_preferred, &mask, sizeof(mask) * 8 + 1) == 0;
+#elif defined(_WIN32) || defined(_WIN64)
+    // Windows already allocates from the node of the thread's ideal processor
+    (void)node;
+    return true;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+// Bind an existing mapping to node, migrating pages that were already faulted in elsewhere
+inline bool bind_memory_to_numa_node(void* address, size_t length, int node)
+{
+#if defined(__linux__)
+    unsigned long mask = 1UL << node;
+    return syscall(SYS_mbind, address, length, numa_mpol_bind, &mask, sizeof(mask) * 8 + 1,
+                   numa_mpol_mf_move) == 0;
+#else
+    (void)address;
+    (void)length;
+    (void)node;
+    return false;
+#endif
+}
+
+} // namespace slick::socket
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <slick/socket/clock.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace slick::socket
+{
+
+// How MulticastSender spaces its datagrams
+enum class PacingMode : uint8_t
+{
+    None,           // back to back
+    TokenBucket,    // send_data() waits for the datagram's departure time (any platform)
+    Kernel,         // SO_MAX_PACING_RATE: the fq qdisc spaces the socket's packets (Linux)
+    TxTime,         // SO_TXTIME: each datagram carries its token-bucket departure time and
+                    // send_data() returns at once; the fq qdisc holds it until then (Linux)
+};
+
+struct PacingConfig
+{
+    PacingMode mode = PacingMode::None;
+    uint64_t rate = 0;          // datagram bytes per second (UDP/IP headers not counted), 0 = unpaced
+    size_t burst = 16 * 1024;   // bytes sent back to back before spacing starts (TokenBucket, TxTime)
+
+    bool enabled() const noexcept { return mode != PacingMode::None && rate > 0; }
+};
+
+// Token bucket in virtual-time form (GCRA): one atomic holds the time the bucket will be full
+// again, so any number of sending threads can schedule without a lock. A datagram of n bytes
+// costs n / rate seconds; it may leave once the debt ahead of it is within the burst allowance.
+class PacingSchedule
+{
+public:
+    void configure(uint64_t rate, size_t burst) noexcept
+    {
+        ns_per_byte_ = rate > 0 ? 1e9 / static_cast<double>(rate) : 0.0;
+        burst_ns_ = static_cast<int64_t>(static_cast<double>(burst) * ns_per_byte_);
+        full_at_.store(0, std::memory_order_relaxed);
+    }
+
+    // Departure time (steady_clock nanoseconds, at least now_ns) of a datagram of bytes
+    // submitted at now_ns
+    int64_t schedule(size_t bytes, int64_t now_ns) noexcept
+    {
+        const int64_t cost = std::llround(static_cast<double>(bytes) * ns_per_byte_);
+        int64_t full_at = full_at_.load(std::memory_order_relaxed);
+        int64_t next;
+        do
+        {
+            next = std::max(full_at, now_ns) + cost;
+        } while (!full_at_.compare_exchange_weak(full_at, next, std::memory_order_relaxed));
+        return std::max(now_ns, next - burst_ns_);
+    }
+
+private:
+    double ns_per_byte_ = 0.0;
+    int64_t burst_ns_ = 0;
+    std::atomic<int64_t> full_at_{0};
+};
+
+// Waits for a steady_clock time in nanoseconds: sleeps while it is far off, then spins, since
+// datagram spacing is usually well below the scheduler's wake-up granularity
+inline void wait_until_ns(int64_t deadline_ns) noexcept
+{
+    constexpr int64_t spin_ns = 100'000;
+    int64_t remaining = deadline_ns - TscClock::now_ns();
+    if (remaining > 2 * spin_ns)
+    {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(remaining - spin_ns));
+    }
+    while (TscClock::now_ns() < deadline_ns)
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+        _mm_pause();
+#endif
+    }
+}
+
+} // namespace slick::socket
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <slick/socket/crc32c.h>
+#include <slick/socket/latency.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace slick::socket
+{
+
+// Header MulticastSender prepends to each datagram when MulticastSenderConfig::sequenced is set,
+// all fields little endian:
+//   [0, 8)   sequence   increments by one per datagram, so receivers can count gaps
+//   [8, 10)  flags      packet_flag_checksum, packet_flag_timestamp
+//   [10, 12) reserved   zero
+//   [12, 16) checksum   CRC32C over bytes [0, 12) followed by everything after byte 16
+//   [16, 24) send time  with packet_flag_timestamp: timestamp_ns() just before the send
+// UDP's checksum is optional over IPv4 and only 16 bits wide; the CRC catches what it misses.
+inline constexpr size_t packet_header_size = 16;
+inline constexpr size_t packet_timestamp_size = 8;
+inline constexpr size_t packet_header_max_size = packet_header_size + packet_timestamp_size;
+inline constexpr uint16_t packet_flag_checksum = 0x0001;
+inline constexpr uint16_t packet_flag_timestamp = 0x0002;
+
+struct PacketHeader
+{
+    uint64_t sequence = 0;
+    uint16_t flags = 0;
+    uint32_t checksum = 0;
+    uint64_t send_time = 0;     // with packet_flag_timestamp
+
+    // Bytes before the payload
+    size_t size() const noexcept
+    {
+        return packet_header_size + ((flags & packet_flag_timestamp) ? packet_timestamp_size : 0);
+    }
+};
+
+namespace packet_detail
+{
+
+template<typename T>
+inline void store_le(uint8_t* out, T value) noexcept
+{
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+template<typename T>
+inline T load_le(const uint8_t* in) noexcept
+{
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        value |= static_cast<T>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+// Covers the fixed fields, the extension (header_size bytes in all) and the payload
+inline uint32_t packet_checksum(const uint8_t* header, size_t header_size, const uint8_t* payload,
+                                size_t length) noexcept
+{
+    uint32_t crc = crc32c(header, 12);
+    crc = crc32c(header + packet_header_size, header_size - packet_header_size, crc);
+    return crc32c(payload, length, crc);
+}
+
+} // namespace packet_detail
+
+// Fills the header for payload into out (packet_header_max_size bytes) and returns its size.
+// flags select the checksum and the send timestamp, which is taken here unless send_time
+// (timestamp_ns() timeline) gives a scheduled departure.
+inline size_t write_packet_header(uint8_t* out, uint64_t sequence, uint16_t flags, const uint8_t* payload,
+                                  size_t length, uint64_t send_time = 0) noexcept
+{
+    size_t size = packet_header_size;
+    packet_detail::store_le<uint64_t>(out, sequence);
+    packet_detail::store_le<uint16_t>(out + 8, flags);
+    packet_detail::store_le<uint16_t>(out + 10, 0);
+    if (flags & packet_flag_timestamp)
+    {
+        packet_detail::store_le<uint64_t>(out + packet_header_size, send_time ? send_time : timestamp_ns());
+        size += packet_timestamp_size;
+    }
+    uint32_t checksum = 0;
+    if (flags & packet_flag_checksum)
+    {
+        checksum = packet_detail::packet_checksum(out, size, payload, length);
+    }
+    packet_detail::store_le<uint32_t>(out + 12, checksum);
+    return size;
+}
+
+// False when the datagram is shorter than the header its flags announce
+inline bool read_packet_header(const uint8_t* data, size_t length, PacketHeader& header) noexcept
+{
+    if (length < packet_header_size)
+    {
+        return false;
+    }
+    header.sequence = packet_detail::load_le<uint64_t>(data);
+    header.flags = packet_detail::load_le<uint16_t>(data + 8);
+    header.checksum = packet_detail::load_le<uint32_t>(data + 12);
+    if (length < header.size())
+    {
+        return false;
+    }
+    header.send_time = (header.flags & packet_flag_timestamp) ? packet_detail::load_le<uint64_t>(data + 16) : 0;
+    return true;
+}
+
+// True when the datagram carries no checksum or its checksum matches
+inline bool verify_packet(const uint8_t* data, size_t length, const PacketHeader& header) noexcept
+{
+    if ((header.flags & packet_flag_checksum) == 0)
+    {
+        return true;
+    }
+    size_t size = header.size();
+    return packet_detail::packet_checksum(data, size, data + size, length - size) == header.checksum;
+}
+
+} // namespace slick::socket
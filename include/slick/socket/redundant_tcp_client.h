@@ -0,0 +1,469 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <slick/socket/tcp_client.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace slick::socket
+{
+
+struct RedundantTCPClientConfig
+{
+    TCPClientConfig primary;
+    TCPClientConfig backup;
+    std::chrono::milliseconds heartbeat_interval{100};  // heartbeat_message after this long without a send on a link
+    std::chrono::milliseconds heartbeat_timeout{500};   // a link silent for this long is failed, 0 = never
+    std::vector<uint8_t> heartbeat_message;             // empty = no heartbeats sent, peer traffic only
+    bool fail_on_health_alert = true;                   // TCP_INFO threshold alerts fail the link (Linux)
+    std::chrono::milliseconds reconnect_interval{1000}; // retry period for a link that is down
+    std::chrono::milliseconds connect_timeout{500};     // caps each link's connection_timeout; bounds how long stop() waits on a reconnect
+    size_t max_unacknowledged = 65536;                  // messages kept for replay, 0 = no replay
+};
+
+// Two connections, to a primary and a backup server, kept open and heartbeated side by side.
+// send_data() goes to the active link; when it fails (reset, heartbeat timeout, health alert)
+// the other link becomes active at once and every message not yet acknowledged is replayed on it.
+// A failed link is reconnected in the background and becomes the standby; there is no failback.
+//
+// Messages are numbered from 1 in send order (last_sequence()); the application calls
+// acknowledge(sequence) when its protocol confirms delivery. Derived classes implement
+// onData(const uint8_t*, size_t) for data from the active link (heartbeat replies included) and
+// may implement onFailover(int from, int to), onLinkUp(int link) and onLinkDown(int link).
+// Callbacks run on the thread that observed the event; do not block or call send_data() in them.
+// Derived classes must call stop() in their destructor: the links' threads call into the derived
+// object until stop() returns.
+template<typename DerivedT, typename TraitsT = DefaultSocketTraits>
+class RedundantTCPClientBase
+{
+public:
+    static constexpr int primary_link = 0;
+    static constexpr int backup_link = 1;
+    static constexpr int no_link = -1;
+
+    explicit RedundantTCPClientBase(std::string name, const RedundantTCPClientConfig& config = RedundantTCPClientConfig())
+        : name_(std::move(name))
+        , config_(config)
+    {
+        // Heartbeats and silence detection run in each link's client loop
+        for (TCPClientConfig* link_config : {&config_.primary, &config_.backup})
+        {
+            link_config->heartbeat.idle_interval = config_.heartbeat_interval;
+            link_config->heartbeat.peer_timeout = config_.heartbeat_timeout;
+            link_config->heartbeat.frame = config_.heartbeat_message;
+            link_config->connection_timeout = std::min(link_config->connection_timeout, config_.connect_timeout);
+        }
+        links_[primary_link] = std::make_unique<Link>(name_ + "-primary", config_.primary, this, primary_link);
+        links_[backup_link] = std::make_unique<Link>(name_ + "-backup", config_.backup, this, backup_link);
+    }
+
+    // Derived classes call stop() first; this one only covers a base that was never derived from
+    virtual ~RedundantTCPClientBase()
+    {
+        stop();
+    }
+
+    RedundantTCPClientBase(const RedundantTCPClientBase&) = delete;
+    RedundantTCPClientBase& operator=(const RedundantTCPClientBase&) = delete;
+
+    // Connects both links; succeeds when at least one is up. The primary is preferred as active.
+    bool start()
+    {
+        if (running_.load(std::memory_order_relaxed))
+        {
+            return true;
+        }
+
+        running_.store(true, std::memory_order_release);
+        bool primary_up = links_[primary_link]->connect();
+        bool backup_up = links_[backup_link]->connect();
+        if (!primary_up && !backup_up)
+        {
+            LOG_ERROR("{}: neither the primary nor the backup server is reachable", name_);
+            running_.store(false, std::memory_order_release);
+            return false;
+        }
+
+        reconnect_thread_ = std::thread(&RedundantTCPClientBase::reconnect_loop, this);
+        return true;
+    }
+
+    void stop()
+    {
+        // running_ turns failover off: the disconnects below neither switch links nor replay
+        if (!running_.exchange(false))
+        {
+            return;
+        }
+        active_.store(no_link, std::memory_order_release);
+        replay_pending_.store(false);
+
+        {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+        }
+        wait_cv_.notify_all();
+        if (reconnect_thread_.joinable())
+        {
+            reconnect_thread_.join();
+        }
+        for (auto& link : links_)
+        {
+            link->disconnect();
+        }
+        active_.store(no_link, std::memory_order_release);   // a link that came up while stopping
+    }
+
+    bool is_running() const noexcept
+    {
+        return running_.load(std::memory_order_relaxed);
+    }
+
+    // Logs the message for replay and sends it on the active link, failing over if that send fails.
+    // Returns false when no link is up; the message is not logged in that case.
+    bool send_data(const std::vector<uint8_t>& data)
+    {
+        bool sent = send_locked(data);
+        drain_replay();
+        return sent;
+    }
+
+    bool send_data(const std::string& data)
+    {
+        return send_data(std::vector<uint8_t>(data.begin(), data.end()));
+    }
+
+    // Drops logged messages up to and including sequence. Safe to call from any thread.
+    void acknowledge(uint64_t sequence)
+    {
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        while (!log_.empty() && log_.front().sequence <= sequence)
+        {
+            log_.pop_front();
+        }
+    }
+
+    uint64_t last_sequence() const
+    {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        return next_sequence_;
+    }
+
+    size_t unacknowledged() const
+    {
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        return log_.size();
+    }
+
+    // primary_link, backup_link or no_link
+    int active_link() const noexcept
+    {
+        return active_.load(std::memory_order_acquire);
+    }
+
+    bool is_link_up(int link) const noexcept
+    {
+        return link_up_[link].load(std::memory_order_acquire);
+    }
+
+    uint64_t failover_count() const noexcept
+    {
+        return failovers_.load(std::memory_order_relaxed);
+    }
+
+    // From detection of the failure to the end of the replay on the new link
+    std::chrono::nanoseconds last_failover_duration() const noexcept
+    {
+        return std::chrono::nanoseconds(last_failover_ns_.load(std::memory_order_relaxed));
+    }
+
+protected:
+    DerivedT& derived() { return static_cast<DerivedT&>(*this); }
+
+private:
+    class Link : public TCPClientBase<Link, TraitsT>
+    {
+    public:
+        Link(std::string name, const TCPClientConfig& config, RedundantTCPClientBase* owner, int index)
+            : TCPClientBase<Link, TraitsT>(std::move(name), config)
+            , owner_(owner)
+            , index_(index)
+        {
+        }
+
+        void onConnected() { owner_->on_link_up(index_); }
+        void onDisconnected() { owner_->on_link_down(index_, "connection closed"); }
+        void onData(const uint8_t* data, size_t length) { owner_->on_link_data(index_, data, length); }
+        void onHeartbeatTimeout() { owner_->on_link_down(index_, "heartbeat timeout"); }
+
+        void onConnectionHealthAlert(const TCPConnectionHealth&)
+        {
+            if (owner_->config_.fail_on_health_alert && owner_->on_link_down(index_, "health alert"))
+            {
+                this->disconnect();     // on the link thread: the loop ends and closes the socket
+            }
+        }
+
+    private:
+        RedundantTCPClientBase* owner_;
+        int index_;
+    };
+
+    struct LoggedMessage
+    {
+        uint64_t sequence;
+        std::vector<uint8_t> data;
+    };
+
+    static int64_t now_ns() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void on_link_up(int link)
+    {
+        link_up_[link].store(true, std::memory_order_release);
+        LOG_INFO("{}: {} link up", name_, link == primary_link ? "primary" : "backup");
+        if (!running_.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        // First link up, or the only link after both were down: it becomes active and gets the backlog
+        int expected = no_link;
+        if (active_.compare_exchange_strong(expected, link, std::memory_order_acq_rel))
+        {
+            failover_started_ns_.store(now_ns(), std::memory_order_relaxed);
+            request_replay();
+        }
+
+        if constexpr (requires { derived().onLinkUp(link); })
+        {
+            derived().onLinkUp(link);
+        }
+    }
+
+    // Returns false when the link was already down. Never blocks on a concurrent send: if
+    // send_mutex_ is held, the replay is left to the sending thread. Threads that hold
+    // send_mutex_ pass replay_now = false and replay themselves.
+    bool on_link_down(int link, const char* reason, bool replay_now = true)
+    {
+        if (!link_up_[link].exchange(false, std::memory_order_acq_rel))
+        {
+            return false;
+        }
+        // Stopping: no failover, no replay and no callbacks into a derived object being destroyed
+        if (!running_.load(std::memory_order_acquire))
+        {
+            return true;
+        }
+        int64_t detected = now_ns();
+        LOG_WARN("{}: {} link down ({})", name_, link == primary_link ? "primary" : "backup", reason);
+
+        int other = 1 - link;
+        int next = link_up_[other].load(std::memory_order_acquire) ? other : no_link;
+        int expected = link;
+        if (active_.compare_exchange_strong(expected, next, std::memory_order_acq_rel))
+        {
+            failover_started_ns_.store(detected, std::memory_order_relaxed);
+            if (next != no_link)
+            {
+                replay_pending_.store(true);
+                if (replay_now)
+                {
+                    request_replay();
+                }
+                failovers_.fetch_add(1, std::memory_order_relaxed);
+                LOG_WARN("{}: failed over to the {} link", name_, next == primary_link ? "primary" : "backup");
+                if constexpr (requires { derived().onFailover(link, next); })
+                {
+                    derived().onFailover(link, next);
+                }
+            }
+        }
+
+        if constexpr (requires { derived().onLinkDown(link); })
+        {
+            derived().onLinkDown(link);
+        }
+        return true;
+    }
+
+    // Logs and sends data under send_mutex_
+    bool send_locked(const std::vector<uint8_t>& data)
+    {
+        std::lock_guard<std::mutex> send_lock(send_mutex_);
+        if (active_.load(std::memory_order_acquire) == no_link)
+        {
+            LOG_WARN("{}: cannot send data, no link is up", name_);
+            return false;
+        }
+
+        if (config_.max_unacknowledged > 0)
+        {
+            std::lock_guard<std::mutex> lock(log_mutex_);
+            if (log_.size() >= config_.max_unacknowledged)
+            {
+                LOG_WARN("{}: replay log full, dropping unacknowledged message {}", name_, log_.front().sequence);
+                log_.pop_front();
+            }
+            log_.push_back({next_sequence_ + 1, data});
+        }
+        ++next_sequence_;
+
+        int link = active_.load(std::memory_order_acquire);
+        bool sent = link != no_link && links_[link]->send_data(data);
+        if (!sent && link != no_link)
+        {
+            on_link_down(link, "send failed", false);
+        }
+
+        // A failed send switched active_; the replay on the new link covers this message
+        if (replay_pending_.load())
+        {
+            replay_locked();
+            sent = active_.load(std::memory_order_acquire) != no_link;
+        }
+        return sent;
+    }
+
+    void on_link_data(int link, const uint8_t* data, size_t length)
+    {
+        if (active_.load(std::memory_order_acquire) == link)
+        {
+            derived().onData(data, length);
+        }
+    }
+
+    void request_replay()
+    {
+        replay_pending_.store(true);
+        drain_replay();
+    }
+
+    // Runs a pending replay unless another thread holds send_mutex_. Every holder calls this after
+    // releasing it, so a replay requested while the lock was held is picked up at that point.
+    void drain_replay()
+    {
+        while (replay_pending_.load())
+        {
+            std::unique_lock<std::mutex> send_lock(send_mutex_, std::try_to_lock);
+            if (!send_lock.owns_lock())
+            {
+                return;
+            }
+            replay_locked();
+        }
+    }
+
+    // Called with send_mutex_ held. Repeats while sends during the replay bring links down.
+    void replay_locked()
+    {
+        while (replay_pending_.exchange(false))
+        {
+            int link = active_.load(std::memory_order_acquire);
+            if (link == no_link)
+            {
+                return;
+            }
+
+            std::vector<LoggedMessage> backlog;
+            {
+                std::lock_guard<std::mutex> lock(log_mutex_);
+                backlog.assign(log_.begin(), log_.end());
+            }
+            size_t replayed = 0;
+            for (const auto& message : backlog)
+            {
+                if (!running_.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+                if (!links_[link]->send_data(message.data))
+                {
+                    on_link_down(link, "send failed", false);
+                    break;
+                }
+                ++replayed;
+            }
+
+            if (replayed == backlog.size() && !replay_pending_.load())
+            {
+                last_failover_ns_.store(now_ns() - failover_started_ns_.load(std::memory_order_relaxed),
+                                        std::memory_order_relaxed);
+                if (!backlog.empty())
+                {
+                    LOG_INFO("{}: replayed {} unacknowledged messages", name_, backlog.size());
+                }
+            }
+        }
+    }
+
+    // Brings failed links back as standby. Each attempt is bounded by config.connect_timeout,
+    // which is how long stop() can wait here.
+    void reconnect_loop()
+    {
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        while (running_.load(std::memory_order_relaxed))
+        {
+            wait_cv_.wait_for(lock, config_.reconnect_interval, [this]() { return !running_.load(std::memory_order_relaxed); });
+            if (!running_.load(std::memory_order_relaxed))
+            {
+                break;
+            }
+            lock.unlock();
+
+            for (int link = primary_link; link <= backup_link && running_.load(std::memory_order_relaxed); ++link)
+            {
+                if (!link_up_[link].load(std::memory_order_acquire))
+                {
+                    links_[link]->disconnect();     // reap the thread of the failed connection
+                    links_[link]->connect();
+                }
+            }
+
+            lock.lock();
+        }
+    }
+
+    // Cold: set up in the constructor
+    std::string name_;
+    RedundantTCPClientConfig config_;
+    std::array<std::unique_ptr<Link>, 2> links_;
+    std::thread reconnect_thread_;
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cv_;
+
+    // Read on every send, written on failover
+    alignas(cache_line_size) std::atomic<int> active_{no_link};
+    std::atomic_bool running_{false};
+    std::atomic_bool replay_pending_{false};
+    std::array<std::atomic_bool, 2> link_up_{};
+
+    // Senders; log_mutex_ is never held while a link is disconnected, so acknowledge() cannot deadlock
+    alignas(cache_line_size) mutable std::mutex send_mutex_;
+    uint64_t next_sequence_ = 0;            // guarded by send_mutex_
+    mutable std::mutex log_mutex_;
+    std::deque<LoggedMessage> log_;         // guarded by log_mutex_
+
+    // Failover statistics
+    alignas(cache_line_size) std::atomic<int64_t> failover_started_ns_{0};
+    std::atomic<int64_t> last_failover_ns_{0};
+    std::atomic<uint64_t> failovers_{0};
+};
+
+} // namespace slick::socket
@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <slick/socket/endpoint.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <sys/socket.h>
+#endif
+
+namespace slick::socket
+{
+
+struct ResolverConfig
+{
+    size_t threads = 2;                         // getaddrinfo workers
+    std::chrono::seconds ttl{60};               // lifetime of a successful lookup
+    std::chrono::seconds negative_ttl{5};       // lifetime of a failed lookup
+    size_t max_entries = 1024;                  // cache is cleared when it grows past this
+};
+
+// Host name resolution off the event loops. getaddrinfo runs on a small pool of worker threads;
+// results are cached per host for ttl (getaddrinfo does not report record TTLs) and concurrent
+// lookups of the same host share one query. Numeric addresses never reach the pool.
+class Resolver
+{
+public:
+    using Callback = std::function<void(const std::vector<Endpoint>&)>;
+
+    static Resolver& instance()
+    {
+        static Resolver resolver;
+        return resolver;
+    }
+
+    explicit Resolver(const ResolverConfig& config = ResolverConfig())
+        : config_(config)
+    {
+    }
+
+    ~Resolver()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        work_ready_.notify_all();
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    Resolver(const Resolver&) = delete;
+    Resolver& operator=(const Resolver&) = delete;
+
+    // Candidates in getaddrinfo order (RFC 6724), empty when the host does not resolve.
+    // Numeric and cached hosts complete on the calling thread, others on a resolver thread.
+    void resolve(const std::string& host, uint16_t port, Callback callback)
+    {
+        std::vector<Endpoint> endpoints;
+        if (resolve_now(host, port, endpoints))
+        {
+            callback(endpoints);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& waiters = pending_[host];
+        waiters.push_back({port, std::move(callback)});
+        if (waiters.size() == 1)
+        {
+            queue_.push_back(host);
+            start_workers();
+            work_ready_.notify_one();
+        }
+    }
+
+    // Blocks the calling thread for at most timeout. Never call this from an event loop.
+    std::vector<Endpoint> resolve_wait(const std::string& host, uint16_t port, std::chrono::milliseconds timeout)
+    {
+        // Shared with the callback, which may run after a timed-out wait has returned
+        struct Result
+        {
+            std::mutex mutex;
+            std::condition_variable done;
+            bool ready = false;
+            std::vector<Endpoint> endpoints;
+        };
+        auto result = std::make_shared<Result>();
+        resolve(host, port, [result](const std::vector<Endpoint>& resolved) {
+            std::lock_guard<std::mutex> lock(result->mutex);
+            result->endpoints = resolved;
+            result->ready = true;
+            result->done.notify_all();
+        });
+
+        std::unique_lock<std::mutex> lock(result->mutex);
+        result->done.wait_for(lock, timeout, [&]() { return result->ready; });
+        return result->endpoints;
+    }
+
+    // Numeric address or live cache entry; false when a lookup is needed
+    bool resolve_now(const std::string& host, uint16_t port, std::vector<Endpoint>& endpoints)
+    {
+        Endpoint numeric;
+        if (Endpoint::parse(host, port, numeric))
+        {
+            endpoints.assign(1, numeric);
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = cache_.find(host);
+        if (it == cache_.end() || it->second.expires < std::chrono::steady_clock::now())
+        {
+            ++misses_;
+            return false;
+        }
+        ++hits_;
+        endpoints = with_port(it->second.endpoints, port);
+        return true;
+    }
+
+    void clear_cache()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.clear();
+    }
+
+    uint64_t cache_hits() const noexcept { return hits_.load(std::memory_order_relaxed); }
+    uint64_t cache_misses() const noexcept { return misses_.load(std::memory_order_relaxed); }
+
+private:
+    struct Waiter
+    {
+        uint16_t port;
+        Callback callback;
+    };
+
+    struct CacheEntry
+    {
+        std::vector<Endpoint> endpoints;    // port 0
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    static std::vector<Endpoint> with_port(std::vector<Endpoint> endpoints, uint16_t port)
+    {
+        for (auto& endpoint : endpoints)
+        {
+            endpoint.port = port;
+        }
+        return endpoints;
+    }
+
+    static std::vector<Endpoint> lookup(const std::string& host)
+    {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_ADDRCONFIG;
+
+        std::vector<Endpoint> endpoints;
+        addrinfo* results = nullptr;
+        if (getaddrinfo(host.c_str(), nullptr, &hints, &results) != 0)
+        {
+            return endpoints;
+        }
+        for (addrinfo* it = results; it; it = it->ai_next)
+        {
+            Endpoint endpoint;
+            if (endpoint.from_sockaddr(it->ai_addr) &&
+                std::find(endpoints.begin(), endpoints.end(), endpoint) == endpoints.end())
+            {
+                endpoints.push_back(endpoint);
+            }
+        }
+        freeaddrinfo(results);
+        return endpoints;
+    }
+
+    // Called with mutex_ held
+    void start_workers()
+    {
+        while (workers_.size() < (std::max<size_t>)(config_.threads, 1))
+        {
+            workers_.emplace_back(&Resolver::worker_loop, this);
+        }
+    }
+
+    void worker_loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            work_ready_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (stopping_)
+            {
+                return;
+            }
+
+            std::string host = std::move(queue_.front());
+            queue_.pop_front();
+
+            lock.unlock();
+            std::vector<Endpoint> endpoints = lookup(host);
+            lock.lock();
+
+            if (cache_.size() >= config_.max_entries)
+            {
+                cache_.clear();
+            }
+            auto ttl = endpoints.empty() ? config_.negative_ttl : config_.ttl;
+            cache_[host] = {endpoints, std::chrono::steady_clock::now() + ttl};
+
+            std::vector<Waiter> waiters = std::move(pending_[host]);
+            pending_.erase(host);
+
+            lock.unlock();
+            for (auto& waiter : waiters)
+            {
+                waiter.callback(with_port(endpoints, waiter.port));
+            }
+            lock.lock();
+        }
+    }
+
+    ResolverConfig config_;
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::deque<std::string> queue_;                                 // hosts waiting for a worker
+    std::unordered_map<std::string, std::vector<Waiter>> pending_;  // callbacks per in-flight host
+    std::unordered_map<std::string, CacheEntry> cache_;
+    std::vector<std::thread> workers_;                              // started on the first lookup
+    bool stopping_ = false;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+} // namespace slick::socket
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <slick/socket/buffer_pool.h>
+#include <slick/socket/cache_line.h>
+
+namespace slick::socket
+{
+
+// How an event loop waits when it has nothing to do
+enum class PollingStrategy : uint8_t
+{
+    Auto,       // busy-poll when the loop thread is pinned (cpu_affinity >= 0), block otherwise
+    Blocking,   // always block in epoll/kqueue until an event or wake-up
+    BusyPoll,   // never block; lowest latency, one core fully used
+};
+
+// Compile-time configuration of TCPServerBase, TCPClientBase and MulticastReceiverBase.
+// Derive from this struct and override the members that should differ, e.g.
+//
+//     struct FeedTraits : slick::socket::DefaultSocketTraits
+//     {
+//         static constexpr size_t receive_buffer_size = 2048;
+//         static constexpr bool enable_logging = false;
+//         static constexpr PollingStrategy polling = PollingStrategy::BusyPoll;
+//     };
+//     class FeedHandler : public slick::socket::MulticastReceiverBase<FeedHandler, FeedTraits> { ... };
+struct DefaultSocketTraits
+{
+    // > 0: the loop receives into a fixed array of this size and config.receive_buffer_size is ignored.
+    // 0: the size comes from the config and the buffer from BufferPool.
+    static constexpr size_t receive_buffer_size = 0;
+
+    // Events taken from epoll/kqueue per wait
+    static constexpr int max_events = 64;
+
+    // Packet, byte and error counters (MulticastReceiverBase)
+    static constexpr bool enable_stats = true;
+
+    // Per-message LOG_DEBUG/LOG_TRACE calls and their formatting in the I/O path
+    static constexpr bool enable_logging = true;
+
+    // Record when each batch of events was returned by the wait (TscClock), see last_receive_time()
+    static constexpr bool enable_timestamps = false;
+
+    // Publish what the loop is running and time every user callback, see get_loop_monitor() and Watchdog
+    static constexpr bool enable_loop_monitor = false;
+
+    // Record wait, recv, send, flush and callback spans into per-thread rings, see Tracer
+    static constexpr bool enable_tracing = false;
+
+    static constexpr PollingStrategy polling = PollingStrategy::Auto;
+};
+
+// Receive buffer embedded in the loop's stack frame
+template<size_t N>
+class FixedBuffer
+{
+public:
+    uint8_t* data() noexcept { return data_; }
+    const uint8_t* data() const noexcept { return data_; }
+    static constexpr size_t size() noexcept { return N; }
+    static constexpr size_t capacity() noexcept { return N; }
+
+private:
+    alignas(cache_line_size) uint8_t data_[N];
+};
+
+template<typename TraitsT>
+using ReceiveBuffer = std::conditional_t<(TraitsT::receive_buffer_size > 0),
+                                         FixedBuffer<(TraitsT::receive_buffer_size > 0 ? TraitsT::receive_buffer_size : 1)>,
+                                         PooledBuffer>;
+
+template<typename TraitsT>
+inline ReceiveBuffer<TraitsT> make_receive_buffer(size_t configured_size)
+{
+    if constexpr (TraitsT::receive_buffer_size > 0)
+    {
+        return ReceiveBuffer<TraitsT>{};
+    }
+    else
+    {
+        return configured_size ? BufferPool::instance().acquire(configured_size) : PooledBuffer{};
+    }
+}
+
+// epoll/kqueue timeout for an idle wait: 0 busy-polls, -1 blocks
+template<typename TraitsT>
+inline int idle_wait_timeout(bool pinned) noexcept
+{
+    if constexpr (TraitsT::polling == PollingStrategy::BusyPoll)
+    {
+        return 0;
+    }
+    else if constexpr (TraitsT::polling == PollingStrategy::Blocking)
+    {
+        return -1;
+    }
+    else
+    {
+        return pinned ? 0 : -1;
+    }
+}
+
+} // namespace slick::socket
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace slick::socket
+{
+
+// Work posted from other threads, executed on an event loop thread.
+// push() is thread-safe; run_all() must only be called by the owning loop.
+class TaskQueue
+{
+public:
+    void push(std::function<void()> task)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(std::move(task));
+        has_pending_.store(true, std::memory_order_release);
+    }
+
+    bool empty() const noexcept
+    {
+        return !has_pending_.load(std::memory_order_acquire);
+    }
+
+    // Returns the number of tasks executed
+    size_t run_all()
+    {
+        if (empty())
+        {
+            return 0;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_.swap(pending_);
+            has_pending_.store(false, std::memory_order_release);
+        }
+
+        for (auto& task : running_)
+        {
+            task();
+        }
+        size_t count = running_.size();
+        running_.clear();
+        return count;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.clear();
+        has_pending_.store(false, std::memory_order_release);
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::function<void()>> pending_;
+    std::vector<std::function<void()>> running_;   // owned by the loop thread
+    std::atomic_bool has_pending_{false};
+};
+
+} // namespace slick::socket
@@ -23,12 +23,35 @@
 #pragma once
 
 #include <slick/socket/logger.h>
+#include <slick/socket/buffer_pool.h>
+#include <slick/socket/cache_line.h>
+#include <slick/socket/clock.h>
+#include <slick/socket/const_buffer.h>
+#include <slick/socket/endpoint.h>
+#include <slick/socket/socket_traits.h>
+#include <slick/socket/numa.h>
+#include <slick/socket/resolver.h>
+#include <slick/socket/task_queue.h>
+#include <slick/socket/heartbeat.h>
+#include <slick/socket/tcp_health.h>
+#include <slick/socket/tls.h>
+#include <slick/socket/trace.h>
+#include <slick/socket/watchdog.h>
+#include <algorithm>
 #include <vector>
 #include <thread>
 #include <string>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <span>
 
 #if defined(_WIN32) || defined(_WIN64)
 #include <winsock2.h>
+#else
+#include <slick/socket/event_notifier.h>
+#include <slick/socket/event_poller.h>
 #endif
 
 namespace slick::socket
@@ -36,14 +59,21 @@ namespace slick::socket
 
 struct TCPClientConfig
 {
-    std::string server_address = "localhost";
+    std::string server_address = "localhost";  // Host name or numeric IPv4/IPv6 address ("10.0.0.1", "fe80::1%eth0")
     uint16_t server_port = 5000;
     int receive_buffer_size = 4096;
     std::chrono::milliseconds connection_timeout{30000};
     int cpu_affinity = -1;  // -1 means no affinity, otherwise specify CPU core index
+    int numa_node = -1;         // NUMA node for the client thread and its buffers, -1 = none
+    std::string numa_interface; // Detect numa_node from this NIC (name or local IPv4 address) when numa_node is -1
+    std::chrono::milliseconds tcp_info_interval{0};  // TCP_INFO sampling period, 0 = disabled (Linux only)
+    TCPHealthThresholds health_thresholds;          // onConnectionHealthAlert() fires when a sample crosses these
+    bool fast_open = false;  // TCP Fast Open (Linux): the first payload rides the SYN once a cookie is cached
+    HeartbeatConfig heartbeat;  // Heartbeat frames when idle and server silence timeout, run by the client thread
+    TLSConfig tls;              // TLS with kTLS offload (Unix, SLICK_SOCKET_ENABLE_TLS); connect() returns after the handshake
 };
 
-template<typename DerivedT>
+template<typename DerivedT, typename TraitsT = DefaultSocketTraits>
 class TCPClientBase
 {
 public:
@@ -58,7 +88,16 @@ public:
     TCPClientBase(TCPClientBase&& other) noexcept = default;
     TCPClientBase& operator=(TCPClientBase&& other) noexcept = default;
 
-    bool connect();
+    bool connect()
+    {
+        return connect(std::vector<uint8_t>{});
+    }
+
+    // Connect and send first_payload. With config.fast_open the payload is carried in the SYN
+    // (MSG_FASTOPEN); without it, or without a cached cookie, it is sent once connected.
+    // With fast_open and no payload, the SYN is deferred until the first send_data() when the
+    // server resolves to a single address; several addresses are raced with real handshakes.
+    bool connect(const std::vector<uint8_t>& first_payload);
     void disconnect();
     
     bool is_connected() const noexcept
@@ -66,6 +105,25 @@ public:
         return connected_.load(std::memory_order_relaxed);
     }
 
+    // Latest TCP_INFO sample of the connection. Safe to call from any thread.
+    // Derived classes may implement onConnectionHealthAlert(const TCPConnectionHealth&),
+    // called on the client thread when a sample starts exceeding config.health_thresholds.
+    TCPConnectionHealth get_connection_health() const
+    {
+        std::lock_guard<std::mutex> lock(health_mutex_);
+        return health_;
+    }
+
+    // Run a task on the client thread. Safe to call from any thread; the loop is woken immediately.
+    void post(std::function<void()> task);
+
+    // Which directions of the TLS session run in the kernel. Safe to call from any thread.
+    TLSOffload get_tls_offload() const
+    {
+        std::lock_guard<std::mutex> lock(tls_mutex_);
+        return tls_.offload();
+    }
+
     bool send_data(const std::vector<uint8_t>& data);
     bool send_data(const std::string& data)
     {
@@ -73,6 +131,16 @@ public:
         return send_data(buffer);
     }
 
+    // Gathered send: the buffers go out with writev/WSASend, in order, without being concatenated
+    bool send_data(std::span<const ConstBuffer> buffers);
+
+    // What the client thread is running and how long its callbacks take (TraitsT::enable_loop_monitor)
+    const LoopMonitor& get_loop_monitor() const noexcept
+        requires TraitsT::enable_loop_monitor
+    {
+        return loop_monitor_;
+    }
+
 protected:
 #if defined(_WIN32) || defined(_WIN64)
     using SocketT = SOCKET;
@@ -85,14 +153,184 @@ protected:
     DerivedT& derived() { return static_cast<DerivedT&>(*this); }
     const DerivedT& derived() const { return static_cast<const DerivedT&>(*this); }
 
+    // Candidates for config_.server_address. Host names are resolved by Resolver (cached) while
+    // connect() waits on the caller's thread; the client loop only starts once connected.
+    std::vector<Endpoint> resolve_server_candidates()
+    {
+        std::vector<Endpoint> candidates =
+            Resolver::instance().resolve_wait(config_.server_address, config_.server_port, config_.connection_timeout);
+        if (candidates.empty())
+        {
+            LOG_ERROR("Failed to resolve server address: {}", config_.server_address);
+        }
+        return candidates;
+    }
+
+#if defined(_WIN32) || defined(_WIN64)
+    bool connect_socket();
+    SocketT start_connect(const Endpoint& endpoint);
+#else
+    // Non-blocking socket with a connect in flight to endpoint, invalid_socket on failure.
+    // With config_.fast_open and a payload, part of it may ride the SYN (payload_sent).
+    // defer_syn allows TCP_FASTOPEN_CONNECT, whose connect() completes before any handshake.
+    SocketT start_connect(const Endpoint& endpoint, const std::vector<uint8_t>* first_payload, size_t& payload_sent,
+                          bool defer_syn);
+#endif
+#if !defined(_WIN32) && !defined(_WIN64)
+    // TLS handshake on the connected socket_, polled until deadline
+    bool establish_tls(std::chrono::steady_clock::time_point deadline);
+
+    // send()/recv() on the plain socket or through the TLS session. OpenSSL sessions are not
+    // safe for concurrent use, so sends from other threads and the loop's reads take tls_mutex_.
+    ssize_t transmit(const void* data, size_t size)
+    {
+        if (config_.tls.enabled)
+        {
+            std::lock_guard<std::mutex> lock(tls_mutex_);
+            if (!tls_)
+            {
+                errno = ENOTCONN;
+                return -1;
+            }
+            return tls_.write(data, size);
+        }
+        return ::send(socket_, data, size, MSG_NOSIGNAL);
+    }
+
+    ssize_t receive(void* data, size_t size)
+    {
+        if (config_.tls.enabled)
+        {
+            std::lock_guard<std::mutex> lock(tls_mutex_);
+            return tls_.read(data, size);
+        }
+        return ::recv(socket_, data, size, 0);
+    }
+#endif
     void client_loop();
     void handle_server_data(std::vector<uint8_t>& buffer);
+    void sample_connection_health();
+
+    // Client thread: one non-blocking attempt at the heartbeat frame, skipped while an application
+    // send holds send_mutex_ or the socket is full. Bytes of a frame the socket took only part of
+    // are kept in heartbeat_tail_ and go out ahead of the next send, so the stream stays framed.
+    void send_heartbeat();
+    // send_mutex_ held: completes heartbeat_tail_ before application data, waiting like send_data()
+    bool flush_heartbeat_tail();
+
+    // Client thread: sends the heartbeat frame when nothing was sent for idle_interval and ends the
+    // connection after peer_timeout without data. Returns the milliseconds until the next check
+    // is due, -1 when heartbeats are off.
+    int service_heartbeat()
+    {
+        const HeartbeatConfig& heartbeat = config_.heartbeat;
+        const auto now = std::chrono::steady_clock::now();
+        int due_ms = -1;
+        auto next_due = [&](std::chrono::steady_clock::time_point deadline) {
+            int ms = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count());
+            due_ms = due_ms < 0 ? ms : (std::min)(due_ms, ms);
+        };
+
+        if (heartbeat.checks_peer())
+        {
+            if (now >= last_inbound_ + heartbeat.peer_timeout)
+            {
+                LOG_WARN("{} heartbeat timeout: nothing received for {} ms", name_, heartbeat.peer_timeout.count());
+                if constexpr (requires { derived().onHeartbeatTimeout(); })
+                {
+                    auto timing = callback_scope(LoopCallback::Heartbeat, -1);
+                    derived().onHeartbeatTimeout();
+                }
+                connected_.store(false, std::memory_order_release);
+                return 0;
+            }
+            next_due(last_inbound_ + heartbeat.peer_timeout);
+        }
+
+        if (heartbeat.sends())
+        {
+            auto deadline = std::chrono::steady_clock::time_point(
+                std::chrono::steady_clock::duration(last_outbound_.load(std::memory_order_relaxed))) + heartbeat.idle_interval;
+            if (now >= deadline)
+            {
+                // Re-armed first so a failing send is not retried on every iteration
+                last_outbound_.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+                send_heartbeat();
+                deadline = now + heartbeat.idle_interval;
+            }
+            next_due(deadline);
+        }
+        return due_ms;
+    }
 
+    void note_outbound() noexcept
+    {
+        if (config_.heartbeat.sends())
+        {
+            last_outbound_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        }
+    }
+
+    // Time the current batch of events was returned by the wait (loop thread, TraitsT::enable_timestamps)
+    std::chrono::steady_clock::time_point last_receive_time() const noexcept
+        requires TraitsT::enable_timestamps
+    {
+        return receive_time_;
+    }
+
+    void stamp_receive_time() noexcept
+    {
+        if constexpr (TraitsT::enable_timestamps)
+        {
+            receive_time_ = TscClock::now();
+        }
+    }
+
+    // Times a user callback for the loop monitor and the trace until the result goes out of scope
+    CallbackScope<TraitsT> callback_scope(LoopCallback callback, int client_id) noexcept
+    {
+        return {loop_monitor_.callback_scope(callback, client_id),
+                TraceSpanFor<TraitsT>(TraceKind::Callback, client_id, callback)};
+    }
+
+    // Grouped by writer, one cache line apart, as in TCPServerBase
+
+    // Cold: set up before the loop starts
     std::string name_;
     TCPClientConfig config_;
-    std::atomic_bool connected_{false};
     std::thread client_thread_;
-    SocketT socket_ = invalid_socket;
+    TLSContext tls_context_;            // opened by the first TLS connect()
+    TLSSession tls_;                    // guarded by tls_mutex_
+    mutable std::mutex tls_mutex_;
+
+    // Polled by the loop and by any thread calling is_connected()
+    alignas(cache_line_size) std::atomic_bool connected_{false};
+
+    // Written by every thread that calls post()
+    alignas(cache_line_size) TaskQueue tasks_;
+
+    // Client thread, read by a Watchdog; empty without TraitsT::enable_loop_monitor
+    LoopMonitorFor<TraitsT> loop_monitor_;
+
+    // Written by every thread that calls send_data(). With heartbeat frames enabled the client
+    // thread sends too, so sends are serialized by send_mutex_.
+    alignas(cache_line_size) std::mutex send_mutex_;
+    std::atomic<std::chrono::steady_clock::rep> last_outbound_{0};
+    std::vector<uint8_t> heartbeat_tail_;   // guarded by send_mutex_
+
+    // Written by the client thread on each sample, read by get_connection_health()
+    alignas(cache_line_size) mutable std::mutex health_mutex_;
+    TCPConnectionHealth health_;    // guarded by health_mutex_
+
+    // Client thread only
+    alignas(cache_line_size) SocketT socket_ = invalid_socket;
+    bool health_alert_ = false;
+    std::chrono::steady_clock::time_point last_inbound_{};   // heartbeat peer_timeout reference
+    std::chrono::steady_clock::time_point receive_time_{};   // written only with TraitsT::enable_timestamps
+#if !defined(_WIN32) && !defined(_WIN64)
+    EventPoller poller_;
+    EventNotifier wakeup_;  // wakes client_loop() for disconnect() and posted tasks
+#endif
 };
 
 } // namespace slick::socket
@@ -9,133 +9,315 @@
 #include "tcp_client.h"
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <csignal>
 #include <cstring>
 #include <pthread.h>
+#include <poll.h>
 
 namespace slick::socket
 {
 
-template<typename DerivedT>
-inline TCPClientBase<DerivedT>::TCPClientBase(std::string name, const TCPClientConfig& config)
+template<typename DerivedT, typename TraitsT>
+inline TCPClientBase<DerivedT, TraitsT>::TCPClientBase(std::string name, const TCPClientConfig& config)
     : name_(std::move(name)),config_(config)
 {
     // Ignore SIGPIPE to prevent crashes when writing to closed sockets
     std::signal(SIGPIPE, SIG_IGN);
 }
 
-template<typename DerivedT>
-inline TCPClientBase<DerivedT>::~TCPClientBase()
+template<typename DerivedT, typename TraitsT>
+inline TCPClientBase<DerivedT, TraitsT>::~TCPClientBase()
 {
     disconnect();
 }
 
-template<typename DerivedT>
-inline bool TCPClientBase<DerivedT>::connect()
+template<typename DerivedT, typename TraitsT>
+inline bool TCPClientBase<DerivedT, TraitsT>::connect(const std::vector<uint8_t>& first_payload)
 {
     if (connected_.load(std::memory_order_relaxed))
     {
         return true;
     }
 
-    // Create socket
-    socket_ = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    if (socket_ == invalid_socket)
+    if (config_.tls.enabled && !tls_context_ && !tls_context_.open(config_.tls, false))
     {
-        LOG_ERROR("Failed to create socket: {}", std::strerror(errno));
         return false;
     }
 
-    // Make socket non-blocking
-    int flags = fcntl(socket_, F_GETFL, 0);
-    if (flags < 0 || fcntl(socket_, F_SETFL, flags | O_NONBLOCK) < 0)
+    std::vector<Endpoint> candidates = resolve_server_candidates();
+    if (candidates.empty())
     {
-        LOG_WARN("Failed to make socket non-blocking: {}", std::strerror(errno));
         return false;
     }
 
-    // Set up server address
-    sockaddr_in server_addr{};
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(config_.server_port);
+    // A payload can only ride the SYN when there is a single server to send it to. With TLS the
+    // payload is application data and waits for the handshake; Fast Open then carries the ClientHello.
+    // Several candidates need real handshakes to pick a winner, so the SYN is never deferred then.
+    const bool single_candidate = candidates.size() == 1;
+    const std::vector<uint8_t>* syn_payload = single_candidate && !config_.tls.enabled ? &first_payload : nullptr;
+    size_t payload_sent = 0;
 
-    // Resolve server address
-    if (inet_pton(AF_INET, config_.server_address.c_str(), &server_addr.sin_addr) != 1)
+    std::vector<pollfd> attempts;
+    std::vector<Endpoint> attempt_endpoints;
+    for (const Endpoint& candidate : candidates)
     {
-        LOG_ERROR("Failed to resolve server address: {}", config_.server_address);
-        close(socket_);
-        socket_ = invalid_socket;
-        return false;
+        int s = start_connect(candidate, syn_payload, payload_sent, single_candidate);
+        if (s != invalid_socket)
+        {
+            attempts.push_back({s, POLLOUT, 0});
+            attempt_endpoints.push_back(candidate);
+        }
     }
 
-    LOG_INFO("Attempting to connect to {}:{}", config_.server_address, config_.server_port);
+    // All candidates are dialled at once; the first to complete wins and the others are closed
+    auto deadline = std::chrono::steady_clock::now() + config_.connection_timeout;
+    while (socket_ == invalid_socket && !attempts.empty())
+    {
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            break;
+        }
+        int ready = poll(attempts.data(), attempts.size(), static_cast<int>(remaining.count()));
+        if (ready < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (ready <= 0)
+        {
+            break;
+        }
 
-    // Attempt to connect (non-blocking)
-    int result = ::connect(socket_, (sockaddr*)&server_addr, sizeof(server_addr));
-    if (result < 0 && errno != EINPROGRESS)
+        for (size_t i = 0; i < attempts.size();)
+        {
+            if (attempts[i].revents == 0)
+            {
+                ++i;
+                continue;
+            }
+
+            // Check if connection was successful
+            int error = 0;
+            socklen_t len = sizeof(error);
+            if (getsockopt(attempts[i].fd, SOL_SOCKET, SO_ERROR, &error, &len) == 0 && error == 0)
+            {
+                socket_ = attempts[i].fd;
+                LOG_INFO("Connected to {}", attempt_endpoints[i].to_string());
+                attempts.erase(attempts.begin() + i);
+                break;
+            }
+
+            LOG_WARN("Connection to {} failed: {}", attempt_endpoints[i].to_string(), std::strerror(error));
+            close(attempts[i].fd);
+            attempts.erase(attempts.begin() + i);
+            attempt_endpoints.erase(attempt_endpoints.begin() + i);
+        }
+    }
+
+    for (const pollfd& attempt : attempts)
+    {
+        close(attempt.fd);
+    }
+    if (socket_ == invalid_socket)
+    {
+        LOG_WARN("Connection timeout or failed");
+        return false;
+    }
+
+    if (config_.tls.enabled && !establish_tls(deadline))
     {
-        LOG_WARN("Failed to connect to server: {}", std::strerror(errno));
         close(socket_);
         socket_ = invalid_socket;
         return false;
     }
 
-    // Wait for connection to complete
-    fd_set write_fds;
-    FD_ZERO(&write_fds);
-    FD_SET(socket_, &write_fds);
-
-    struct timeval timeout;
-    timeout.tv_sec = config_.connection_timeout.count() / 1000;
-    timeout.tv_usec = (config_.connection_timeout.count() % 1000) * 1000;
+    // Reap the thread of a previous connection that ended on its own
+    if (client_thread_.joinable())
+    {
+        client_thread_.join();
+    }
 
-    result = select(socket_ + 1, nullptr, &write_fds, nullptr, &timeout);
-    if (result <= 0)
+    // The poller and wake-up descriptor are kept across reconnects
+    if (!poller_.is_open() && (!wakeup_.open() || !poller_.open() || !poller_.add(wakeup_.fd(), true, false)))
     {
-        LOG_WARN("Connection timeout or failed");
+        LOG_ERROR("Failed to set up event polling: {}", std::strerror(errno));
+        poller_.close();
         close(socket_);
         socket_ = invalid_socket;
         return false;
     }
 
-    // Check if connection was successful
-    int error = 0;
-    socklen_t len = sizeof(error);
-    if (getsockopt(socket_, SOL_SOCKET, SO_ERROR, &error, &len) < 0 || error != 0)
+    if (!poller_.add(socket_, true, false))
     {
-        LOG_WARN("Connection failed: {}", std::strerror(error));
+        LOG_ERROR("Failed to add socket to event poller: {}", std::strerror(errno));
         close(socket_);
         socket_ = invalid_socket;
         return false;
     }
 
+    heartbeat_tail_.clear();    // belonged to the previous connection's stream
     connected_.store(true, std::memory_order_release);
+
+    // Whatever did not ride the SYN goes out now, ahead of any other data
+    if (payload_sent < first_payload.size())
+    {
+        std::vector<uint8_t> remainder(first_payload.begin() + payload_sent, first_payload.end());
+        if (!send_data(remainder))
+        {
+            connected_.store(false, std::memory_order_release);
+            poller_.remove(socket_);
+            close(socket_);
+            socket_ = invalid_socket;
+            return false;
+        }
+    }
+
     client_thread_ = std::thread(&TCPClientBase::client_loop, this);
     derived().onConnected();
     return true;
 }
 
-template<typename DerivedT>
-inline void TCPClientBase<DerivedT>::disconnect()
+template<typename DerivedT, typename TraitsT>
+inline bool TCPClientBase<DerivedT, TraitsT>::establish_tls(std::chrono::steady_clock::time_point deadline)
+{
+    std::lock_guard<std::mutex> lock(tls_mutex_);
+    const std::string& host = config_.tls.server_name.empty() ? config_.server_address : config_.tls.server_name;
+    Endpoint numeric;
+    bool host_is_name = !Endpoint::parse(host, 0, numeric);
+    if (!tls_.open(tls_context_, socket_, false, host_is_name ? host : std::string()))
+    {
+        return false;
+    }
+
+    while (true)
+    {
+        TLSHandshakeStatus status = tls_.handshake();
+        if (status == TLSHandshakeStatus::Done)
+        {
+            LOG_INFO("TLS established, kernel offload send={} receive={}", tls_.kernel_send(), tls_.kernel_receive());
+            return true;
+        }
+        if (status == TLSHandshakeStatus::Failed)
+        {
+            break;
+        }
+
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            LOG_WARN("TLS handshake timed out");
+            break;
+        }
+        pollfd wait{socket_, static_cast<short>(status == TLSHandshakeStatus::WantRead ? POLLIN : POLLOUT), 0};
+        if (poll(&wait, 1, static_cast<int>(remaining.count())) < 0 && errno != EINTR)
+        {
+            break;
+        }
+    }
+    tls_.reset();
+    return false;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline int TCPClientBase<DerivedT, TraitsT>::start_connect(const Endpoint& endpoint,
+                                                           const std::vector<uint8_t>* first_payload,
+                                                           size_t& payload_sent, bool defer_syn)
+{
+    // Create socket
+    int s = ::socket(endpoint.socket_family(), SOCK_STREAM, IPPROTO_TCP);
+    if (s == invalid_socket)
+    {
+        LOG_ERROR("Failed to create socket: {}", std::strerror(errno));
+        return invalid_socket;
+    }
+
+    // Make socket non-blocking
+    int flags = fcntl(s, F_GETFL, 0);
+    if (flags < 0 || fcntl(s, F_SETFL, flags | O_NONBLOCK) < 0)
+    {
+        LOG_WARN("Failed to make socket non-blocking: {}", std::strerror(errno));
+        close(s);
+        return invalid_socket;
+    }
+
+    sockaddr_storage server_addr{};
+    socklen_t server_addr_len = endpoint.to_sockaddr(server_addr);
+
+    LOG_INFO("Attempting to connect to {}", endpoint.to_string());
+
+    bool connect_issued = false;
+    if (config_.fast_open)
+    {
+#if defined(MSG_FASTOPEN)
+        if (first_payload && !first_payload->empty())
+        {
+            // Implicit connect: SYN carries as much of the payload as the cookie allows.
+            // EINPROGRESS means the SYN left without data (no cookie yet).
+            ssize_t sent = sendto(s, first_payload->data(), first_payload->size(), MSG_FASTOPEN | MSG_NOSIGNAL,
+                                  (sockaddr*)&server_addr, server_addr_len);
+            if (sent >= 0 || errno == EINPROGRESS)
+            {
+                payload_sent = sent > 0 ? static_cast<size_t>(sent) : 0;
+                connect_issued = true;
+            }
+            else
+            {
+                LOG_WARN("TCP Fast Open send failed, falling back to connect: {}", std::strerror(errno));
+            }
+        }
+#endif
+#if defined(TCP_FASTOPEN_CONNECT)
+        if (!connect_issued && defer_syn)
+        {
+            // connect() returns at once; the first send_data() emits SYN+data
+            int enable = 1;
+            if (setsockopt(s, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &enable, sizeof(enable)) < 0)
+            {
+                LOG_WARN("Failed to set TCP_FASTOPEN_CONNECT: {}", std::strerror(errno));
+            }
+        }
+#elif !defined(MSG_FASTOPEN)
+        LOG_WARN("TCP Fast Open not supported on this platform");
+#endif
+    }
+
+    // Attempt to connect (non-blocking)
+    if (!connect_issued && ::connect(s, (sockaddr*)&server_addr, server_addr_len) < 0 && errno != EINPROGRESS)
+    {
+        LOG_WARN("Failed to connect to {}: {}", endpoint.to_string(), std::strerror(errno));
+        close(s);
+        return invalid_socket;
+    }
+    return s;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPClientBase<DerivedT, TraitsT>::disconnect()
 {
     if (!connected_.load(std::memory_order_relaxed))
     {
+        // The peer may have closed the connection; reap the finished client thread
+        if (client_thread_.joinable() && client_thread_.get_id() != std::this_thread::get_id())
+        {
+            client_thread_.join();
+        }
         return;
     }
 
     connected_.store(false, std::memory_order_release);
+    wakeup_.notify();
 
-    // Close socket if open
-    if (socket_ != invalid_socket)
+    // Called from a callback: the loop exits on its own and closes the socket
+    if (client_thread_.get_id() == std::this_thread::get_id())
     {
-        close(socket_);
-        socket_ = invalid_socket;
+        return;
     }
 
-    // Wait for client thread to finish
+    // Wait for client thread to finish; it owns the socket and closes it on exit
     if (client_thread_.joinable())
     {
         client_thread_.join();
@@ -144,10 +326,21 @@ inline void TCPClientBase<DerivedT>::disconnect()
     LOG_INFO("TCP client disconnected");
 }
 
-template<typename DerivedT>
-inline void TCPClientBase<DerivedT>::client_loop()
+template<typename DerivedT, typename TraitsT>
+inline void TCPClientBase<DerivedT, TraitsT>::post(std::function<void()> task)
+{
+    tasks_.push(std::move(task));
+    wakeup_.notify();
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPClientBase<DerivedT, TraitsT>::client_loop()
 {
     LOG_INFO("Client loop started");
+    if constexpr (TraitsT::enable_tracing)
+    {
+        Tracer::attach_thread(name_);
+    }
 
     // Set CPU affinity if specified
 #ifndef __APPLE__
@@ -176,56 +369,209 @@ inline void TCPClientBase<DerivedT>::client_loop()
     }
 #endif
 
+    // Keep the loop thread, its buffers and its connection state on one NUMA node
+    int numa_node = resolve_numa_node(config_.numa_node, config_.numa_interface);
+    if (numa_node >= 0)
+    {
+        if (config_.cpu_affinity < 0 && !pin_thread_to_numa_node(numa_node))
+        {
+            LOG_WARN("Failed to pin client thread to NUMA node {}", numa_node);
+        }
+        if (!prefer_numa_node_for_thread(numa_node))
+        {
+            LOG_WARN("Failed to set memory policy for NUMA node {}", numa_node);
+        }
+        BufferPool::instance().set_thread_node(numa_node);
+        LOG_INFO("Client thread placed on NUMA node {}", numa_node);
+    }
+    else if (!config_.numa_interface.empty())
+    {
+        LOG_WARN("NUMA node of {} unknown, client thread left unplaced", config_.numa_interface);
+    }
+
     // Connection established - handle server communication
-    std::vector<uint8_t> buffer(config_.receive_buffer_size);
+    auto buffer = make_receive_buffer<TraitsT>(config_.receive_buffer_size);
+
+    // Busy-poll or block until data or a wake-up arrives, as chosen by TraitsT::polling
+    const int timeout_ms = idle_wait_timeout<TraitsT>(config_.cpu_affinity >= 0);
+    EventPoller::Event events[2];
+
+    {
+        std::lock_guard<std::mutex> lock(health_mutex_);
+        health_ = TCPConnectionHealth{};
+    }
+    health_alert_ = false;
+    const bool sample_health = config_.tcp_info_interval.count() > 0;
+    auto next_health_sample = std::chrono::steady_clock::now();
+    last_inbound_ = std::chrono::steady_clock::now();
+    note_outbound();
 
     while (connected_.load(std::memory_order_relaxed))
     {
-        // Check for incoming data (non-blocking)
-        ssize_t received = recv(socket_, (char*)buffer.data(), buffer.size(), 0);
+        int wait_ms = timeout_ms;
+        if (sample_health)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= next_health_sample)
+            {
+                sample_connection_health();
+                next_health_sample = now + config_.tcp_info_interval;
+            }
+            if (wait_ms != 0)
+            {
+                wait_ms = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(next_health_sample - now).count());
+            }
+        }
 
-        if (received > 0)
+        if (config_.heartbeat.enabled())
         {
-            // Process received data
-            derived().onData(buffer.data(), received);
-            continue;
+            int due_ms = service_heartbeat();
+            if (!connected_.load(std::memory_order_relaxed))
+            {
+                break;
+            }
+            if (due_ms >= 0 && wait_ms != 0 && (wait_ms < 0 || due_ms < wait_ms))
+            {
+                wait_ms = due_ms;
+            }
         }
-        else if (received == 0)
+
+        loop_monitor_.loop_idle();
+        TraceSpanFor<TraitsT> wait_span(TraceKind::Wait);
+        int num_events = poller_.wait(events, 2, wait_ms);
+        loop_monitor_.loop_busy();
+        wait_span.end_or_discard(num_events);
+        if (num_events < 0)
         {
-            // Server closed connection
-            LOG_INFO("Server closed connection");
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LOG_ERROR("Event wait failed: {}", std::strerror(errno));
             connected_.store(false, std::memory_order_release);
             break;
         }
-        else
+        if (num_events > 0)
+        {
+            stamp_receive_time();
+        }
+
+        for (int i = 0; i < num_events; ++i)
         {
-            // Error or would block
-            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            if (events[i].fd == wakeup_.fd())
+            {
+                wakeup_.drain();
+                auto timing = callback_scope(LoopCallback::Task, -1);
+                tasks_.run_all();
+                continue;
+            }
+
+            // Check for incoming data (non-blocking). A TLS session may hold decrypted records
+            // the socket no longer signals, so it is read until it needs the socket again.
+            while (true)
             {
-                LOG_ERROR("Receive error: {}", std::strerror(errno));
-                connected_.store(false, std::memory_order_release);
+                TraceSpanFor<TraitsT> receive_span(TraceKind::Receive);
+                ssize_t received = receive(buffer.data(), buffer.size());
+                receive_span.end(received);
+
+                if (received > 0)
+                {
+                    if (config_.heartbeat.checks_peer())
+                    {
+                        last_inbound_ = std::chrono::steady_clock::now();
+                    }
+
+                    // Process received data
+                    {
+                        auto timing = callback_scope(LoopCallback::Data, -1);
+                        derived().onData(buffer.data(), received);
+                    }
+                    if (config_.tls.enabled && connected_.load(std::memory_order_relaxed))
+                    {
+                        continue;
+                    }
+                }
+                else if (received == 0)
+                {
+                    // Server closed connection
+                    LOG_INFO("Server closed connection");
+                    connected_.store(false, std::memory_order_release);
+                }
+                else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                {
+                    LOG_ERROR("Receive error: {}", std::strerror(errno));
+                    connected_.store(false, std::memory_order_release);
+                }
                 break;
             }
         }
     }
 
-    derived().onDisconnected();
+    {
+        auto timing = callback_scope(LoopCallback::Disconnected, -1);
+        derived().onDisconnected();
+    }
+    loop_monitor_.loop_idle();
 
     // Connection lost - clean up
+    if (config_.tls.enabled)
+    {
+        std::lock_guard<std::mutex> lock(tls_mutex_);
+        tls_.shutdown();
+        tls_.reset();
+    }
+    poller_.remove(socket_);
     close(socket_);
     socket_ = invalid_socket;
     LOG_INFO("Client loop ended");
 }
 
-template<typename DerivedT>
-inline void TCPClientBase<DerivedT>::handle_server_data(std::vector<uint8_t>& buffer)
+template<typename DerivedT, typename TraitsT>
+inline void TCPClientBase<DerivedT, TraitsT>::sample_connection_health()
+{
+    TCPConnectionHealth health;
+    {
+        std::lock_guard<std::mutex> lock(health_mutex_);
+        health = health_;
+    }
+
+    if (!sample_tcp_info(socket_, health))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(health_mutex_);
+        health_ = health;
+    }
+
+    bool alert = exceeds_thresholds(health, config_.health_thresholds);
+    bool crossed = alert && !health_alert_;
+    health_alert_ = alert;
+    if (crossed)
+    {
+        LOG_WARN("{} health alert: rtt={}us unacked={} retransmits={}", name_,
+                 health.rtt_us, health.unacked, health.retransmits_since_last);
+        if constexpr (requires { derived().onConnectionHealthAlert(health); })
+        {
+            auto timing = callback_scope(LoopCallback::HealthAlert, -1);
+            derived().onConnectionHealthAlert(health);
+        }
+    }
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPClientBase<DerivedT, TraitsT>::handle_server_data(std::vector<uint8_t>& buffer)
 {
     // Default implementation - derived classes should override this
-    LOG_DEBUG("Received {} bytes from server", buffer.size());
+    if constexpr (TraitsT::enable_logging)
+    {
+        LOG_DEBUG("Received {} bytes from server", buffer.size());
+    }
 }
 
-template<typename DerivedT>
-inline bool TCPClientBase<DerivedT>::send_data(const std::vector<uint8_t>& data)
+template<typename DerivedT, typename TraitsT>
+inline bool TCPClientBase<DerivedT, TraitsT>::send_data(const std::vector<uint8_t>& data)
 {
     if (!connected_.load(std::memory_order_relaxed) || socket_ == invalid_socket)
     {
@@ -239,6 +585,17 @@ inline bool TCPClientBase<DerivedT>::send_data(const std::vector<uint8_t>& data)
         return false;
     }
 
+    // Serialized with the heartbeats the client thread sends
+    std::unique_lock<std::mutex> send_lock(send_mutex_, std::defer_lock);
+    if (config_.heartbeat.sends())
+    {
+        send_lock.lock();
+        if (!heartbeat_tail_.empty() && !flush_heartbeat_tail())
+        {
+            return false;
+        }
+    }
+
     size_t total_sent = 0;
     size_t data_size = data.size();
     const uint8_t* buffer = data.data();
@@ -246,7 +603,9 @@ inline bool TCPClientBase<DerivedT>::send_data(const std::vector<uint8_t>& data)
     // Keep sending until all data is sent
     while (total_sent < data_size)
     {
-        ssize_t sent = send(socket_, buffer + total_sent, data_size - total_sent, MSG_NOSIGNAL);
+        TraceSpanFor<TraitsT> send_span(TraceKind::Send);
+        ssize_t sent = transmit(buffer + total_sent, data_size - total_sent);
+        send_span.end(sent);
         if (sent < 0)
         {
             // Check for non-blocking specific errors
@@ -262,6 +621,10 @@ inline bool TCPClientBase<DerivedT>::send_data(const std::vector<uint8_t>& data)
             if (errno == ECONNRESET || errno == EPIPE || errno == ENOTCONN)
             {
                 LOG_INFO("Connection lost during send, disconnecting");
+                if (send_lock.owns_lock())
+                {
+                    send_lock.unlock();  // the client thread may be waiting for it
+                }
                 disconnect();
             }
             return false;
@@ -271,11 +634,147 @@ inline bool TCPClientBase<DerivedT>::send_data(const std::vector<uint8_t>& data)
         
         if (sent > 0 && total_sent < data_size)
         {
-            LOG_TRACE("Partial send: sent {} bytes, {} remaining", sent, data_size - total_sent);
+            if constexpr (TraitsT::enable_logging)
+            {
+                LOG_TRACE("Partial send: sent {} bytes, {} remaining", sent, data_size - total_sent);
+            }
+        }
+    }
+
+    note_outbound();
+
+    if constexpr (TraitsT::enable_logging)
+    {
+        LOG_TRACE("Successfully sent {} bytes to server", total_sent);
+    }
+    return true;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline bool TCPClientBase<DerivedT, TraitsT>::send_data(std::span<const ConstBuffer> buffers)
+{
+    if (!connected_.load(std::memory_order_relaxed) || socket_ == invalid_socket)
+    {
+        LOG_WARN("Cannot send data: client not connected");
+        return false;
+    }
+
+    // Serialized with the heartbeats the client thread sends
+    std::unique_lock<std::mutex> send_lock(send_mutex_, std::defer_lock);
+    if (config_.heartbeat.sends())
+    {
+        send_lock.lock();
+        if (!heartbeat_tail_.empty() && !flush_heartbeat_tail())
+        {
+            return false;
         }
     }
 
-    LOG_TRACE("Successfully sent {} bytes to server", total_sent);
+    // TLS writes one piece at a time; each becomes its own record(s)
+    constexpr size_t max_iov = 16;
+    const size_t iov_limit = config_.tls.enabled ? 1 : max_iov;
+    iovec iov[max_iov];
+    GatherCursor cursor;
+    cursor.advance(buffers, 0);
+
+    while (!cursor.done(buffers))
+    {
+        size_t count = 0;
+        for (size_t i = cursor.index; i < buffers.size() && count < iov_limit; ++i)
+        {
+            size_t skip = i == cursor.index ? cursor.offset : 0;
+            iov[count].iov_base = const_cast<uint8_t*>(buffers[i].data + skip);
+            iov[count].iov_len = buffers[i].size - skip;
+            ++count;
+        }
+
+        TraceSpanFor<TraitsT> send_span(TraceKind::Send);
+        ssize_t sent;
+        if (config_.tls.enabled)
+        {
+            sent = transmit(iov[0].iov_base, iov[0].iov_len);
+        }
+        else
+        {
+            msghdr message{};
+            message.msg_iov = iov;
+            message.msg_iovlen = count;
+            sent = sendmsg(socket_, &message, MSG_NOSIGNAL);
+        }
+        send_span.end(sent);
+        if (sent < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            {
+                // Socket buffer is full, retry immediately
+                continue;
+            }
+
+            LOG_ERROR("Failed to send data: {}", std::strerror(errno));
+            if (errno == ECONNRESET || errno == EPIPE || errno == ENOTCONN)
+            {
+                LOG_INFO("Connection lost during send, disconnecting");
+                if (send_lock.owns_lock())
+                {
+                    send_lock.unlock();  // the client thread may be waiting for it
+                }
+                disconnect();
+            }
+            return false;
+        }
+
+        cursor.advance(buffers, static_cast<size_t>(sent));
+    }
+    note_outbound();
+    return true;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPClientBase<DerivedT, TraitsT>::send_heartbeat()
+{
+    std::unique_lock<std::mutex> send_lock(send_mutex_, std::try_to_lock);
+    if (!send_lock.owns_lock() || !connected_.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    const std::vector<uint8_t>& frame = heartbeat_tail_.empty() ? config_.heartbeat.frame : heartbeat_tail_;
+    TraceSpanFor<TraitsT> send_span(TraceKind::Send);
+    ssize_t sent = transmit(frame.data(), frame.size());
+    send_span.end(sent);
+    if (sent <= 0)
+    {
+        return;     // full or failing; a broken connection is seen by the read side
+    }
+    if (!heartbeat_tail_.empty())
+    {
+        heartbeat_tail_.erase(heartbeat_tail_.begin(), heartbeat_tail_.begin() + sent);
+    }
+    else if (static_cast<size_t>(sent) < frame.size())
+    {
+        heartbeat_tail_.assign(frame.begin() + sent, frame.end());
+    }
+}
+
+template<typename DerivedT, typename TraitsT>
+inline bool TCPClientBase<DerivedT, TraitsT>::flush_heartbeat_tail()
+{
+    size_t offset = 0;
+    while (offset < heartbeat_tail_.size())
+    {
+        ssize_t sent = transmit(heartbeat_tail_.data() + offset, heartbeat_tail_.size() - offset);
+        if (sent < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            {
+                continue;
+            }
+            LOG_ERROR("Failed to send data: {}", std::strerror(errno));
+            return false;
+        }
+        offset += static_cast<size_t>(sent);
+    }
+    heartbeat_tail_.clear();
     return true;
 }
 
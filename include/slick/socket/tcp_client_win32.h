@@ -14,8 +14,8 @@
 namespace slick::socket
 {
 
-template<typename DerivedT>
-inline TCPClientBase<DerivedT>::TCPClientBase(std::string name, const TCPClientConfig& config)
+template<typename DerivedT, typename TraitsT>
+inline TCPClientBase<DerivedT, TraitsT>::TCPClientBase(std::string name, const TCPClientConfig& config)
     : name_(std::move(name)), config_(config)
 {
     WSADATA wsa_data;
@@ -26,87 +26,124 @@ inline TCPClientBase<DerivedT>::TCPClientBase(std::string name, const TCPClientC
     }
 }
 
-template<typename DerivedT>
-inline TCPClientBase<DerivedT>::~TCPClientBase()
+template<typename DerivedT, typename TraitsT>
+inline TCPClientBase<DerivedT, TraitsT>::~TCPClientBase()
 {
     disconnect();
     WSACleanup();
 }
 
-template<typename DerivedT>
-inline bool TCPClientBase<DerivedT>::connect()
+template<typename DerivedT, typename TraitsT>
+inline bool TCPClientBase<DerivedT, TraitsT>::connect(const std::vector<uint8_t>& first_payload)
 {
-    if (connected_.load(std::memory_order_relaxed))
+    if (config_.tls.enabled)
     {
-        return true;
+        LOG_ERROR("TLS is not supported by the Windows client");
+        return false;
     }
 
-    // Create socket
-    socket_ = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    if (socket_ == invalid_socket)
+    if (config_.fast_open)
     {
-        LOG_ERROR("Failed to create socket");
-        return false;
+        // Fast Open on Windows requires ConnectEx; the payload follows the handshake instead
+        LOG_WARN("TCP Fast Open not supported on Windows, connecting normally");
     }
 
-    // Make socket non-blocking
-    u_long mode = 1; // non-blocking mode
-    if (ioctlsocket(socket_, FIONBIO, &mode) != 0)
+    if (!connect_socket())
     {
-        LOG_WARN("Failed to make socket non-blocking");
-        closesocket(socket_);
-        socket_ = invalid_socket;
         return false;
     }
 
-    // Set up server address
-    sockaddr_in server_addr{};
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(config_.server_port);
+    return first_payload.empty() || send_data(first_payload);
+}
 
-    // Resolve server address
-    if (inet_pton(AF_INET, config_.server_address.c_str(), &server_addr.sin_addr) != 1)
+template<typename DerivedT, typename TraitsT>
+inline bool TCPClientBase<DerivedT, TraitsT>::connect_socket()
+{
+    if (connected_.load(std::memory_order_relaxed))
     {
-        LOG_ERROR("Failed to resolve server address: {}", config_.server_address);
-        closesocket(socket_);
-        socket_ = invalid_socket;
-        return false;
+        return true;
     }
 
-    LOG_INFO("{} attempting to connect to {}:{}", name_, config_.server_address, config_.server_port);
+    std::vector<Endpoint> candidates = resolve_server_candidates();
+    if (candidates.empty())
+    {
+        return false;
+    }
 
-    // Attempt to connect (non-blocking)
-    int result = ::connect(socket_, (sockaddr*)&server_addr, sizeof(server_addr));
-    if (result == SOCKET_ERROR)
+    std::vector<SocketT> attempts;
+    std::vector<Endpoint> attempt_endpoints;
+    for (const Endpoint& candidate : candidates)
     {
-        int error = WSAGetLastError();
-        if (error != WSAEWOULDBLOCK && error != WSAEINPROGRESS)
+        SocketT s = start_connect(candidate);
+        if (s != invalid_socket)
         {
-            LOG_WARN("Failed to connect to server: error {}", error);
-            closesocket(socket_);
-            socket_ = invalid_socket;
-            return false;
+            attempts.push_back(s);
+            attempt_endpoints.push_back(candidate);
         }
     }
 
-    // Wait for connection to complete
-    fd_set write_fds;
-    FD_ZERO(&write_fds);
-    FD_SET(socket_, &write_fds);
+    // All candidates are dialled at once; the first to complete wins and the others are closed.
+    // A failed connect is reported through the except set.
+    auto deadline = std::chrono::steady_clock::now() + config_.connection_timeout;
+    while (socket_ == invalid_socket && !attempts.empty())
+    {
+        auto remaining = std::chrono::ceil<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            break;
+        }
+
+        fd_set write_fds;
+        fd_set except_fds;
+        FD_ZERO(&write_fds);
+        FD_ZERO(&except_fds);
+        for (SocketT s : attempts)
+        {
+            FD_SET(s, &write_fds);
+            FD_SET(s, &except_fds);
+        }
+
+        struct timeval timeout;
+        timeout.tv_sec = static_cast<long>(remaining.count() / 1000000);
+        timeout.tv_usec = static_cast<long>(remaining.count() % 1000000);
 
-    struct timeval timeout;
-    timeout.tv_sec = static_cast<long>(config_.connection_timeout.count() / 1000);
-    timeout.tv_usec = static_cast<long>((config_.connection_timeout.count() % 1000) * 1000);
+        if (select(0, nullptr, &write_fds, &except_fds, &timeout) <= 0)
+        {
+            break;
+        }
+
+        for (size_t i = 0; i < attempts.size();)
+        {
+            if (FD_ISSET(attempts[i], &write_fds))
+            {
+                socket_ = attempts[i];
+                LOG_INFO("{} connected to {}", name_, attempt_endpoints[i].to_string());
+                attempts.erase(attempts.begin() + i);
+                break;
+            }
+            if (FD_ISSET(attempts[i], &except_fds))
+            {
+                LOG_WARN("Connection to {} failed", attempt_endpoints[i].to_string());
+                closesocket(attempts[i]);
+                attempts.erase(attempts.begin() + i);
+                attempt_endpoints.erase(attempt_endpoints.begin() + i);
+                continue;
+            }
+            ++i;
+        }
+    }
 
-    result = select(static_cast<int>(socket_) + 1, nullptr, &write_fds, nullptr, &timeout);
-    if (result <= 0)
+    for (SocketT s : attempts)
+    {
+        closesocket(s);
+    }
+    if (socket_ == invalid_socket)
     {
         LOG_WARN("Connection timeout or failed");
-        closesocket(socket_);
-        socket_ = invalid_socket;
         return false;
     }
-    
+
+    heartbeat_tail_.clear();    // belonged to the previous connection's stream
     connected_.store(true, std::memory_order_release);
     client_thread_ = std::thread(&TCPClientBase::client_loop, this);
 
@@ -114,11 +151,55 @@ inline bool TCPClientBase<DerivedT>::connect()
     return true;
 }
 
-template<typename DerivedT>
-inline void TCPClientBase<DerivedT>::disconnect()
+template<typename DerivedT, typename TraitsT>
+inline SOCKET TCPClientBase<DerivedT, TraitsT>::start_connect(const Endpoint& endpoint)
+{
+    // Create socket
+    SOCKET s = ::socket(endpoint.socket_family(), SOCK_STREAM, IPPROTO_TCP);
+    if (s == invalid_socket)
+    {
+        LOG_ERROR("Failed to create socket");
+        return invalid_socket;
+    }
+
+    // Make socket non-blocking
+    u_long mode = 1; // non-blocking mode
+    if (ioctlsocket(s, FIONBIO, &mode) != 0)
+    {
+        LOG_WARN("Failed to make socket non-blocking");
+        closesocket(s);
+        return invalid_socket;
+    }
+
+    sockaddr_storage server_addr{};
+    int server_addr_len = endpoint.to_sockaddr(server_addr);
+
+    LOG_INFO("{} attempting to connect to {}", name_, endpoint.to_string());
+
+    // Attempt to connect (non-blocking)
+    if (::connect(s, (sockaddr*)&server_addr, server_addr_len) == SOCKET_ERROR)
+    {
+        int error = WSAGetLastError();
+        if (error != WSAEWOULDBLOCK && error != WSAEINPROGRESS)
+        {
+            LOG_WARN("Failed to connect to {}: error {}", endpoint.to_string(), error);
+            closesocket(s);
+            return invalid_socket;
+        }
+    }
+    return s;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPClientBase<DerivedT, TraitsT>::disconnect()
 {
     if (!connected_.load(std::memory_order_relaxed))
     {
+        // The peer may have closed the connection; reap the finished client thread
+        if (client_thread_.joinable() && client_thread_.get_id() != std::this_thread::get_id())
+        {
+            client_thread_.join();
+        }
         return;
     }
 
@@ -141,10 +222,20 @@ inline void TCPClientBase<DerivedT>::disconnect()
     LOG_INFO("Disconnected");
 }
 
-template<typename DerivedT>
-inline void TCPClientBase<DerivedT>::client_loop()
+template<typename DerivedT, typename TraitsT>
+inline void TCPClientBase<DerivedT, TraitsT>::post(std::function<void()> task)
+{
+    tasks_.push(std::move(task));
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPClientBase<DerivedT, TraitsT>::client_loop()
 {
     LOG_DEBUG("Client loop started");
+    if constexpr (TraitsT::enable_tracing)
+    {
+        Tracer::attach_thread(name_);
+    }
 
     // Set CPU affinity if specified
     if (config_.cpu_affinity >= 0)
@@ -163,16 +254,61 @@ inline void TCPClientBase<DerivedT>::client_loop()
         }
     }
 
+    // Keep the loop thread, its buffers and its connection state on one NUMA node
+    int numa_node = resolve_numa_node(config_.numa_node, config_.numa_interface);
+    if (numa_node >= 0)
+    {
+        if (config_.cpu_affinity < 0 && !pin_thread_to_numa_node(numa_node))
+        {
+            LOG_WARN("Failed to pin client thread to NUMA node {}", numa_node);
+        }
+        if (!prefer_numa_node_for_thread(numa_node))
+        {
+            LOG_WARN("Failed to set memory policy for NUMA node {}", numa_node);
+        }
+        BufferPool::instance().set_thread_node(numa_node);
+        LOG_INFO("Client thread placed on NUMA node {}", numa_node);
+    }
+    else if (!config_.numa_interface.empty())
+    {
+        LOG_WARN("NUMA node of {} unknown, client thread left unplaced", config_.numa_interface);
+    }
+
     // Connection established - handle server communication
-    std::vector<uint8_t> buffer(config_.receive_buffer_size);
+    auto buffer = make_receive_buffer<TraitsT>(config_.receive_buffer_size);
+    last_inbound_ = std::chrono::steady_clock::now();
+    note_outbound();
 
     while (connected_.load(std::memory_order_relaxed))
     {
+        loop_monitor_.loop_busy();
+
+        // No eventfd under wepoll: posted work is picked up on every iteration
+        if (!tasks_.empty())
+        {
+            auto timing = callback_scope(LoopCallback::Task, -1);
+            tasks_.run_all();
+        }
+        if (config_.heartbeat.enabled())
+        {
+            service_heartbeat();
+            if (!connected_.load(std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+
         // Check for incoming data (non-blocking)
         int received = recv(socket_, (char*)buffer.data(), (int)buffer.size(), 0);
         if (received > 0)
         {
+            stamp_receive_time();
+            if (config_.heartbeat.checks_peer())
+            {
+                last_inbound_ = std::chrono::steady_clock::now();
+            }
             // Process received data
+            auto timing = callback_scope(LoopCallback::Data, -1);
             derived().onData(buffer.data(), received);
             continue;
         }
@@ -194,10 +330,15 @@ inline void TCPClientBase<DerivedT>::client_loop()
                 break;
             }
         }
+        loop_monitor_.loop_idle();
         std::this_thread::yield();
     }
 
-    derived().onDisconnected();
+    {
+        auto timing = callback_scope(LoopCallback::Disconnected, -1);
+        derived().onDisconnected();
+    }
+    loop_monitor_.loop_idle();
 
     // Connection lost - clean up
     closesocket(socket_);
@@ -205,8 +346,8 @@ inline void TCPClientBase<DerivedT>::client_loop()
     LOG_DEBUG("Client loop ended");
 }
 
-template<typename DerivedT>
-inline bool TCPClientBase<DerivedT>::send_data(const std::vector<uint8_t>& data)
+template<typename DerivedT, typename TraitsT>
+inline bool TCPClientBase<DerivedT, TraitsT>::send_data(const std::vector<uint8_t>& data)
 {
     if (!connected_.load(std::memory_order_relaxed) || socket_ == invalid_socket)
     {
@@ -220,6 +361,17 @@ inline bool TCPClientBase<DerivedT>::send_data(const std::vector<uint8_t>& data)
         return false;
     }
 
+    // Serialized with the heartbeats the client thread sends
+    std::unique_lock<std::mutex> send_lock(send_mutex_, std::defer_lock);
+    if (config_.heartbeat.sends())
+    {
+        send_lock.lock();
+        if (!heartbeat_tail_.empty() && !flush_heartbeat_tail())
+        {
+            return false;
+        }
+    }
+
     size_t total_sent = 0;
     size_t data_size = data.size();
     const char* buffer = reinterpret_cast<const char*>(data.data());
@@ -245,6 +397,10 @@ inline bool TCPClientBase<DerivedT>::send_data(const std::vector<uint8_t>& data)
             if (error == WSAECONNRESET || error == WSAECONNABORTED || error == WSAENOTCONN)
             {
                 LOG_INFO("Connection lost during send, disconnecting");
+                if (send_lock.owns_lock())
+                {
+                    send_lock.unlock();  // the client thread may be waiting for it
+                }
                 disconnect();
             }
             return false;
@@ -254,11 +410,133 @@ inline bool TCPClientBase<DerivedT>::send_data(const std::vector<uint8_t>& data)
         
         if (sent > 0 && total_sent < data_size)
         {
-            LOG_TRACE("Partial send: sent {} bytes, {} remaining", sent, data_size - total_sent);
+            if constexpr (TraitsT::enable_logging)
+            {
+                LOG_TRACE("Partial send: sent {} bytes, {} remaining", sent, data_size - total_sent);
+            }
+        }
+    }
+
+    note_outbound();
+
+    if constexpr (TraitsT::enable_logging)
+    {
+        LOG_TRACE("Successfully sent {} bytes to server", total_sent);
+    }
+    return true;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline bool TCPClientBase<DerivedT, TraitsT>::send_data(std::span<const ConstBuffer> buffers)
+{
+    if (!connected_.load(std::memory_order_relaxed) || socket_ == invalid_socket)
+    {
+        LOG_WARN("Cannot send data: client not connected");
+        return false;
+    }
+
+    // Serialized with the heartbeats the client thread sends
+    std::unique_lock<std::mutex> send_lock(send_mutex_, std::defer_lock);
+    if (config_.heartbeat.sends())
+    {
+        send_lock.lock();
+        if (!heartbeat_tail_.empty() && !flush_heartbeat_tail())
+        {
+            return false;
+        }
+    }
+
+    constexpr size_t max_wsabuf = 16;
+    WSABUF wsabufs[max_wsabuf];
+    GatherCursor cursor;
+    cursor.advance(buffers, 0);
+
+    while (!cursor.done(buffers))
+    {
+        DWORD count = 0;
+        for (size_t i = cursor.index; i < buffers.size() && count < max_wsabuf; ++i)
+        {
+            size_t skip = i == cursor.index ? cursor.offset : 0;
+            wsabufs[count].buf = reinterpret_cast<CHAR*>(const_cast<uint8_t*>(buffers[i].data + skip));
+            wsabufs[count].len = static_cast<ULONG>(buffers[i].size - skip);
+            ++count;
         }
+
+        DWORD sent = 0;
+        if (WSASend(socket_, wsabufs, count, &sent, 0, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            int error = WSAGetLastError();
+            if (error == WSAEWOULDBLOCK)
+            {
+                // Socket buffer is full, retry immediately
+                continue;
+            }
+
+            LOG_ERROR("Failed to send data: error {}", error);
+            if (error == WSAECONNRESET || error == WSAECONNABORTED || error == WSAENOTCONN)
+            {
+                LOG_INFO("Connection lost during send, disconnecting");
+                if (send_lock.owns_lock())
+                {
+                    send_lock.unlock();  // the client thread may be waiting for it
+                }
+                disconnect();
+            }
+            return false;
+        }
+
+        cursor.advance(buffers, sent);
+    }
+    note_outbound();
+    return true;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPClientBase<DerivedT, TraitsT>::send_heartbeat()
+{
+    std::unique_lock<std::mutex> send_lock(send_mutex_, std::try_to_lock);
+    if (!send_lock.owns_lock() || !connected_.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    const std::vector<uint8_t>& frame = heartbeat_tail_.empty() ? config_.heartbeat.frame : heartbeat_tail_;
+    int sent = send(socket_, reinterpret_cast<const char*>(frame.data()), static_cast<int>(frame.size()), 0);
+    if (sent == SOCKET_ERROR || sent == 0)
+    {
+        return;     // full or failing; a broken connection is seen by the read side
+    }
+    if (!heartbeat_tail_.empty())
+    {
+        heartbeat_tail_.erase(heartbeat_tail_.begin(), heartbeat_tail_.begin() + sent);
+    }
+    else if (static_cast<size_t>(sent) < frame.size())
+    {
+        heartbeat_tail_.assign(frame.begin() + sent, frame.end());
     }
+}
 
-    LOG_TRACE("Successfully sent {} bytes to server", total_sent);
+template<typename DerivedT, typename TraitsT>
+inline bool TCPClientBase<DerivedT, TraitsT>::flush_heartbeat_tail()
+{
+    size_t offset = 0;
+    while (offset < heartbeat_tail_.size())
+    {
+        int sent = send(socket_, reinterpret_cast<const char*>(heartbeat_tail_.data() + offset),
+                        static_cast<int>(heartbeat_tail_.size() - offset), 0);
+        if (sent == SOCKET_ERROR)
+        {
+            int error = WSAGetLastError();
+            if (error == WSAEWOULDBLOCK)
+            {
+                continue;
+            }
+            LOG_ERROR("Failed to send data: error {}", error);
+            return false;
+        }
+        offset += static_cast<size_t>(sent);
+    }
+    heartbeat_tail_.clear();
     return true;
 }
 
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+namespace slick::socket
+{
+
+// Kernel view of a TCP connection, sampled with getsockopt(TCP_INFO)
+struct TCPConnectionHealth
+{
+    uint32_t rtt_us = 0;                    // smoothed round-trip time
+    uint32_t rtt_var_us = 0;                // round-trip time variance
+    uint32_t snd_cwnd = 0;                  // congestion window, in segments
+    uint32_t unacked = 0;                   // segments sent but not yet acknowledged
+    uint32_t lost = 0;                      // segments currently considered lost
+    uint32_t total_retransmits = 0;         // retransmitted segments over the connection lifetime
+    uint32_t retransmits_since_last = 0;    // growth of total_retransmits since the previous sample
+    uint64_t samples = 0;                   // number of successful samples
+    std::chrono::steady_clock::time_point sampled_at{};
+};
+
+// A value of 0 disables the corresponding check
+struct TCPHealthThresholds
+{
+    uint32_t max_rtt_us = 0;
+    uint32_t max_unacked = 0;
+    uint32_t max_retransmits_per_sample = 0;
+};
+
+inline bool exceeds_thresholds(const TCPConnectionHealth& health, const TCPHealthThresholds& thresholds) noexcept
+{
+    return (thresholds.max_rtt_us && health.rtt_us > thresholds.max_rtt_us) ||
+           (thresholds.max_unacked && health.unacked > thresholds.max_unacked) ||
+           (thresholds.max_retransmits_per_sample && health.retransmits_since_last > thresholds.max_retransmits_per_sample);
+}
+
+// Refresh health from the kernel. Returns false where TCP_INFO is unavailable (non-Linux) or on error.
+template<typename SocketT>
+inline bool sample_tcp_info(SocketT socket, TCPConnectionHealth& health) noexcept
+{
+#if defined(__linux__)
+    tcp_info info{};
+    socklen_t len = sizeof(info);
+    if (getsockopt(socket, IPPROTO_TCP, TCP_INFO, &info, &len) != 0)
+    {
+        return false;
+    }
+
+    uint32_t previous_retransmits = health.total_retransmits;
+    health.rtt_us = info.tcpi_rtt;
+    health.rtt_var_us = info.tcpi_rttvar;
+    health.snd_cwnd = info.tcpi_snd_cwnd;
+    health.unacked = info.tcpi_unacked;
+    health.lost = info.tcpi_lost;
+    health.total_retransmits = info.tcpi_total_retrans;
+    health.retransmits_since_last = health.samples ? info.tcpi_total_retrans - previous_retransmits : 0;
+    health.sampled_at = std::chrono::steady_clock::now();
+    ++health.samples;
+    return true;
+#else
+    (void)socket;
+    (void)health;
+    return false;
+#endif
+}
+
+} // namespace slick::socket
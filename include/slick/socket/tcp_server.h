@@ -12,28 +12,79 @@
 #include <chrono>
 #include <unordered_map>
 #include <string>
+#include <deque>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
 #include <slick/socket/logger.h>
+#include <slick/socket/buffer_pool.h>
+#include <slick/socket/cache_line.h>
+#include <slick/socket/clock.h>
+#include <slick/socket/const_buffer.h>
+#include <slick/socket/endpoint.h>
+#include <slick/socket/socket_traits.h>
+#include <slick/socket/numa.h>
+#include <slick/socket/task_queue.h>
+#include <slick/socket/heartbeat.h>
+#include <slick/socket/tcp_health.h>
+#include <slick/socket/tls.h>
+#include <slick/socket/warmup.h>
+#include <slick/socket/trace.h>
+#include <slick/socket/watchdog.h>
 
 #if defined(_WIN32) || defined(_WIN64)
 #include <winsock2.h>
+#else
+#include <unistd.h>
+#include <slick/socket/event_notifier.h>
+#include <slick/socket/event_poller.h>
 #endif
 
 namespace slick::socket
 {
 
+// Scheduling class of a connection within server_loop().
+// High: handled as soon as its events are returned. Low: handled after all high-priority
+// events of the iteration, within low_priority_read_budget bytes per iteration.
+enum class ConnectionPriority : uint8_t
+{
+    High,
+    Low,
+};
+
 struct TCPServerConfig
 {
     uint16_t port = 5000;
+    std::string bind_address = "0.0.0.0";  // Numeric IPv4/IPv6 address; "::" listens on IPv6 and IPv4 unless ipv6_only
+    bool ipv6_only = false;                 // IPV6_V6ONLY for an IPv6 bind_address
     int max_connections = 100;
     bool reuse_address = true;
-    int receive_buffer_size = 4096;
+    int receive_buffer_size = 4096;     // Ignored when the traits fix receive_buffer_size
     std::chrono::milliseconds connection_timeout{30000};
     int cpu_affinity = -1;  // -1 means no affinity, otherwise specify CPU core index
+    int numa_node = -1;         // NUMA node for the server thread and its buffers, -1 = none
+    std::string numa_interface; // Detect numa_node from this NIC (name or local IPv4 address) when numa_node is -1
+    std::chrono::milliseconds drain_timeout{5000};  // Upper bound for stop_gracefully()
+    size_t low_priority_read_budget = 64 * 1024;  // Bytes read from low-priority clients per loop iteration, 0 = unlimited
+    std::chrono::milliseconds tcp_info_interval{0};  // TCP_INFO sampling period per connection, 0 = disabled (Linux only)
+    size_t tcp_info_samples_per_iteration = 16;     // Connections sampled per loop iteration at most, 0 = unlimited
+    TCPHealthThresholds health_thresholds;          // onConnectionHealthAlert() fires when a sample crosses these
+    int tcp_fastopen_queue = 0;     // Pending TCP Fast Open requests allowed on the listener, 0 = disabled
+    int defer_accept_seconds = 0;   // TCP_DEFER_ACCEPT: accept only once data arrives, 0 = disabled (Linux only)
+    WarmupConfig warmup;            // Optional warm-up before start() returns
+    HeartbeatConfig heartbeat;      // Per-connection heartbeat frames and peer timeout
+    TLSConfig tls;                  // TLS with kTLS offload (Unix, SLICK_SOCKET_ENABLE_TLS); onClientConnected() follows the handshake
 };
 
-template<typename DerivedT>
+template<typename DerivedT, typename TraitsT = DefaultSocketTraits>
 class TCPServerBase
 {
+#if !defined(_WIN32) && !defined(_WIN64)
+    static_assert(TraitsT::max_events > 0 && TraitsT::max_events <= EventPoller::max_batch,
+                  "TraitsT::max_events must be within 1..EventPoller::max_batch");
+#endif
+
 public:
     explicit TCPServerBase(std::string name, const TCPServerConfig& config = TCPServerConfig());
     virtual ~TCPServerBase();
@@ -50,20 +101,61 @@ public:
     bool start();
     void stop();
 
+    // Stop accepting, flush queued writes, half-close every connection and wait for
+    // peers to close. Connections still open after drain_timeout are closed.
+    void stop_gracefully(std::chrono::milliseconds drain_timeout);
+    void stop_gracefully() { stop_gracefully(config_.drain_timeout); }
+
     bool is_running() const noexcept
     {
         return running_.load(std::memory_order_relaxed);
     }
 
+    // Receive-side flow control. While paused the client's socket is removed from the read
+    // interest set, so its kernel buffer fills and TCP backpressure reaches the sender.
+    // stop_gracefully() resumes every paused client so that their closes are seen.
+    // Safe to call from any thread; calls from other threads are posted to the server thread.
+    void pause_reading(int client_id);
+    void resume_reading(int client_id);
+
+    // Assign a connection to a priority class. New connections start as High.
+    // Safe to call from any thread; calls from other threads are posted to the server thread.
+    void set_client_priority(int client_id, ConnectionPriority priority);
+
+    // Run a task on the server thread. Safe to call from any thread; the loop is woken immediately.
+    // Returns false and drops the task when the server is not running.
+    bool post(std::function<void()> task);
+
+    // Actual listening port, useful when config.port is 0
+    uint16_t get_port() const noexcept
+    {
+        return bound_port_;
+    }
+
+    // Phase timings of the last start()
+    const StartupReport& get_startup_report() const noexcept
+    {
+        return startup_report_;
+    }
+
+    // What the server thread is running and how long its callbacks take (TraitsT::enable_loop_monitor)
+    const LoopMonitor& get_loop_monitor() const noexcept
+        requires TraitsT::enable_loop_monitor
+    {
+        return loop_monitor_;
+    }
+
 protected:
     DerivedT& derived() { return static_cast<DerivedT&>(*this); }
     const DerivedT& derived() const { return static_cast<const DerivedT&>(*this); }
 
     void server_loop();
     void accept_new_client();
-    void handle_client_data(int client_id, std::vector<uint8_t>& buffer);
+    // Returns true when byte_budget ran out before the socket was drained
+    bool handle_client_data(int client_id, ReceiveBuffer<TraitsT>& buffer, size_t* byte_budget = nullptr);
 
-    // Send data to client
+    // Send data to client. Must be called on the server thread (i.e. from a callback).
+    // Whatever the socket does not accept immediately is queued and flushed on EPOLLOUT.
     bool send_data(int client_id, const std::vector<uint8_t>& data);
     bool send_data(int client_id, const std::string& data)
     {
@@ -71,9 +163,58 @@ protected:
         return send_data(client_id, buffer);
     }
 
+    // Gathered send: the buffers go out with writev/WSASend, in order, as one byte stream.
+    // Only what the socket does not accept immediately is copied (into the outbound queue).
+    bool send_data(int client_id, std::span<const ConstBuffer> buffers);
+
+    // Stream length bytes of fd from offset to the client, after anything already queued.
+    // Server thread only. The descriptor is duplicated, so the caller may close it on return;
+    // length 0 sends to the end of the file. Unix uses sendfile (SSL_sendfile under kTLS) and
+    // resumes on EPOLLOUT, so the data never passes through user space; descriptors sendfile
+    // cannot read and user-space TLS are copied in 64 KB chunks. Windows reads and sends inline.
+    bool send_file(int client_id, int fd, uint64_t offset = 0, uint64_t length = 0);
+
     // Connection management
     void disconnect_client(int client_id);
+
+    // Like disconnect_client(), but output already queued for the client goes out first: the write
+    // side is shut down and the socket closed once the queue drains. Server thread only; nothing
+    // more can be sent and no further callbacks are made for the client.
+    void disconnect_client_after_flush(int client_id);
+
+    // Server thread only
+    bool is_reading_paused(int client_id) const;
+
+    // Latest TCP_INFO sample of a client (server thread only). False for unknown clients.
+    // Derived classes may implement onConnectionHealthAlert(int client_id, const TCPConnectionHealth&),
+    // called on the server thread when a sample starts exceeding config.health_thresholds.
+    bool get_connection_health(int client_id, TCPConnectionHealth& health) const;
     
+    // Peer address of a client (server thread only). False for unknown clients.
+    bool get_client_endpoint(int client_id, Endpoint& endpoint) const
+    {
+        auto it = clients_.find(client_id);
+        if (it == clients_.end())
+        {
+            return false;
+        }
+        endpoint = it->second.endpoint;
+        return true;
+    }
+
+    // Which directions of a client's TLS session run in the kernel (server thread only).
+    // False for unknown clients and plain connections.
+    bool get_tls_offload(int client_id, TLSOffload& offload) const
+    {
+        auto it = clients_.find(client_id);
+        if (it == clients_.end() || !it->second.tls)
+        {
+            return false;
+        }
+        offload = it->second.tls.offload();
+        return true;
+    }
+
     size_t get_connected_client_count() const noexcept
     {   
         return clients_.size();
@@ -90,31 +231,348 @@ protected:
     void close_socket(SocketT socket);
 
 protected:
+#if !defined(_WIN32) && !defined(_WIN64)
+    // A send_file() range waiting for the socket. Owns its duplicated descriptor.
+    struct PendingFile
+    {
+        PendingFile(int descriptor, uint64_t start, uint64_t length, size_t position)
+            : fd(descriptor), offset(start), remaining(length), queue_position(position)
+        {
+        }
+        ~PendingFile()
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+        }
+        PendingFile(PendingFile&& other) noexcept
+            : fd(std::exchange(other.fd, -1)), offset(other.offset), remaining(other.remaining)
+            , queue_position(other.queue_position), copy(other.copy)
+        {
+        }
+        PendingFile& operator=(PendingFile&& other) noexcept
+        {
+            std::swap(fd, other.fd);
+            offset = other.offset;
+            remaining = other.remaining;
+            queue_position = other.queue_position;
+            copy = other.copy;
+            return *this;
+        }
+
+        int fd;
+        uint64_t offset;
+        uint64_t remaining;
+        size_t queue_position;      // bytes of send_queue that go out before the file
+        bool copy = false;          // sendfile unsupported for this descriptor: pread and send
+    };
+#endif
 
     struct ClientInfo
     {
         SocketT socket;
-        std::string address;
+        Endpoint endpoint;
+        std::vector<uint8_t> send_queue;    // bytes not yet accepted by the socket
+        size_t send_offset = 0;             // first unsent byte in send_queue
+        bool write_shutdown = false;        // SHUT_WR issued while draining, or due with close_after_flush
+        bool close_after_flush = false;     // disconnect_client_after_flush(): close once the queue drains
+        bool read_paused = false;           // EPOLLIN removed by pause_reading()
+        ConnectionPriority priority = ConnectionPriority::High;
+        bool low_priority_ready = false;    // queued in low_priority_ready_
+        TCPConnectionHealth health;
+        bool health_alert = false;          // last sample exceeded the thresholds
+        ActivityList::Iterator inbound_activity{};      // entry in inbound_activity_ (peer_timeout)
+        ActivityList::Iterator outbound_activity{};     // entry in outbound_activity_ (idle_interval)
+        bool activity_tracked = false;      // has entries in the activity lists; inbound only while not paused
+        TLSSession tls;                     // open when config.tls is enabled
+        bool tls_want_write = false;        // handshake waits for EPOLLOUT
+#if !defined(_WIN32) && !defined(_WIN64)
+        std::deque<PendingFile> pending_files;  // send_file() ranges, in order with send_queue
+#endif
+    };
+
+    void set_read_paused(int client_id, bool paused);
+    bool on_server_thread() const noexcept
+    {
+        return std::this_thread::get_id() == server_thread_id_.load(std::memory_order_acquire);
+    }
+
+    enum class StopRequest : int
+    {
+        None = 0,
+        Immediate,
+        Graceful,
     };
 
+    void update_interest(const ClientInfo& client);
+
+    // Heartbeat bookkeeping, server thread only. Each call is O(1); nothing is tracked unless
+    // config_.heartbeat is enabled.
+    void track_activity(int client_id, ClientInfo& client)
+    {
+        activity_now_ = std::chrono::steady_clock::now();
+        client.activity_tracked = true;
+        if (config_.heartbeat.checks_peer() && !client.read_paused)
+        {
+            client.inbound_activity = inbound_activity_.insert(client_id, activity_now_);
+        }
+        if (config_.heartbeat.sends())
+        {
+            client.outbound_activity = outbound_activity_.insert(client_id, activity_now_);
+        }
+    }
+
+    // Called before a client is erased from clients_
+    void untrack_activity(ClientInfo& client)
+    {
+        if (!client.activity_tracked)
+        {
+            return;
+        }
+        if (config_.heartbeat.checks_peer() && !client.read_paused)
+        {
+            inbound_activity_.erase(client.inbound_activity);
+        }
+        if (config_.heartbeat.sends())
+        {
+            outbound_activity_.erase(client.outbound_activity);
+        }
+        client.activity_tracked = false;
+    }
+
+    // Nothing is read from a paused client, so it is exempt from peer_timeout until resumed
+    void note_read_paused(int client_id, ClientInfo& client, bool paused)
+    {
+        if (!client.activity_tracked || !config_.heartbeat.checks_peer())
+        {
+            return;
+        }
+        if (paused)
+        {
+            inbound_activity_.erase(client.inbound_activity);
+        }
+        else
+        {
+            client.inbound_activity = inbound_activity_.insert(client_id, std::chrono::steady_clock::now());
+        }
+    }
+
+    void note_inbound(ClientInfo& client)
+    {
+        if (config_.heartbeat.checks_peer())
+        {
+            inbound_activity_.touch(client.inbound_activity, activity_now_);
+        }
+    }
+
+    void note_outbound(ClientInfo& client)
+    {
+        if (config_.heartbeat.sends())
+        {
+            outbound_activity_.touch(client.outbound_activity, activity_now_);
+        }
+    }
+
+    // Sends heartbeats to idle clients and closes silent ones. Returns the milliseconds until
+    // the next one is due, -1 when nothing is tracked.
+    int service_heartbeats();
+    void service_low_priority_clients(ReceiveBuffer<TraitsT>& buffer);
+
+    // Server thread, before the first wait: fault in the receive buffer and size the client tables
+    void warm_up_loop_state(ReceiveBuffer<TraitsT>& buffer, int numa_node)
+    {
+        std::memset(buffer.data(), 0, buffer.capacity());
+        clients_.reserve(config_.max_connections);
+        socket_to_client_id_.reserve(config_.max_connections);
+        health_sweep_.reserve(config_.max_connections);
+        startup_report_.bytes_prefaulted = BufferPool::instance().arena_size(numa_node) + buffer.capacity();
+    }
+
+    void signal_loop_ready()
+    {
+        if constexpr (TraitsT::enable_tracing)
+        {
+            Tracer::attach_thread(name_);
+        }
+        loop_ready_.store(true, std::memory_order_release);
+        loop_ready_.notify_all();
+    }
+
+    // Time the current batch of events was returned by the wait (loop thread, TraitsT::enable_timestamps)
+    std::chrono::steady_clock::time_point last_receive_time() const noexcept
+        requires TraitsT::enable_timestamps
+    {
+        return receive_time_;
+    }
+
+    void stamp_receive_time() noexcept
+    {
+        if constexpr (TraitsT::enable_timestamps)
+        {
+            receive_time_ = TscClock::now();
+        }
+    }
+
+    // Times a user callback for the loop monitor and the trace until the result goes out of scope
+    CallbackScope<TraitsT> callback_scope(LoopCallback callback, int client_id) noexcept
+    {
+        return {loop_monitor_.callback_scope(callback, client_id),
+                TraceSpanFor<TraitsT>(TraceKind::Callback, client_id, callback)};
+    }
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    // send()/recv() on the plain socket or through the client's TLS session
+    ssize_t transmit(ClientInfo& client, const void* data, size_t size)
+    {
+        return client.tls ? client.tls.write(data, size) : ::send(client.socket, data, size, MSG_NOSIGNAL);
+    }
+    ssize_t receive(ClientInfo& client, void* data, size_t size)
+    {
+        return client.tls ? client.tls.read(data, size) : ::recv(client.socket, data, size, 0);
+    }
+    // Drives a pending TLS handshake; false when the client was dropped
+    bool continue_handshake(int client_id, ClientInfo& client);
+
+    static bool has_pending_output(const ClientInfo& client) noexcept
+    {
+        return client.send_offset < client.send_queue.size() || !client.pending_files.empty();
+    }
+    // One sendfile (or copy) step of the file at the head of pending_files
+    ssize_t transmit_file(ClientInfo& client, PendingFile& file);
+    bool flush_send_queue(int client_id);
+    int sample_connection_health();
+    void begin_drain();
+    void close_all_sockets();
+    void request_stop(StopRequest request);
+    std::vector<int> open_warmup_sockets();
+    void run_warmup(std::vector<int>& sockets);
+    void drain_warmup_socket(int socket, ReceiveBuffer<TraitsT>& buffer);
+#endif
+
+    // Members are grouped by the threads that write them; each group starts on its own cache line
+    // so the server thread's per-event writes do not invalidate lines other threads keep reading.
+
+    // Cold: set up before the loop starts and read-only afterwards
     std::string name_;
     TCPServerConfig config_;
-    std::atomic_bool running_{false};
-
     std::thread server_thread_;
-    SocketT server_socket_ = invalid_socket;
+    uint16_t bound_port_ = 0;
+    std::chrono::milliseconds drain_timeout_{0};
+    StartupReport startup_report_;
+    TLSContext tls_context_;                    // open while running with config.tls.enabled
+#if !defined(_WIN32) && !defined(_WIN64)
+    Endpoint warmup_target_;                    // address the warm-up connections dial
+    std::vector<uint16_t> warmup_ports_;        // local ports of the synthetic warm-up connections
+    std::atomic<size_t> warmup_bytes_{0};       // start-up only
+    std::atomic<int> warmup_open_{0};
+#endif
+
+    // Control flags: rarely written, polled by the loop and by monitoring threads
+    alignas(cache_line_size) std::atomic_bool running_{false};
+    std::atomic<StopRequest> stop_request_{StopRequest::None};
+    std::atomic_bool loop_ready_{false};        // loop thread finished its set-up
+    std::atomic<std::thread::id> server_thread_id_{};   // set by the running loop, for on_server_thread()
+
+    // Written by every thread that calls post()
+    alignas(cache_line_size) TaskQueue tasks_;
+
+    // Server thread, read by a Watchdog; empty without TraitsT::enable_loop_monitor
+    LoopMonitorFor<TraitsT> loop_monitor_;
 
+    // Server thread only
+    alignas(cache_line_size) SocketT server_socket_ = invalid_socket;
+    bool draining_ = false;
+    std::atomic<int> next_client_id_{1};
+    std::chrono::steady_clock::time_point receive_time_{};   // written only with TraitsT::enable_timestamps
 #if !defined(_WIN32) && !defined(_WIN64)
-    int epoll_fd_ = -1;  // epoll file descriptor for Unix/Linux
+    EventPoller poller_;    // epoll on Linux, kqueue on macOS
+    EventNotifier wakeup_;  // wakes server_loop() for stop requests and posted tasks; open for the object's lifetime
 #else
     HANDLE epoll_fd_ = nullptr;  // wepoll handle for Windows (epoll-like API)
 #endif
-
     std::unordered_map<int, ClientInfo> clients_;
     std::unordered_map<SocketT, int> socket_to_client_id_;
-    std::atomic<int> next_client_id_{1};
+    std::deque<int> low_priority_ready_;    // low-priority clients with unread data, round-robin
+    std::vector<int> health_sweep_;         // clients left to sample in the current TCP_INFO sweep
+    std::chrono::steady_clock::time_point next_health_sweep_{};
+    ActivityList inbound_activity_;         // clients by last data received
+    ActivityList outbound_activity_;        // clients by last data sent
+    std::chrono::steady_clock::time_point activity_now_{};  // refreshed after each wait when heartbeats are on
+#if !defined(_WIN32) && !defined(_WIN64)
+    std::vector<int> warmup_sockets_;           // accepted warm-up connections, server thread only
+#endif
 };
 
+template<typename DerivedT, typename TraitsT>
+inline int TCPServerBase<DerivedT, TraitsT>::service_heartbeats()
+{
+    const HeartbeatConfig& heartbeat = config_.heartbeat;
+    activity_now_ = std::chrono::steady_clock::now();
+    const auto now = activity_now_;
+
+    while (!inbound_activity_.empty() && inbound_activity_.front().at + heartbeat.peer_timeout <= now)
+    {
+        int client_id = inbound_activity_.front().id;
+        auto it = clients_.find(client_id);
+        if (it == clients_.end())
+        {
+            inbound_activity_.pop_front();
+            continue;
+        }
+
+        // The entry is unlinked when the client is disconnected below
+        LOG_WARN("{} client {} heartbeat timeout: nothing received for {} ms", name_, client_id,
+                 heartbeat.peer_timeout.count());
+        if constexpr (requires { derived().onHeartbeatTimeout(client_id); })
+        {
+            auto timing = callback_scope(LoopCallback::Heartbeat, client_id);
+            derived().onHeartbeatTimeout(client_id);
+        }
+        it = clients_.find(client_id);
+        if (it != clients_.end())
+        {
+            bool notify = !it->second.close_after_flush;
+            disconnect_client(client_id);
+            if (notify)
+            {
+                auto timing = callback_scope(LoopCallback::Disconnected, client_id);
+                derived().onClientDisconnected(client_id);
+            }
+        }
+    }
+
+    while (!outbound_activity_.empty() && outbound_activity_.front().at + heartbeat.idle_interval <= now)
+    {
+        int client_id = outbound_activity_.front().id;
+        auto it = clients_.find(client_id);
+        if (it == clients_.end())
+        {
+            outbound_activity_.pop_front();
+            continue;
+        }
+
+        // Re-armed first: a send that fails without closing must not be retried in this pass
+        outbound_activity_.touch(it->second.outbound_activity, now);
+        send_data(client_id, heartbeat.frame);
+    }
+
+    int due_ms = -1;
+    auto next_due = [&](std::chrono::steady_clock::time_point deadline) {
+        int ms = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count());
+        due_ms = due_ms < 0 ? ms : (std::min)(due_ms, ms);
+    };
+    if (!inbound_activity_.empty())
+    {
+        next_due(inbound_activity_.front().at + heartbeat.peer_timeout);
+    }
+    if (!outbound_activity_.empty())
+    {
+        next_due(outbound_activity_.front().at + heartbeat.idle_interval);
+    }
+    return due_ms;
+}
+
 } // namespace slick::socket
 
 #if defined(_WIN32) || defined(_WIN64)
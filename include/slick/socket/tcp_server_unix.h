@@ -10,68 +10,73 @@
 
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/stat.h>
+#if defined(__APPLE__)
+#include <sys/uio.h>
+#else
+#include <sys/sendfile.h>
+#endif
 #include <csignal>
 #include <algorithm>
 #include <cstring>
 #include <pthread.h>
 
-#ifdef __APPLE__
-#include <sys/event.h>
-#include <sys/time.h>
-#else
-#include <sys/epoll.h>
-#endif
-
 namespace slick::socket
 {
 
-template<typename DerivedT>
-inline TCPServerBase<DerivedT>::TCPServerBase(std::string name, const TCPServerConfig& config)
+template<typename DerivedT, typename TraitsT>
+inline TCPServerBase<DerivedT, TraitsT>::TCPServerBase(std::string name, const TCPServerConfig& config)
     : name_(std::move(name)), config_(config)
 {
     // Ignore SIGPIPE to prevent crashes when writing to closed sockets
     std::signal(SIGPIPE, SIG_IGN);
+
+    // Opened once and closed only by the destructor, so notify() from other threads never
+    // races with a close or writes to a reused descriptor. start() fails if this did.
+    wakeup_.open();
 }
 
-template<typename DerivedT>
-inline TCPServerBase<DerivedT>::~TCPServerBase()
+template<typename DerivedT, typename TraitsT>
+inline TCPServerBase<DerivedT, TraitsT>::~TCPServerBase()
 {
     stop();
 
-    if (server_socket_ >= 0)
-    {
-        close(server_socket_);
-        server_socket_ = -1;
-    }
+    // Sockets are torn down by the server thread; only leftovers of a failed start() remain here
+    close_all_sockets();
+    poller_.close();
+    wakeup_.close();
+}
 
-    for (auto& [id, client] : clients_)
+template<typename DerivedT, typename TraitsT>
+inline bool TCPServerBase<DerivedT, TraitsT>::start()
+{
+    if (running_.load(std::memory_order_relaxed))
     {
-        close(client.socket);
+        return true;
     }
-    clients_.clear();
-    socket_to_client_id_.clear();
 
-    if (epoll_fd_ >= 0)
+    auto started_at = std::chrono::steady_clock::now();
+    startup_report_ = StartupReport{};
+
+    Endpoint bind_endpoint;
+    if (!Endpoint::parse(config_.bind_address, config_.port, bind_endpoint))
     {
-        close(epoll_fd_);
-        epoll_fd_ = -1;
+        LOG_ERROR("Invalid bind address: {}", config_.bind_address);
+        return false;
     }
-}
 
-template<typename DerivedT>
-inline bool TCPServerBase<DerivedT>::start()
-{
-    if (running_.load(std::memory_order_relaxed))
+    if (config_.tls.enabled && !tls_context_.open(config_.tls, true))
     {
-        return true;
+        return false;
     }
 
-    LOG_INFO("Starting {}, lisening on: {}...", name_, config_.port);
+    LOG_INFO("Starting {}, lisening on: {}...", name_, bind_endpoint.to_string());
     // Create server socket
-    server_socket_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    server_socket_ = ::socket(bind_endpoint.socket_family(), SOCK_STREAM, 0);
     if (server_socket_ < 0)
     {
         LOG_ERROR("Failed to create server socket");
@@ -95,13 +100,21 @@ inline bool TCPServerBase<DerivedT>::start()
         LOG_WARN("Failed to make server socket non-blocking");
     }
 
+    // Dual-stack unless asked otherwise: IPv4 clients then appear as ::ffff:a.b.c.d, stored as IPv4
+    if (bind_endpoint.is_v6())
+    {
+        int v6_only = config_.ipv6_only ? 1 : 0;
+        if (setsockopt(server_socket_, IPPROTO_IPV6, IPV6_V6ONLY, &v6_only, sizeof(v6_only)) < 0)
+        {
+            LOG_WARN("Failed to set IPV6_V6ONLY: {}", std::strerror(errno));
+        }
+    }
+
     // Bind socket
-    sockaddr_in server_addr{};
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(config_.port);
-    server_addr.sin_addr.s_addr = INADDR_ANY;
+    sockaddr_storage server_addr{};
+    socklen_t addr_len = bind_endpoint.to_sockaddr(server_addr);
 
-    if (bind(server_socket_, (sockaddr*)&server_addr, sizeof(server_addr)) < 0)
+    if (bind(server_socket_, (sockaddr*)&server_addr, addr_len) < 0)
     {
         LOG_ERROR("Failed to bind socket");
         close(server_socket_);
@@ -109,6 +122,48 @@ inline bool TCPServerBase<DerivedT>::start()
         return false;
     }
 
+    addr_len = sizeof(server_addr);
+    Endpoint bound;
+    if (getsockname(server_socket_, (sockaddr*)&server_addr, &addr_len) == 0 && bound.from_sockaddr((sockaddr*)&server_addr))
+    {
+        bound_port_ = bound.port;
+    }
+
+    // Warm-up connections target the bound address, or loopback of a wildcard bind
+    warmup_target_ = bind_endpoint;
+    if (warmup_target_.is_unspecified())
+    {
+        Endpoint::parse(bind_endpoint.is_v6() && config_.ipv6_only ? "::1" : "127.0.0.1", 0, warmup_target_);
+    }
+    warmup_target_.port = bound_port_;
+
+    // Both options must be in place before listen()
+    if (config_.tcp_fastopen_queue > 0)
+    {
+#ifdef TCP_FASTOPEN
+        int queue_len = config_.tcp_fastopen_queue;
+        if (setsockopt(server_socket_, IPPROTO_TCP, TCP_FASTOPEN, &queue_len, sizeof(queue_len)) < 0)
+        {
+            LOG_WARN("Failed to enable TCP Fast Open: {}", std::strerror(errno));
+        }
+#else
+        LOG_WARN("TCP Fast Open not supported on this platform");
+#endif
+    }
+
+    if (config_.defer_accept_seconds > 0)
+    {
+#ifdef TCP_DEFER_ACCEPT
+        int seconds = config_.defer_accept_seconds;
+        if (setsockopt(server_socket_, IPPROTO_TCP, TCP_DEFER_ACCEPT, &seconds, sizeof(seconds)) < 0)
+        {
+            LOG_WARN("Failed to set TCP_DEFER_ACCEPT: {}", std::strerror(errno));
+        }
+#else
+        LOG_WARN("TCP_DEFER_ACCEPT not supported on this platform");
+#endif
+    }
+
     // Listen for connections
     if (listen(server_socket_, SOMAXCONN) < 0)
     {
@@ -118,305 +173,1130 @@ inline bool TCPServerBase<DerivedT>::start()
         return false;
     }
 
-    running_.store(true, std::memory_order_release);
-
-    // Start single-threaded server loop
-    server_thread_ = std::thread(&TCPServerBase<DerivedT>::server_loop, this);
-
-    LOG_INFO("{} started", name_);
-    return true;
-}
-
-template<typename DerivedT>
-inline void TCPServerBase<DerivedT>::stop()
-{
-    if (!running_.load(std::memory_order_relaxed))
+    // The event set is created here rather than on the server thread so that
+    // stop() can always reach the loop through the wake-up descriptor.
+    if (!wakeup_.is_open())
     {
-        return;
+        LOG_ERROR("Failed to create wake-up descriptor: {}", std::strerror(errno));
+        close(server_socket_);
+        server_socket_ = -1;
+        return false;
     }
 
-    LOG_INFO("Stopping {}...", name_);
-    running_.store(false, std::memory_order_release);
-
-    if (server_socket_ >= 0)
+    if (!poller_.open() || !poller_.add(server_socket_, true, false) || !poller_.add(wakeup_.fd(), true, false))
     {
+        LOG_ERROR("Failed to set up event polling: {}", std::strerror(errno));
+        poller_.close();
         close(server_socket_);
         server_socket_ = -1;
+        return false;
     }
 
-    // Close all client sockets
-    for (auto& [id, client] : clients_)
+    stop_request_.store(StopRequest::None, std::memory_order_relaxed);
+    draining_ = false;
+    startup_report_.socket_setup = elapsed_since(started_at);
+
+    // Warm-up connections are bound before the loop starts so it can tell them apart
+    std::vector<int> warmup_sockets;
+    if (config_.warmup.enabled)
     {
-        close(client.socket);
+        warmup_sockets = open_warmup_sockets();
     }
-    clients_.clear();
-    socket_to_client_id_.clear();
 
-    // Wait for server thread to finish
-    if (server_thread_.joinable())
+    loop_ready_.store(false, std::memory_order_relaxed);
+    tasks_.clear();     // a post() that raced with the last stop() belongs to that run
+    running_.store(true, std::memory_order_release);
+
+    // Start single-threaded server loop
+    server_thread_ = std::thread(&TCPServerBase<DerivedT, TraitsT>::server_loop, this);
+
+    if (config_.warmup.enabled)
     {
-        server_thread_.join();
+        run_warmup(warmup_sockets);
     }
 
-    LOG_INFO("{} stopped", name_);
+    startup_report_.total = elapsed_since(started_at);
+    LOG_INFO("{} started in {} us", name_, startup_report_.total.count());
+    return true;
 }
 
-template<typename DerivedT>
-inline bool TCPServerBase<DerivedT>::send_data(int client_id, const std::vector<uint8_t>& data)
+template<typename DerivedT, typename TraitsT>
+inline std::vector<int> TCPServerBase<DerivedT, TraitsT>::open_warmup_sockets()
 {
-    auto it = clients_.find(client_id);
-    if (it == clients_.end())
+    warmup_ports_.clear();
+    warmup_bytes_.store(0, std::memory_order_relaxed);
+    warmup_open_.store(0, std::memory_order_relaxed);
+
+    // A few connections so accept() is exercised more than once
+    std::vector<int> sockets;
+    int count = std::min(config_.warmup.loopback_messages, 4);
+    for (int i = 0; i < count; ++i)
     {
-        return false;
+        int s = ::socket(warmup_target_.socket_family(), SOCK_STREAM, 0);
+        if (s < 0)
+        {
+            break;
+        }
+
+        // Bound up front so accept_new_client() can recognise the connection by its source port
+        Endpoint local_endpoint = warmup_target_;
+        local_endpoint.port = 0;
+        sockaddr_storage local{};
+        socklen_t len = local_endpoint.to_sockaddr(local);
+        if (bind(s, (sockaddr*)&local, len) < 0)
+        {
+            close(s);
+            break;
+        }
+        len = sizeof(local);
+        if (getsockname(s, (sockaddr*)&local, &len) < 0 || !local_endpoint.from_sockaddr((sockaddr*)&local))
+        {
+            close(s);
+            break;
+        }
+        warmup_ports_.push_back(local_endpoint.port);
+        sockets.push_back(s);
     }
+    return sockets;
+}
 
-    size_t total_sent = 0;
-    size_t data_size = data.size();
-    const uint8_t* buffer = data.data();
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::run_warmup(std::vector<int>& sockets)
+{
+    auto wait_for = [](auto condition) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (!condition() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        return condition();
+    };
 
-    // Keep sending until all data is sent
-    while (total_sent < data_size)
+    auto phase = std::chrono::steady_clock::now();
+    loop_ready_.wait(false, std::memory_order_acquire);
+    startup_report_.loop_ready = elapsed_since(phase);
+
+    if (config_.warmup.lock_memory)
     {
-        ssize_t sent = send(it->second.socket, buffer + total_sent, data_size - total_sent, MSG_NOSIGNAL);
-        if (sent < 0)
+        phase = std::chrono::steady_clock::now();
+        startup_report_.bytes_locked = BufferPool::instance().lock_memory();
+        if (startup_report_.bytes_locked == 0)
         {
-            // Check for non-blocking specific errors
-            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            LOG_WARN("Failed to lock buffer memory: {}", std::strerror(errno));
+        }
+        startup_report_.memory_lock = elapsed_since(phase);
+    }
+
+    if (!sockets.empty())
+    {
+        // Synthetic traffic through accept, epoll and recv; the derived class never sees it
+        phase = std::chrono::steady_clock::now();
+        sockaddr_storage server_addr{};
+        socklen_t addr_len = warmup_target_.to_sockaddr(server_addr);
+        for (int s : sockets)
+        {
+            if (::connect(s, (sockaddr*)&server_addr, addr_len) < 0)
             {
-                // Socket buffer is full, retry immediately
-                continue;
+                LOG_WARN("Warm-up connection failed: {}", std::strerror(errno));
             }
+        }
 
-            LOG_ERROR("Failed to send data to client {}: {}", client_id, std::strerror(errno));
-
-            // Check if connection is broken
-            if (errno == ECONNRESET || errno == EPIPE || errno == ENOTCONN)
+        std::vector<uint8_t> message(std::max<size_t>(config_.warmup.message_size, 1), 0x5A);
+        size_t expected = 0;
+        for (int i = 0; i < config_.warmup.loopback_messages; ++i)
+        {
+            ssize_t sent = send(sockets[i % sockets.size()], message.data(), message.size(), MSG_NOSIGNAL);
+            if (sent > 0)
             {
-                LOG_INFO("Connection lost during send to client {}, disconnecting", client_id);
-                disconnect_client(client_id);
+                expected += static_cast<size_t>(sent);
+                ++startup_report_.primed_messages;
             }
-            return false;
+        }
+        if (!wait_for([&]() { return warmup_bytes_.load(std::memory_order_acquire) >= expected; }))
+        {
+            LOG_WARN("{} warm-up traffic not fully consumed", name_);
         }
 
-        total_sent += sent;
-        
-        if (sent > 0 && total_sent < data_size)
+        for (int s : sockets)
         {
-            LOG_TRACE("Partial send to client {}: sent {} bytes, {} remaining", 
-                           client_id, sent, data_size - total_sent);
+            close(s);
         }
+        wait_for([&]() { return warmup_open_.load(std::memory_order_acquire) == 0; });
+        post([this]() { warmup_ports_.clear(); });
+        startup_report_.priming = elapsed_since(phase);
     }
 
-    LOG_TRACE("Successfully sent {} bytes to client {}", total_sent, client_id);
-    return true;
-}
-
-template<typename DerivedT>
-inline void TCPServerBase<DerivedT>::close_socket(SocketT socket)
-{
-#ifdef __APPLE__
-    struct kevent ev;
-    EV_SET(&ev, socket, EVFILT_READ, EV_DELETE, 0, 0, 0);
-    kevent(epoll_fd_, &ev, 1, nullptr, 0, nullptr);
-#else
-    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, socket, nullptr);
-#endif
-    socket_to_client_id_.erase(socket);
-    close(socket);
+    LOG_INFO("{} warm-up: loop ready {} us, memory lock {} us ({} bytes), priming {} us ({} messages)",
+             name_, startup_report_.loop_ready.count(), startup_report_.memory_lock.count(),
+             startup_report_.bytes_locked, startup_report_.priming.count(), startup_report_.primed_messages);
 }
 
-template<typename DerivedT>
-inline void TCPServerBase<DerivedT>::disconnect_client(int client_id)
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::drain_warmup_socket(int socket, ReceiveBuffer<TraitsT>& buffer)
 {
-    auto it = clients_.find(client_id);
-    if (it != clients_.end())
+    auto it = std::find(warmup_sockets_.begin(), warmup_sockets_.end(), socket);
+    if (it == warmup_sockets_.end())
     {
-        close_socket(it->second.socket);
-        clients_.erase(it);
+        return;
     }
-}
 
-template<typename DerivedT>
-void TCPServerBase<DerivedT>::server_loop()
-{
-    // Set CPU affinity if specified
-    if (config_.cpu_affinity >= 0)
+    while (true)
     {
-#ifndef __APPLE__
-        cpu_set_t cpuset;
-        CPU_ZERO(&cpuset);
-        CPU_SET(config_.cpu_affinity, &cpuset);
-
-        pthread_t thread = pthread_self();
-        int result = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuset);
-        if (result != 0)
+        ssize_t received = recv(socket, buffer.data(), buffer.size(), 0);
+        if (received > 0)
         {
-            LOG_WARN("Failed to set CPU affinity to core {}: {}",
-                             config_.cpu_affinity, std::strerror(result));
+            warmup_bytes_.fetch_add(static_cast<size_t>(received), std::memory_order_release);
+            continue;
         }
-        else
+        if (received < 0 && errno == EINTR)
         {
-            LOG_INFO("Server thread pinned to CPU core {}", config_.cpu_affinity);
+            continue;
         }
-#else
-        LOG_WARN("CPU affinity not supported on macOS");
-#endif
+        if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+        {
+            poller_.remove(socket);
+            close(socket);
+            warmup_sockets_.erase(it);
+            warmup_open_.fetch_sub(1, std::memory_order_release);
+        }
+        return;
     }
+}
 
-#ifdef __APPLE__
-    // macOS: Use kqueue
-    epoll_fd_ = kqueue();
-    if (epoll_fd_ < 0)
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::stop()
+{
+    if (!running_.load(std::memory_order_relaxed))
     {
-        LOG_ERROR("Failed to create kqueue instance: {}", std::strerror(errno));
         return;
     }
 
-    // Add server socket to kqueue
-    struct kevent ev;
-    EV_SET(&ev, server_socket_, EVFILT_READ, EV_ADD, 0, 0, 0);
-    if (kevent(epoll_fd_, &ev, 1, nullptr, 0, nullptr) < 0)
+    LOG_INFO("Stopping {}...", name_);
+    request_stop(StopRequest::Immediate);
+    LOG_INFO("{} stopped", name_);
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::stop_gracefully(std::chrono::milliseconds drain_timeout)
+{
+    if (!running_.load(std::memory_order_relaxed))
     {
-        LOG_ERROR("Failed to add server socket to kqueue: {}", std::strerror(errno));
-        close(epoll_fd_);
-        epoll_fd_ = -1;
         return;
     }
 
-    const int MAX_EVENTS = 64;
-    struct kevent events[MAX_EVENTS];
-    std::vector<uint8_t> buffer(config_.receive_buffer_size);
+    LOG_INFO("Draining {} (timeout {} ms)...", name_, drain_timeout.count());
+    drain_timeout_ = drain_timeout;
+    request_stop(StopRequest::Graceful);
+    LOG_INFO("{} stopped", name_);
+}
 
-    // Set timeout to 1us to allow checking running_ flag
-    struct timespec timeout;
-    timeout.tv_sec = 0;
-    timeout.tv_nsec = 1000; // 1us
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::request_stop(StopRequest request)
+{
+    // All socket teardown happens on the server thread; here we only signal and join
+    stop_request_.store(request, std::memory_order_release);
+    wakeup_.notify();
 
-    if (config_.cpu_affinity < 0)
+    if (server_thread_.joinable())
     {
-        timeout.tv_nsec = 1000000;  // 1ms
+        server_thread_.join();
     }
+    server_thread_id_.store(std::thread::id(), std::memory_order_release);
 
-    while (running_.load())
-    {
-        int num_events = kevent(epoll_fd_, nullptr, 0, events, MAX_EVENTS, &timeout);
-        if (num_events < 0)
-        {
-            if (errno == EINTR)
-            {
-                continue;
-            }
-            LOG_ERROR("kevent failed: {}", std::strerror(errno));
-            break;
-        }
-
-        for (int i = 0; i < num_events; i++)
-        {
-            int fd = static_cast<int>(events[i].ident);
-            if (fd == server_socket_)
-            {
-                // New connection on server socket
-                accept_new_client();
-            }
-            else
-            {
-                auto it = socket_to_client_id_.find(fd);
-                if (it != socket_to_client_id_.end())
-                {
-                    handle_client_data(it->second, buffer);
-                }
-            }
-        }
-    }
+    running_.store(false, std::memory_order_release);
+    tasks_.clear();
+    poller_.close();
+}
 
-    // Clean up
-    if (epoll_fd_ >= 0)
+template<typename DerivedT, typename TraitsT>
+inline bool TCPServerBase<DerivedT, TraitsT>::post(std::function<void()> task)
+{
+    if (!running_.load(std::memory_order_acquire))
     {
-        close(epoll_fd_);
-        epoll_fd_ = -1;
+        return false;
     }
-#else
-    // Linux: Use epoll
-    epoll_fd_ = epoll_create1(0);
-    if (epoll_fd_ < 0)
+    tasks_.push(std::move(task));
+    wakeup_.notify();
+    return true;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline bool TCPServerBase<DerivedT, TraitsT>::send_data(int client_id, const std::vector<uint8_t>& data)
+{
+    auto it = clients_.find(client_id);
+    if (it == clients_.end())
     {
-        LOG_ERROR("Failed to create epoll instance: {}", std::strerror(errno));
-        return;
+        return false;
     }
 
-    // Add server socket to epoll
-    struct epoll_event ev;
-    ev.events = EPOLLIN;
-    ev.data.fd = server_socket_;
-    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, server_socket_, &ev) < 0)
+    ClientInfo& client = it->second;
+    if (client.write_shutdown)
     {
-        LOG_ERROR("Failed to add server socket to epoll: {}", std::strerror(errno));
-        close(epoll_fd_);
-        epoll_fd_ = -1;
-        return;
+        return false;
     }
 
-    const int MAX_EVENTS = 64;
-    struct epoll_event events[MAX_EVENTS];
-    std::vector<uint8_t> buffer(config_.receive_buffer_size);
-
-    int timeout = 0;
-    if (config_.cpu_affinity < 0)
+    // Preserve ordering behind data that is already waiting for EPOLLOUT
+    if (has_pending_output(client))
     {
-        // CPU isn't pinned wait for 1 ms
-        timeout = 1;
+        client.send_queue.insert(client.send_queue.end(), data.begin(), data.end());
+        note_outbound(client);
+        if constexpr (TraitsT::enable_logging)
+        {
+            LOG_TRACE("Queued {} bytes to client {}, {} pending", data.size(), client_id,
+                      client.send_queue.size() - client.send_offset);
+        }
+        return true;
     }
 
-    while (running_.load())
+    size_t total_sent = 0;
+    size_t data_size = data.size();
+    const uint8_t* buffer = data.data();
+
+    while (total_sent < data_size)
     {
-        int num_events = epoll_wait(epoll_fd_, events, MAX_EVENTS, timeout);
-        if (num_events < 0)
+        TraceSpanFor<TraitsT> send_span(TraceKind::Send, client_id);
+        ssize_t sent = transmit(client, buffer + total_sent, data_size - total_sent);
+        send_span.end(sent);
+        if (sent < 0)
         {
             if (errno == EINTR)
             {
                 continue;
             }
-            LOG_ERROR("epoll_wait failed: {}", std::strerror(errno));
-            break;
-        }
 
-        for (int i = 0; i < num_events; i++)
-        {
-            if (events[i].data.fd == server_socket_)
-            {
-                // New connection on server socket
-                accept_new_client();
-            }
-            else
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
             {
-                auto it = socket_to_client_id_.find(events[i].data.fd);
-                if (it != socket_to_client_id_.end())
+                // Socket buffer is full, hand the remainder to the server loop
+                client.send_queue.assign(buffer + total_sent, buffer + data_size);
+                client.send_offset = 0;
+                update_interest(client);
+                note_outbound(client);
+                if constexpr (TraitsT::enable_logging)
                 {
-                    handle_client_data(it->second, buffer);
+                    LOG_TRACE("Partial send to client {}: queued {} bytes", client_id, data_size - total_sent);
                 }
+                return true;
+            }
+
+            LOG_ERROR("Failed to send data to client {}: {}", client_id, std::strerror(errno));
+
+            // Check if connection is broken
+            if (errno == ECONNRESET || errno == EPIPE || errno == ENOTCONN)
+            {
+                LOG_INFO("Connection lost during send to client {}, disconnecting", client_id);
+                disconnect_client(client_id);
             }
+            return false;
         }
+
+        total_sent += sent;
     }
+    note_outbound(client);
 
-    // Clean up
-    if (epoll_fd_ >= 0)
+    if constexpr (TraitsT::enable_logging)
     {
-        close(epoll_fd_);
-        epoll_fd_ = -1;
+        LOG_TRACE("Successfully sent {} bytes to client {}", total_sent, client_id);
     }
-#endif
+    return true;
 }
 
-template<typename DerivedT>
-void TCPServerBase<DerivedT>::accept_new_client()
+template<typename DerivedT, typename TraitsT>
+inline bool TCPServerBase<DerivedT, TraitsT>::send_data(int client_id, std::span<const ConstBuffer> buffers)
 {
-    sockaddr_in client_addr{};
-    socklen_t addr_len = sizeof(client_addr);
+    auto it = clients_.find(client_id);
+    if (it == clients_.end())
+    {
+        return false;
+    }
 
-    int client_socket = accept(server_socket_, (sockaddr*)&client_addr, &addr_len);
-    if (client_socket < 0)
+    ClientInfo& client = it->second;
+    if (client.write_shutdown)
     {
-        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        return false;
+    }
+
+    // Preserve ordering behind data that is already waiting for EPOLLOUT
+    if (has_pending_output(client))
+    {
+        for (const ConstBuffer& piece : buffers)
+        {
+            client.send_queue.insert(client.send_queue.end(), piece.data, piece.data + piece.size);
+        }
+        note_outbound(client);
+        return true;
+    }
+
+    // TLS writes one piece at a time; each becomes its own record(s)
+    constexpr size_t max_iov = 16;
+    const size_t iov_limit = client.tls ? 1 : max_iov;
+    iovec iov[max_iov];
+    GatherCursor cursor;
+    cursor.advance(buffers, 0);
+
+    while (!cursor.done(buffers))
+    {
+        size_t count = 0;
+        for (size_t i = cursor.index; i < buffers.size() && count < iov_limit; ++i)
+        {
+            size_t skip = i == cursor.index ? cursor.offset : 0;
+            iov[count].iov_base = const_cast<uint8_t*>(buffers[i].data + skip);
+            iov[count].iov_len = buffers[i].size - skip;
+            ++count;
+        }
+
+        TraceSpanFor<TraitsT> send_span(TraceKind::Send, client_id);
+        ssize_t sent;
+        if (client.tls)
+        {
+            sent = transmit(client, iov[0].iov_base, iov[0].iov_len);
+        }
+        else
+        {
+            msghdr message{};
+            message.msg_iov = iov;
+            message.msg_iovlen = count;
+            sent = sendmsg(client.socket, &message, MSG_NOSIGNAL);
+        }
+        send_span.end(sent);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                // Socket buffer is full, hand the remainder to the server loop
+                client.send_queue.clear();
+                client.send_offset = 0;
+                for (size_t i = cursor.index; i < buffers.size(); ++i)
+                {
+                    size_t skip = i == cursor.index ? cursor.offset : 0;
+                    client.send_queue.insert(client.send_queue.end(), buffers[i].data + skip,
+                                             buffers[i].data + buffers[i].size);
+                }
+                update_interest(client);
+                note_outbound(client);
+                return true;
+            }
+
+            LOG_ERROR("Failed to send data to client {}: {}", client_id, std::strerror(errno));
+            if (errno == ECONNRESET || errno == EPIPE || errno == ENOTCONN)
+            {
+                LOG_INFO("Connection lost during send to client {}, disconnecting", client_id);
+                disconnect_client(client_id);
+            }
+            return false;
+        }
+
+        cursor.advance(buffers, static_cast<size_t>(sent));
+    }
+    note_outbound(client);
+    return true;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline bool TCPServerBase<DerivedT, TraitsT>::flush_send_queue(int client_id)
+{
+    auto it = clients_.find(client_id);
+    if (it == clients_.end())
+    {
+        return false;
+    }
+
+    ClientInfo& client = it->second;
+    if (client.tls && !client.tls.established())
+    {
+        return continue_handshake(client_id, client);
+    }
+
+    TraceSpanFor<TraitsT> flush_span(TraceKind::Flush, client_id);
+    while (has_pending_output(client))
+    {
+        // Queued bytes up to the next file, then the file itself
+        size_t bytes_end = client.pending_files.empty() ? client.send_queue.size()
+                                                        : client.pending_files.front().queue_position;
+        bool from_queue = client.send_offset < bytes_end;
+        TraceSpanFor<TraitsT> send_span(TraceKind::Send, client_id);
+        ssize_t sent = from_queue
+                           ? transmit(client, client.send_queue.data() + client.send_offset, bytes_end - client.send_offset)
+                           : transmit_file(client, client.pending_files.front());
+        send_span.end(sent);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return true;
+            }
+
+            LOG_ERROR("Failed to flush data to client {}: {}", client_id, std::strerror(errno));
+            SocketT socket = client.socket;
+            bool notify = !client.close_after_flush;
+            close_socket(socket);
+            untrack_activity(client);
+            clients_.erase(it);
+            if (notify)
+            {
+                auto timing = callback_scope(LoopCallback::Disconnected, client_id);
+                derived().onClientDisconnected(client_id);
+            }
+            return false;
+        }
+        if (from_queue)
+        {
+            client.send_offset += static_cast<size_t>(sent);
+        }
+    }
+
+    client.send_queue.clear();
+    client.send_offset = 0;
+
+    if (client.close_after_flush)
+    {
+        client.tls.shutdown();
+        ::shutdown(client.socket, SHUT_WR);
+        disconnect_client(client_id);
+        return false;
+    }
+
+    update_interest(client);
+
+    if (draining_ && !client.write_shutdown)
+    {
+        client.tls.shutdown();
+        ::shutdown(client.socket, SHUT_WR);
+        client.write_shutdown = true;
+    }
+    return true;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline bool TCPServerBase<DerivedT, TraitsT>::send_file(int client_id, int fd, uint64_t offset, uint64_t length)
+{
+    auto it = clients_.find(client_id);
+    if (it == clients_.end())
+    {
+        return false;
+    }
+
+    ClientInfo& client = it->second;
+    if (client.write_shutdown)
+    {
+        return false;
+    }
+
+    if (length == 0)
+    {
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || static_cast<uint64_t>(info.st_size) < offset)
+        {
+            LOG_ERROR("send_file to client {}: length required for this descriptor", client_id);
+            return false;
+        }
+        length = static_cast<uint64_t>(info.st_size) - offset;
+        if (length == 0)
+        {
+            return true;
+        }
+    }
+
+    int descriptor = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (descriptor < 0)
+    {
+        LOG_ERROR("send_file to client {}: {}", client_id, std::strerror(errno));
+        return false;
+    }
+
+    // Queued behind whatever is pending; the loop sends it on the next EPOLLOUT, which an
+    // idle socket reports at once
+    bool idle = !has_pending_output(client);
+    client.pending_files.emplace_back(descriptor, offset, length, client.send_queue.size());
+    if (idle)
+    {
+        update_interest(client);
+    }
+    note_outbound(client);
+    if constexpr (TraitsT::enable_logging)
+    {
+        LOG_TRACE("Queued {} file bytes to client {}", length, client_id);
+    }
+    return true;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline ssize_t TCPServerBase<DerivedT, TraitsT>::transmit_file(ClientInfo& client, PendingFile& file)
+{
+    constexpr size_t max_chunk = size_t(1) << 30;
+    size_t chunk = static_cast<size_t>((std::min<uint64_t>)(file.remaining, max_chunk));
+    ssize_t sent = -1;
+
+    if (!file.copy)
+    {
+        if (client.tls)
+        {
+            if (client.tls.kernel_send())
+            {
+                sent = client.tls.sendfile(file.fd, file.offset, chunk);
+            }
+            else
+            {
+                file.copy = true;   // user-space TLS has to see the plaintext
+            }
+        }
+        else
+        {
+#if defined(__APPLE__)
+            off_t length = static_cast<off_t>(chunk);
+            int result = ::sendfile(file.fd, client.socket, static_cast<off_t>(file.offset), &length, nullptr, 0);
+            // EAGAIN may come with partial progress
+            sent = length > 0 ? static_cast<ssize_t>(length) : (result == 0 ? 0 : -1);
+#else
+            off_t position = static_cast<off_t>(file.offset);
+            sent = ::sendfile(client.socket, file.fd, &position, chunk);
+#endif
+        }
+
+        if (sent < 0 && (errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP))
+        {
+            file.copy = true;       // e.g. a pipe or a file system without sendfile support
+        }
+    }
+
+    if (file.copy)
+    {
+        uint8_t buffer[64 * 1024];
+        ssize_t read = pread(file.fd, buffer, (std::min)(chunk, sizeof(buffer)), static_cast<off_t>(file.offset));
+        if (read < 0)
+        {
+            return -1;
+        }
+        sent = read == 0 ? 0 : transmit(client, buffer, static_cast<size_t>(read));
+    }
+
+    if (sent < 0)
+    {
+        return -1;
+    }
+    if (sent == 0)
+    {
+        LOG_WARN("File ended {} bytes early while sending to socket {}", file.remaining, client.socket);
+        file.remaining = 0;
+    }
+    file.offset += static_cast<uint64_t>(sent);
+    file.remaining -= (std::min<uint64_t>)(file.remaining, static_cast<uint64_t>(sent));
+    if (file.remaining == 0)
+    {
+        client.pending_files.pop_front();
+    }
+    return sent;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::update_interest(const ClientInfo& client)
+{
+    bool want_write = has_pending_output(client) || client.tls_want_write;
+    poller_.modify(client.socket, !client.read_paused, want_write, true);
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::pause_reading(int client_id)
+{
+    set_read_paused(client_id, true);
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::resume_reading(int client_id)
+{
+    set_read_paused(client_id, false);
+}
+
+template<typename DerivedT, typename TraitsT>
+inline bool TCPServerBase<DerivedT, TraitsT>::is_reading_paused(int client_id) const
+{
+    auto it = clients_.find(client_id);
+    return it != clients_.end() && it->second.read_paused;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::set_read_paused(int client_id, bool paused)
+{
+    if (!on_server_thread())
+    {
+        post([this, client_id, paused]() { set_read_paused(client_id, paused); });
+        return;
+    }
+
+    // A drain reads every client until it closes
+    auto it = clients_.find(client_id);
+    if (it == clients_.end() || it->second.read_paused == paused || (paused && draining_))
+    {
+        return;
+    }
+
+    // Re-arming an edge-triggered fd with EPOLLIN reports data that arrived while paused
+    note_read_paused(client_id, it->second, paused);
+    it->second.read_paused = paused;
+    update_interest(it->second);
+    LOG_DEBUG("{} client {} reading {}", name_, client_id, paused ? "paused" : "resumed");
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::close_socket(SocketT socket)
+{
+    poller_.remove(socket);
+    socket_to_client_id_.erase(socket);
+    close(socket);
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::close_all_sockets()
+{
+    if (server_socket_ >= 0)
+    {
+        close(server_socket_);
+        server_socket_ = -1;
+    }
+
+    for (auto& [id, client] : clients_)
+    {
+        close(client.socket);
+    }
+    clients_.clear();
+    socket_to_client_id_.clear();
+    inbound_activity_.clear();
+    outbound_activity_.clear();
+
+    for (int socket : warmup_sockets_)
+    {
+        close(socket);
+    }
+    warmup_sockets_.clear();
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::disconnect_client(int client_id)
+{
+    auto it = clients_.find(client_id);
+    if (it != clients_.end())
+    {
+        close_socket(it->second.socket);
+        untrack_activity(it->second);
+        clients_.erase(it);
+    }
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::disconnect_client_after_flush(int client_id)
+{
+    auto it = clients_.find(client_id);
+    if (it == clients_.end() || it->second.close_after_flush)
+    {
+        return;
+    }
+
+    ClientInfo& client = it->second;
+    if (has_pending_output(client))
+    {
+        // flush_send_queue() finishes the job; send_data() and send_file() refuse new output
+        client.close_after_flush = true;
+        client.write_shutdown = true;
+        return;
+    }
+    client.tls.shutdown();
+    ::shutdown(client.socket, SHUT_WR);
+    disconnect_client(client_id);
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::begin_drain()
+{
+    draining_ = true;
+
+    // Stop accepting
+    if (server_socket_ >= 0)
+    {
+        poller_.remove(server_socket_);
+        close(server_socket_);
+        server_socket_ = -1;
+    }
+
+    // TLS handshakes still in progress are abandoned; the application never saw these clients
+    for (auto it = clients_.begin(); it != clients_.end();)
+    {
+        if (it->second.tls && !it->second.tls.established())
+        {
+            close_socket(it->second.socket);
+            it = clients_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // Half-close connections with nothing left to send; the rest follow once flushed.
+    // Paused clients are read again, or their close would go unseen until the drain times out.
+    for (auto& [id, client] : clients_)
+    {
+        if (!has_pending_output(client))
+        {
+            client.tls.shutdown();
+            ::shutdown(client.socket, SHUT_WR);
+            client.write_shutdown = true;
+        }
+        if (client.read_paused)
+        {
+            note_read_paused(id, client, false);
+            client.read_paused = false;
+            update_interest(client);
+        }
+    }
+}
+
+template<typename DerivedT, typename TraitsT>
+void TCPServerBase<DerivedT, TraitsT>::server_loop()
+{
+    server_thread_id_.store(std::this_thread::get_id(), std::memory_order_release);
+
+    // Set CPU affinity if specified
+    if (config_.cpu_affinity >= 0)
+    {
+#ifndef __APPLE__
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(config_.cpu_affinity, &cpuset);
+
+        pthread_t thread = pthread_self();
+        int result = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuset);
+        if (result != 0)
+        {
+            LOG_WARN("Failed to set CPU affinity to core {}: {}",
+                             config_.cpu_affinity, std::strerror(result));
+        }
+        else
+        {
+            LOG_INFO("Server thread pinned to CPU core {}", config_.cpu_affinity);
+        }
+#else
+        LOG_WARN("CPU affinity not supported on macOS");
+#endif
+    }
+
+    // Keep the loop thread, its buffers and its connection state on one NUMA node
+    int numa_node = resolve_numa_node(config_.numa_node, config_.numa_interface);
+    if (numa_node >= 0)
+    {
+        if (config_.cpu_affinity < 0 && !pin_thread_to_numa_node(numa_node))
+        {
+            LOG_WARN("Failed to pin server thread to NUMA node {}", numa_node);
+        }
+        if (!prefer_numa_node_for_thread(numa_node))
+        {
+            LOG_WARN("Failed to set memory policy for NUMA node {}", numa_node);
+        }
+        BufferPool::instance().set_thread_node(numa_node);
+        LOG_INFO("Server thread placed on NUMA node {}", numa_node);
+    }
+    else if (!config_.numa_interface.empty())
+    {
+        LOG_WARN("NUMA node of {} unknown, server thread left unplaced", config_.numa_interface);
+    }
+
+    EventPoller::Event events[TraitsT::max_events];
+    auto buffer = make_receive_buffer<TraitsT>(config_.receive_buffer_size);
+    if (config_.warmup.enabled)
+    {
+        warm_up_loop_state(buffer, numa_node);
+    }
+    signal_loop_ready();
+
+    // Busy-poll or block until there is work or a wake-up, as chosen by TraitsT::polling
+    const int idle_timeout_ms = idle_wait_timeout<TraitsT>(config_.cpu_affinity >= 0);
+    std::chrono::steady_clock::time_point drain_deadline;
+
+    while (true)
+    {
+        StopRequest request = stop_request_.load(std::memory_order_acquire);
+        if (request == StopRequest::Immediate)
+        {
+            break;
+        }
+
+        int timeout_ms = idle_timeout_ms;
+        if (request == StopRequest::Graceful)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (!draining_)
+            {
+                drain_deadline = now + drain_timeout_;
+                begin_drain();
+            }
+
+            if (clients_.empty())
+            {
+                break;
+            }
+            if (now >= drain_deadline)
+            {
+                LOG_WARN("{} drain timed out with {} connections open", name_, clients_.size());
+                break;
+            }
+
+            if (timeout_ms != 0)
+            {
+                auto remaining = std::chrono::ceil<std::chrono::milliseconds>(drain_deadline - now);
+                timeout_ms = static_cast<int>(remaining.count());
+            }
+        }
+
+        if (config_.tcp_info_interval.count() > 0)
+        {
+            int due_ms = sample_connection_health();
+            if (timeout_ms < 0 || due_ms < timeout_ms)
+            {
+                timeout_ms = due_ms;
+            }
+        }
+
+        if (config_.heartbeat.enabled())
+        {
+            int due_ms = service_heartbeats();
+            if (due_ms >= 0 && (timeout_ms < 0 || due_ms < timeout_ms))
+            {
+                timeout_ms = due_ms;
+            }
+        }
+
+        // Unread low-priority data left over from the previous iteration: just peek for new events
+        if (!low_priority_ready_.empty())
+        {
+            timeout_ms = 0;
+        }
+
+        loop_monitor_.loop_idle();
+        TraceSpanFor<TraitsT> wait_span(TraceKind::Wait);
+        int num_events = poller_.wait(events, TraitsT::max_events, timeout_ms);
+        loop_monitor_.loop_busy();
+        wait_span.end_or_discard(num_events);
+        if (num_events < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LOG_ERROR("Event wait failed: {}", std::strerror(errno));
+            break;
+        }
+        if (num_events > 0)
+        {
+            stamp_receive_time();
+            if (config_.heartbeat.enabled())
+            {
+                activity_now_ = std::chrono::steady_clock::now();
+            }
+        }
+
+        for (int i = 0; i < num_events; i++)
+        {
+            int fd = events[i].fd;
+            if (fd == wakeup_.fd())
+            {
+                wakeup_.drain();
+                auto timing = callback_scope(LoopCallback::Task, -1);
+                tasks_.run_all();
+            }
+            else if (fd == server_socket_)
+            {
+                // New connection on server socket
+                accept_new_client();
+            }
+            else
+            {
+                auto it = socket_to_client_id_.find(fd);
+                if (it == socket_to_client_id_.end())
+                {
+                    if (!warmup_sockets_.empty())
+                    {
+                        drain_warmup_socket(fd, buffer);
+                    }
+                    continue;
+                }
+
+                int client_id = it->second;
+                if (events[i].writable && !flush_send_queue(client_id))
+                {
+                    continue;
+                }
+                if (events[i].readable)
+                {
+                    auto client_it = clients_.find(client_id);
+                    if (client_it == clients_.end())
+                    {
+                        continue;
+                    }
+
+                    if (client_it->second.priority == ConnectionPriority::High)
+                    {
+                        handle_client_data(client_id, buffer);
+                    }
+                    else if (!client_it->second.low_priority_ready)
+                    {
+                        // Deferred until every high-priority event of this batch is handled
+                        client_it->second.low_priority_ready = true;
+                        low_priority_ready_.push_back(client_id);
+                    }
+                }
+            }
+        }
+
+        if (!low_priority_ready_.empty())
+        {
+            service_low_priority_clients(buffer);
+        }
+    }
+    loop_monitor_.loop_idle();
+
+    // Tear down on the server thread so no other thread touches sockets the loop still owns
+    close_all_sockets();
+}
+
+template<typename DerivedT, typename TraitsT>
+void TCPServerBase<DerivedT, TraitsT>::service_low_priority_clients(ReceiveBuffer<TraitsT>& buffer)
+{
+    // Round-robin over ready low-priority clients until the per-iteration byte budget is spent.
+    // Clients that still have unread data go to the back of the queue for the next iteration.
+    size_t budget = config_.low_priority_read_budget > 0 ? config_.low_priority_read_budget : SIZE_MAX;
+    size_t pending = low_priority_ready_.size();
+
+    while (pending-- > 0 && budget > 0)
+    {
+        int client_id = low_priority_ready_.front();
+        low_priority_ready_.pop_front();
+
+        auto it = clients_.find(client_id);
+        if (it == clients_.end())
+        {
+            continue;
+        }
+        it->second.low_priority_ready = false;
+
+        if (handle_client_data(client_id, buffer, &budget))
+        {
+            it = clients_.find(client_id);
+            if (it != clients_.end())
+            {
+                it->second.low_priority_ready = true;
+                low_priority_ready_.push_back(client_id);
+            }
+        }
+    }
+}
+
+template<typename DerivedT, typename TraitsT>
+inline int TCPServerBase<DerivedT, TraitsT>::sample_connection_health()
+{
+    // Connections are sampled in sweeps of at most tcp_info_samples_per_iteration per loop
+    // iteration. Returns the milliseconds until more sampling is due.
+    auto now = std::chrono::steady_clock::now();
+    if (health_sweep_.empty())
+    {
+        if (now < next_health_sweep_)
+        {
+            return static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(next_health_sweep_ - now).count());
+        }
+
+        next_health_sweep_ = now + config_.tcp_info_interval;
+        for (const auto& [id, client] : clients_)
+        {
+            health_sweep_.push_back(id);
+        }
+    }
+
+    size_t budget = config_.tcp_info_samples_per_iteration > 0 ? config_.tcp_info_samples_per_iteration : SIZE_MAX;
+    while (budget > 0 && !health_sweep_.empty())
+    {
+        int client_id = health_sweep_.back();
+        health_sweep_.pop_back();
+
+        auto it = clients_.find(client_id);
+        if (it == clients_.end() || !sample_tcp_info(it->second.socket, it->second.health))
+        {
+            continue;
+        }
+        --budget;
+
+        ClientInfo& client = it->second;
+        bool alert = exceeds_thresholds(client.health, config_.health_thresholds);
+        bool crossed = alert && !client.health_alert;
+        client.health_alert = alert;
+        if (crossed)
+        {
+            // Copy: the callback may disconnect the client
+            TCPConnectionHealth health = client.health;
+            LOG_WARN("{} client {} health alert: rtt={}us unacked={} retransmits={}", name_, client_id,
+                     health.rtt_us, health.unacked, health.retransmits_since_last);
+            if constexpr (requires { derived().onConnectionHealthAlert(client_id, health); })
+            {
+                auto timing = callback_scope(LoopCallback::HealthAlert, client_id);
+                derived().onConnectionHealthAlert(client_id, health);
+            }
+        }
+    }
+
+    if (!health_sweep_.empty())
+    {
+        return 0;
+    }
+    // A budget-limited sweep can outlast the interval; a negative timeout would block epoll_wait
+    auto due = std::chrono::ceil<std::chrono::milliseconds>(next_health_sweep_ - now);
+    return static_cast<int>(std::max<std::chrono::milliseconds::rep>(0, due.count()));
+}
+
+template<typename DerivedT, typename TraitsT>
+inline bool TCPServerBase<DerivedT, TraitsT>::get_connection_health(int client_id, TCPConnectionHealth& health) const
+{
+    auto it = clients_.find(client_id);
+    if (it == clients_.end())
+    {
+        return false;
+    }
+    health = it->second.health;
+    return true;
+}
+
+template<typename DerivedT, typename TraitsT>
+inline void TCPServerBase<DerivedT, TraitsT>::set_client_priority(int client_id, ConnectionPriority priority)
+{
+    if (!on_server_thread())
+    {
+        post([this, client_id, priority]() { set_client_priority(client_id, priority); });
+        return;
+    }
+
+    auto it = clients_.find(client_id);
+    if (it != clients_.end())
+    {
+        it->second.priority = priority;
+        LOG_DEBUG("{} client {} priority set to {}", name_, client_id,
+                  priority == ConnectionPriority::High ? "high" : "low");
+    }
+}
+
+template<typename DerivedT, typename TraitsT>
+void TCPServerBase<DerivedT, TraitsT>::accept_new_client()
+{
+    sockaddr_storage client_addr{};
+    socklen_t addr_len = sizeof(client_addr);
+
+    int client_socket = accept(server_socket_, (sockaddr*)&client_addr, &addr_len);
+    if (client_socket < 0)
+    {
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
         {
             LOG_ERROR("Failed to accept client");
         }
@@ -430,77 +1310,195 @@ void TCPServerBase<DerivedT>::accept_new_client()
         fcntl(client_socket, F_SETFL, flags | O_NONBLOCK);
     }
 
-    // Add client socket to event system
-#ifdef __APPLE__
-    struct kevent ev;
-    EV_SET(&ev, client_socket, EVFILT_READ, EV_ADD, 0, 0, 0);
-    if (kevent(epoll_fd_, &ev, 1, nullptr, 0, nullptr) < 0)
+    // Add client socket to event system (edge-triggered)
+    if (!poller_.add(client_socket, true, false, true))
     {
-        LOG_ERROR("Failed to add client socket to kqueue: {}", std::strerror(errno));
+        LOG_ERROR("Failed to add client socket to event poller: {}", std::strerror(errno));
         close(client_socket);
         return;
     }
-#else
-    struct epoll_event ev;
-    ev.events = EPOLLIN | EPOLLET;  // Edge-triggered mode
-    ev.data.fd = client_socket;
-    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, client_socket, &ev) < 0)
+
+    Endpoint endpoint;
+    endpoint.from_sockaddr((sockaddr*)&client_addr);
+
+    // Synthetic warm-up connection: read by the loop, never reported to the derived class
+    if (!warmup_ports_.empty() && endpoint.address == warmup_target_.address &&
+        std::find(warmup_ports_.begin(), warmup_ports_.end(), endpoint.port) != warmup_ports_.end())
     {
-        LOG_ERROR("Failed to add client socket to epoll: {}", std::strerror(errno));
-        close(client_socket);
+        warmup_sockets_.push_back(client_socket);
+        warmup_open_.fetch_add(1, std::memory_order_release);
         return;
     }
-#endif
-
-    // Get client address
-    char addr_str[INET_ADDRSTRLEN];
-    inet_ntop(AF_INET, &client_addr.sin_addr, addr_str, INET_ADDRSTRLEN);
 
     uint32_t client_id = next_client_id_.fetch_add(1);
-    std::string client_address = addr_str;
+    std::string client_address = endpoint.address_string();
 
     // Add client to maps
-    clients_[client_id] = {client_socket, client_address};
+    ClientInfo& client = clients_[client_id];
+    client.socket = client_socket;
+    client.endpoint = endpoint;
     socket_to_client_id_[client_socket] = client_id;
 
+    // TLS clients are reported once their handshake completes
+    if (tls_context_)
+    {
+        if (!client.tls.open(tls_context_, client_socket, true))
+        {
+            close_socket(client_socket);
+            clients_.erase(client_id);
+            return;
+        }
+        continue_handshake(client_id, client);
+        return;
+    }
+
+    track_activity(client_id, client);
+
     // Notify about new client
+    auto timing = callback_scope(LoopCallback::Connected, client_id);
     derived().onClientConnected(client_id, client_address);
 }
 
-template<typename DerivedT>
-void TCPServerBase<DerivedT>::handle_client_data(int client_id, std::vector<uint8_t>& buffer)
+template<typename DerivedT, typename TraitsT>
+bool TCPServerBase<DerivedT, TraitsT>::continue_handshake(int client_id, ClientInfo& client)
 {
-    auto it = clients_.find(client_id);
-    if (it == clients_.end())
+    TLSHandshakeStatus status = client.tls.handshake();
+    if (status == TLSHandshakeStatus::Failed)
     {
-        return;
+        LOG_WARN("TLS handshake with client ID={} failed", client_id);
+        close_socket(client.socket);
+        clients_.erase(client_id);
+        return false;
+    }
+
+    bool want_write = status == TLSHandshakeStatus::WantWrite;
+    if (want_write != client.tls_want_write)
+    {
+        client.tls_want_write = want_write;
+        update_interest(client);
+    }
+    if (status != TLSHandshakeStatus::Done)
+    {
+        return true;
     }
 
-    int socket = it->second.socket;
-    ssize_t received = recv(socket, buffer.data(), buffer.size(), 0);
+    LOG_DEBUG("{} client {} TLS established, kernel offload send={} receive={}", name_, client_id,
+              client.tls.kernel_send(), client.tls.kernel_receive());
+    track_activity(client_id, client);
+    auto timing = callback_scope(LoopCallback::Connected, client_id);
+    derived().onClientConnected(client_id, client.endpoint.address_string());
+    return true;
+}
 
-    if (received > 0)
+template<typename DerivedT, typename TraitsT>
+bool TCPServerBase<DerivedT, TraitsT>::handle_client_data(int client_id, ReceiveBuffer<TraitsT>& buffer, size_t* byte_budget)
+{
+    // Hang-up/error are reported even without EPOLLIN; paused clients are left until resumed
+    auto it = clients_.find(client_id);
+    if (it == clients_.end() || it->second.read_paused)
     {
-        // Process received data
-        derived().onClientData(client_id, buffer.data(), received);
+        return false;
     }
-    else if (received == 0)
+
+    if (it->second.tls && !it->second.tls.established())
     {
-        // Client disconnected
-        close_socket(socket);
-        clients_.erase(it);
-        // Notify about client disconnection
-        derived().onClientDisconnected(client_id);
+        // The connected callback may have disconnected the client
+        if (!continue_handshake(client_id, it->second) || (it = clients_.find(client_id)) == clients_.end() ||
+            !it->second.tls.established() || it->second.read_paused)
+        {
+            return false;
+        }
     }
-    else
+
+    // A short TLS read only means one record was returned; it does not drain the socket
+    const bool short_read_drains = !it->second.tls;
+
+    // Edge-triggered: keep reading while the buffer comes back full
+    while (true)
     {
-        // Error
-        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        size_t request = buffer.size();
+        if (byte_budget)
         {
-            LOG_ERROR("Receive error for client ID={}", client_id);
+            if (*byte_budget == 0)
+            {
+                return true;
+            }
+            request = std::min(request, *byte_budget);
+        }
+
+        int socket = it->second.socket;
+        TraceSpanFor<TraitsT> receive_span(TraceKind::Receive, client_id);
+        ssize_t received = receive(it->second, buffer.data(), request);
+        receive_span.end(received);
+
+        if (received > 0)
+        {
+            if (byte_budget)
+            {
+                *byte_budget -= static_cast<size_t>(received);
+            }
+            note_inbound(it->second);
+
+            // The application let go of this client; its data is discarded until the queue drains
+            if (it->second.close_after_flush)
+            {
+                continue;
+            }
+
+            // Process received data
+            {
+                auto timing = callback_scope(LoopCallback::Data, client_id);
+                derived().onClientData(client_id, buffer.data(), received);
+            }
+            if (short_read_drains && static_cast<size_t>(received) < request)
+            {
+                return false;
+            }
+
+            // The callback may have disconnected the client or paused reading
+            it = clients_.find(client_id);
+            if (it == clients_.end() || it->second.read_paused)
+            {
+                return false;
+            }
+        }
+        else if (received == 0)
+        {
+            // Client disconnected
+            bool notify = !it->second.close_after_flush;
             close_socket(socket);
+            untrack_activity(it->second);
             clients_.erase(it);
-            derived().onClientDisconnected(client_id);
+            // Notify about client disconnection
+            if (notify)
+            {
+                auto timing = callback_scope(LoopCallback::Disconnected, client_id);
+                derived().onClientDisconnected(client_id);
+            }
+            return false;
+        }
+        else
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            // Error
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                LOG_ERROR("Receive error for client ID={}", client_id);
+                bool notify = !it->second.close_after_flush;
+                close_socket(socket);
+                untrack_activity(it->second);
+                clients_.erase(it);
+                if (notify)
+                {
+                    auto timing = callback_scope(LoopCallback::Disconnected, client_id);
+                    derived().onClientDisconnected(client_id);
+                }
+            }
+            return false;
         }
     }
 }
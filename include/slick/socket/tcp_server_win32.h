@@ -10,6 +10,8 @@
 #include <ws2tcpip.h>
 #include <windows.h>
 #include "wepoll.h"
+#include <io.h>
+#include <sys/stat.h>
 #include <queue>
 #include <algorithm>
 
@@ -18,8 +20,8 @@
 namespace slick::socket
 {
 
-template<typename DrivedT>
-inline TCPServerBase<DrivedT>::TCPServerBase(std::string name, const TCPServerConfig& config)
+template<typename DrivedT, typename TraitsT>
+inline TCPServerBase<DrivedT, TraitsT>::TCPServerBase(std::string name, const TCPServerConfig& config)
     : name_(std::move(name)), config_(config)
 {
     WSADATA wsa_data;
@@ -30,8 +32,8 @@ inline TCPServerBase<DrivedT>::TCPServerBase(std::string name, const TCPServerCo
     }
 }
 
-template<typename DrivedT>
-inline TCPServerBase<DrivedT>::~TCPServerBase()
+template<typename DrivedT, typename TraitsT>
+inline TCPServerBase<DrivedT, TraitsT>::~TCPServerBase()
 {
     stop();
 
@@ -57,17 +59,33 @@ inline TCPServerBase<DrivedT>::~TCPServerBase()
     WSACleanup();
 }
 
-template<typename DrivedT>
-inline bool TCPServerBase<DrivedT>::start()
+template<typename DrivedT, typename TraitsT>
+inline bool TCPServerBase<DrivedT, TraitsT>::start()
 {
     if (running_.load(std::memory_order_relaxed))
     {
         return true;
     }
 
-    LOG_INFO("Starting {}, lisening on: {}...", name_, config_.port);
+    if (config_.tls.enabled)
+    {
+        LOG_ERROR("TLS is not supported by the Windows server");
+        return false;
+    }
+
+    auto started_at = std::chrono::steady_clock::now();
+    startup_report_ = StartupReport{};
+
+    Endpoint bind_endpoint;
+    if (!Endpoint::parse(config_.bind_address, config_.port, bind_endpoint))
+    {
+        LOG_ERROR("Invalid bind address: {}", config_.bind_address);
+        return false;
+    }
+
+    LOG_INFO("Starting {}, lisening on: {}...", name_, bind_endpoint.to_string());
     // Create server socket
-    server_socket_ = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    server_socket_ = ::socket(bind_endpoint.socket_family(), SOCK_STREAM, IPPROTO_TCP);
     if (server_socket_ == INVALID_SOCKET)
     {
         LOG_ERROR("Failed to create server socket");
@@ -88,13 +106,21 @@ inline bool TCPServerBase<DrivedT>::start()
         setsockopt(server_socket_, SOL_SOCKET, SO_REUSEADDR, (char*)&opt, sizeof(opt));
     }
 
+    // Windows defaults IPV6_V6ONLY to on; clear it for dual-stack
+    if (bind_endpoint.is_v6())
+    {
+        DWORD v6_only = config_.ipv6_only ? 1 : 0;
+        if (setsockopt(server_socket_, IPPROTO_IPV6, IPV6_V6ONLY, (char*)&v6_only, sizeof(v6_only)) == SOCKET_ERROR)
+        {
+            LOG_WARN("Failed to set IPV6_V6ONLY. error={}", WSAGetLastError());
+        }
+    }
+
     // Bind socket
-    sockaddr_in server_addr{};
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(config_.port);
-    server_addr.sin_addr.s_addr = INADDR_ANY;
+    sockaddr_storage server_addr{};
+    int addr_len = bind_endpoint.to_sockaddr(server_addr);
 
-    if (bind(server_socket_, (sockaddr*)&server_addr, sizeof(server_addr)) == SOCKET_ERROR)
+    if (bind(server_socket_, (sockaddr*)&server_addr, addr_len) == SOCKET_ERROR)
     {
         LOG_ERROR("Failed to bind socket");
         closesocket(server_socket_);
@@ -102,6 +128,31 @@ inline bool TCPServerBase<DrivedT>::start()
         return false;
     }
 
+    addr_len = sizeof(server_addr);
+    Endpoint bound;
+    if (getsockname(server_socket_, (sockaddr*)&server_addr, &addr_len) == 0 && bound.from_sockaddr((sockaddr*)&server_addr))
+    {
+        bound_port_ = bound.port;
+    }
+
+    if (config_.tcp_fastopen_queue > 0)
+    {
+#ifdef TCP_FASTOPEN
+        DWORD enable = 1;
+        if (setsockopt(server_socket_, IPPROTO_TCP, TCP_FASTOPEN, (char*)&enable, sizeof(enable)) == SOCKET_ERROR)
+        {
+            LOG_WARN("Failed to enable TCP Fast Open");
+        }
+#else
+        LOG_WARN("TCP Fast Open not supported by this SDK");
+#endif
+    }
+
+    if (config_.defer_accept_seconds > 0)
+    {
+        LOG_WARN("TCP_DEFER_ACCEPT not supported on Windows");
+    }
+
     // Listen for connections
     if (listen(server_socket_, SOMAXCONN) == SOCKET_ERROR)
     {
@@ -111,17 +162,44 @@ inline bool TCPServerBase<DrivedT>::start()
         return false;
     }
 
+    startup_report_.socket_setup = elapsed_since(started_at);
+    loop_ready_.store(false, std::memory_order_relaxed);
+    tasks_.clear();     // a post() that raced with the last stop() belongs to that run
     running_.store(true, std::memory_order_release);
 
     // Start single-threaded server loop
-    server_thread_ = std::thread(&TCPServerBase<DrivedT>::server_loop, this);
+    server_thread_ = std::thread(&TCPServerBase<DrivedT, TraitsT>::server_loop, this);
+
+    if (config_.warmup.enabled)
+    {
+        auto phase = std::chrono::steady_clock::now();
+        loop_ready_.wait(false, std::memory_order_acquire);
+        startup_report_.loop_ready = elapsed_since(phase);
 
-    LOG_INFO("{} started", name_);
+        if (config_.warmup.lock_memory)
+        {
+            phase = std::chrono::steady_clock::now();
+            startup_report_.bytes_locked = BufferPool::instance().lock_memory();
+            if (startup_report_.bytes_locked == 0)
+            {
+                LOG_WARN("Failed to lock buffer memory: error {}", GetLastError());
+            }
+            startup_report_.memory_lock = elapsed_since(phase);
+        }
+
+        if (config_.warmup.loopback_messages > 0)
+        {
+            LOG_WARN("Loopback warm-up traffic not supported on Windows");
+        }
+    }
+
+    startup_report_.total = elapsed_since(started_at);
+    LOG_INFO("{} started in {} us", name_, startup_report_.total.count());
     return true;
 }
 
-template<typename DrivedT>
-inline void TCPServerBase<DrivedT>::stop()
+template<typename DrivedT, typename TraitsT>
+inline void TCPServerBase<DrivedT, TraitsT>::stop()
 {
     if (!running_.load(std::memory_order_relaxed))
     {
@@ -144,12 +222,16 @@ inline void TCPServerBase<DrivedT>::stop()
     }
     clients_.clear();
     socket_to_client_id_.clear();
+    inbound_activity_.clear();
+    outbound_activity_.clear();
 
     // Wait for server thread to finish
     if (server_thread_.joinable())
     {
         server_thread_.join();
     }
+    server_thread_id_.store(std::thread::id(), std::memory_order_release);
+    tasks_.clear();
 
     // Clean up epoll
     if (epoll_fd_ != nullptr)
@@ -161,8 +243,28 @@ inline void TCPServerBase<DrivedT>::stop()
     LOG_INFO("{} stopped", name_);
 }
 
-template<typename DrivedT>
-inline bool TCPServerBase<DrivedT>::send_data(int client_id, const std::vector<uint8_t>& data)
+template<typename DrivedT, typename TraitsT>
+inline void TCPServerBase<DrivedT, TraitsT>::stop_gracefully(std::chrono::milliseconds drain_timeout)
+{
+    // wepoll cannot wait on an eventfd and sends are synchronous on Windows,
+    // so there is no outbound queue to drain.
+    LOG_WARN("Graceful drain not supported on Windows, stopping {} immediately", name_);
+    stop();
+}
+
+template<typename DrivedT, typename TraitsT>
+inline bool TCPServerBase<DrivedT, TraitsT>::post(std::function<void()> task)
+{
+    if (!running_.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    tasks_.push(std::move(task));
+    return true;
+}
+
+template<typename DrivedT, typename TraitsT>
+inline bool TCPServerBase<DrivedT, TraitsT>::send_data(int client_id, const std::vector<uint8_t>& data)
 {
     auto it = clients_.find(client_id);
     if (it == clients_.end())
@@ -204,37 +306,202 @@ inline bool TCPServerBase<DrivedT>::send_data(int client_id, const std::vector<u
         
         if (sent > 0 && total_sent < data_size)
         {
-            LOG_TRACE("Partial send to client {}: sent {} bytes, {} remaining", 
-                           client_id, sent, data_size - total_sent);
+            if constexpr (TraitsT::enable_logging)
+            {
+                LOG_TRACE("Partial send to client {}: sent {} bytes, {} remaining", 
+                               client_id, sent, data_size - total_sent);
+            }
         }
     }
+    note_outbound(it->second);
 
-    LOG_TRACE("Successfully sent {} bytes to client {}", total_sent, client_id);
+    if constexpr (TraitsT::enable_logging)
+    {
+        LOG_TRACE("Successfully sent {} bytes to client {}", total_sent, client_id);
+    }
     return true;
 }
 
-template<typename DrivedT>
-inline void TCPServerBase<DrivedT>::close_socket(SocketT socket)
+template<typename DrivedT, typename TraitsT>
+inline void TCPServerBase<DrivedT, TraitsT>::close_socket(SocketT socket)
 {
     epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, socket, nullptr);
     socket_to_client_id_.erase(socket);
     closesocket(socket);
 }
 
-template<typename DrivedT>
-inline void TCPServerBase<DrivedT>::disconnect_client(int client_id)
+template<typename DrivedT, typename TraitsT>
+inline void TCPServerBase<DrivedT, TraitsT>::update_interest(const ClientInfo& client)
+{
+    struct epoll_event ev;
+    ev.events = EPOLLOUT | EPOLLPRI | EPOLLRDHUP | (client.read_paused ? 0 : EPOLLIN);
+    ev.data.fd = (int)(intptr_t)client.socket;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, client.socket, &ev);
+}
+
+template<typename DrivedT, typename TraitsT>
+inline void TCPServerBase<DrivedT, TraitsT>::pause_reading(int client_id)
+{
+    set_read_paused(client_id, true);
+}
+
+template<typename DrivedT, typename TraitsT>
+inline void TCPServerBase<DrivedT, TraitsT>::resume_reading(int client_id)
+{
+    set_read_paused(client_id, false);
+}
+
+template<typename DrivedT, typename TraitsT>
+inline bool TCPServerBase<DrivedT, TraitsT>::is_reading_paused(int client_id) const
+{
+    auto it = clients_.find(client_id);
+    return it != clients_.end() && it->second.read_paused;
+}
+
+template<typename DrivedT, typename TraitsT>
+inline void TCPServerBase<DrivedT, TraitsT>::set_read_paused(int client_id, bool paused)
+{
+    if (!on_server_thread())
+    {
+        post([this, client_id, paused]() { set_read_paused(client_id, paused); });
+        return;
+    }
+
+    auto it = clients_.find(client_id);
+    if (it == clients_.end() || it->second.read_paused == paused)
+    {
+        return;
+    }
+
+    note_read_paused(client_id, it->second, paused);
+    it->second.read_paused = paused;
+    update_interest(it->second);
+}
+
+template<typename DrivedT, typename TraitsT>
+inline bool TCPServerBase<DrivedT, TraitsT>::send_data(int client_id, std::span<const ConstBuffer> buffers)
+{
+    auto it = clients_.find(client_id);
+    if (it == clients_.end())
+    {
+        return false;
+    }
+
+    constexpr size_t max_wsabuf = 16;
+    WSABUF wsabufs[max_wsabuf];
+    GatherCursor cursor;
+    cursor.advance(buffers, 0);
+
+    while (!cursor.done(buffers))
+    {
+        DWORD count = 0;
+        for (size_t i = cursor.index; i < buffers.size() && count < max_wsabuf; ++i)
+        {
+            size_t skip = i == cursor.index ? cursor.offset : 0;
+            wsabufs[count].buf = reinterpret_cast<CHAR*>(const_cast<uint8_t*>(buffers[i].data + skip));
+            wsabufs[count].len = static_cast<ULONG>(buffers[i].size - skip);
+            ++count;
+        }
+
+        DWORD sent = 0;
+        if (WSASend(it->second.socket, wsabufs, count, &sent, 0, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            int error = WSAGetLastError();
+            if (error == WSAEWOULDBLOCK)
+            {
+                // Socket buffer is full, retry immediately
+                continue;
+            }
+
+            LOG_ERROR("Failed to send data to client {}: error {}", client_id, error);
+            if (error == WSAECONNRESET || error == WSAECONNABORTED || error == WSAENOTCONN)
+            {
+                LOG_INFO("Connection lost during send to client {}, disconnecting", client_id);
+                disconnect_client(client_id);
+            }
+            return false;
+        }
+
+        cursor.advance(buffers, sent);
+    }
+    note_outbound(it->second);
+    return true;
+}
+
+template<typename DrivedT, typename TraitsT>
+inline bool TCPServerBase<DrivedT, TraitsT>::send_file(int client_id, int fd, uint64_t offset, uint64_t length)
+{
+    if (clients_.find(client_id) == clients_.end())
+    {
+        return false;
+    }
+
+    if (length == 0)
+    {
+        struct _stat64 info;
+        if (_fstat64(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < offset)
+        {
+            LOG_ERROR("send_file to client {}: length required for this descriptor", client_id);
+            return false;
+        }
+        length = static_cast<uint64_t>(info.st_size) - offset;
+    }
+    if (_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) < 0)
+    {
+        LOG_ERROR("send_file to client {}: cannot seek to {}", client_id, offset);
+        return false;
+    }
+
+    // No queue to park a file in here, so it is read and sent inline like send_data
+    std::vector<uint8_t> buffer(64 * 1024);
+    while (length > 0)
+    {
+        unsigned int chunk = static_cast<unsigned int>((std::min<uint64_t>)(length, buffer.size()));
+        int read = _read(fd, buffer.data(), chunk);
+        if (read <= 0)
+        {
+            LOG_ERROR("send_file to client {}: file ended {} bytes early", client_id, length);
+            return false;
+        }
+        ConstBuffer piece{buffer.data(), static_cast<size_t>(read)};
+        if (!send_data(client_id, std::span<const ConstBuffer>(&piece, 1)))
+        {
+            return false;
+        }
+        length -= static_cast<uint64_t>(read);
+    }
+    return true;
+}
+
+template<typename DrivedT, typename TraitsT>
+inline void TCPServerBase<DrivedT, TraitsT>::disconnect_client(int client_id)
 {
     auto it = clients_.find(client_id);
     if (it != clients_.end())
     {
         close_socket(it->second.socket);
+        untrack_activity(it->second);
         clients_.erase(it);
     }
 }
 
-template<typename DrivedT>
-void TCPServerBase<DrivedT>::server_loop()
+template<typename DrivedT, typename TraitsT>
+inline void TCPServerBase<DrivedT, TraitsT>::disconnect_client_after_flush(int client_id)
 {
+    // Sends complete inline here, so nothing is left queued
+    auto it = clients_.find(client_id);
+    if (it != clients_.end())
+    {
+        ::shutdown(it->second.socket, SD_SEND);
+        disconnect_client(client_id);
+    }
+}
+
+template<typename DrivedT, typename TraitsT>
+void TCPServerBase<DrivedT, TraitsT>::server_loop()
+{
+    server_thread_id_.store(std::this_thread::get_id(), std::memory_order_release);
+
     // Set CPU affinity if specified
     if (config_.cpu_affinity >= 0)
     {
@@ -252,11 +519,32 @@ void TCPServerBase<DrivedT>::server_loop()
         }
     }
 
+    // Keep the loop thread, its buffers and its connection state on one NUMA node
+    int numa_node = resolve_numa_node(config_.numa_node, config_.numa_interface);
+    if (numa_node >= 0)
+    {
+        if (config_.cpu_affinity < 0 && !pin_thread_to_numa_node(numa_node))
+        {
+            LOG_WARN("Failed to pin server thread to NUMA node {}", numa_node);
+        }
+        if (!prefer_numa_node_for_thread(numa_node))
+        {
+            LOG_WARN("Failed to set memory policy for NUMA node {}", numa_node);
+        }
+        BufferPool::instance().set_thread_node(numa_node);
+        LOG_INFO("Server thread placed on NUMA node {}", numa_node);
+    }
+    else if (!config_.numa_interface.empty())
+    {
+        LOG_WARN("NUMA node of {} unknown, server thread left unplaced", config_.numa_interface);
+    }
+
     // Create epoll instance using wepoll
     epoll_fd_ = epoll_create1(0);
     if (epoll_fd_ == nullptr)
     {
         LOG_ERROR("Failed to create epoll instance");
+        signal_loop_ready();
         return;
     }
 
@@ -268,23 +556,39 @@ void TCPServerBase<DrivedT>::server_loop()
     {
         LOG_ERROR("Failed to add server socket to epoll");
         epoll_close(epoll_fd_);
+        signal_loop_ready();
         return;
     }
 
-    const int MAX_EVENTS = 64;
-    struct epoll_event events[MAX_EVENTS];
-    std::vector<uint8_t> buffer(config_.receive_buffer_size);
-
-    int timeout = 0;
-    if (config_.cpu_affinity < 0)
+    struct epoll_event events[TraitsT::max_events];
+    auto buffer = make_receive_buffer<TraitsT>(config_.receive_buffer_size);
+    if (config_.warmup.enabled)
     {
-        // CPU isn't pinned wait for 1 ms
-        timeout = 1;
+        warm_up_loop_state(buffer, numa_node);
     }
+    signal_loop_ready();
+
+    // Posted tasks are only picked up between waits, so blocking is capped at 1 ms
+    const int timeout = idle_wait_timeout<TraitsT>(config_.cpu_affinity >= 0) == 0 ? 0 : 1;
 
     while (running_.load(std::memory_order_relaxed))
     {
-        int num_events = epoll_wait(epoll_fd_, events, MAX_EVENTS, timeout);
+        // No eventfd under wepoll: posted work is picked up on every iteration
+        if (!tasks_.empty())
+        {
+            auto timing = callback_scope(LoopCallback::Task, -1);
+            tasks_.run_all();
+        }
+        if (config_.heartbeat.enabled())
+        {
+            service_heartbeats();
+        }
+
+        loop_monitor_.loop_idle();
+        TraceSpanFor<TraitsT> wait_span(TraceKind::Wait);
+        int num_events = epoll_wait(epoll_fd_, events, TraitsT::max_events, timeout);
+        loop_monitor_.loop_busy();
+        wait_span.end_or_discard(num_events);
         if (num_events < 0)
         {
             if (errno == EINTR)
@@ -294,6 +598,14 @@ void TCPServerBase<DrivedT>::server_loop()
             LOG_ERROR("epoll_wait failed: {}", WSAGetLastError());
             break;
         }
+        if (num_events > 0)
+        {
+            stamp_receive_time();
+            if (config_.heartbeat.enabled())
+            {
+                activity_now_ = std::chrono::steady_clock::now();
+            }
+        }
 
         for (int i = 0; i < num_events; i++)
         {
@@ -308,13 +620,36 @@ void TCPServerBase<DrivedT>::server_loop()
             {
                 // Data from client socket - O(1) lookup using socket_to_client_id_ map
                 auto it = socket_to_client_id_.find(sock);
-                if (it != socket_to_client_id_.end())
+                if (it == socket_to_client_id_.end())
+                {
+                    continue;
+                }
+
+                auto client_it = clients_.find(it->second);
+                if (client_it == clients_.end())
+                {
+                    continue;
+                }
+
+                if (client_it->second.priority == ConnectionPriority::High)
                 {
                     handle_client_data(it->second, buffer);
                 }
+                else if (!client_it->second.low_priority_ready)
+                {
+                    // Deferred until every high-priority event of this batch is handled
+                    client_it->second.low_priority_ready = true;
+                    low_priority_ready_.push_back(it->second);
+                }
             }
         }
+
+        if (!low_priority_ready_.empty())
+        {
+            service_low_priority_clients(buffer);
+        }
     }
+    loop_monitor_.loop_idle();
 
     // Clean up
     if (epoll_fd_ != nullptr)
@@ -324,10 +659,58 @@ void TCPServerBase<DrivedT>::server_loop()
     }
 }
 
-template<typename DrivedT>
-void TCPServerBase<DrivedT>::accept_new_client()
+template<typename DrivedT, typename TraitsT>
+void TCPServerBase<DrivedT, TraitsT>::service_low_priority_clients(ReceiveBuffer<TraitsT>& buffer)
+{
+    // Level-triggered: clients skipped once the budget is spent are reported again by epoll_wait
+    size_t budget = config_.low_priority_read_budget > 0 ? config_.low_priority_read_budget : SIZE_MAX;
+    while (!low_priority_ready_.empty() && budget > 0)
+    {
+        int client_id = low_priority_ready_.front();
+        low_priority_ready_.pop_front();
+
+        auto it = clients_.find(client_id);
+        if (it != clients_.end())
+        {
+            it->second.low_priority_ready = false;
+            handle_client_data(client_id, buffer, &budget);
+        }
+    }
+}
+
+template<typename DrivedT, typename TraitsT>
+inline bool TCPServerBase<DrivedT, TraitsT>::get_connection_health(int client_id, TCPConnectionHealth& health) const
+{
+    // TCP_INFO sampling is not implemented on Windows; samples stays 0
+    auto it = clients_.find(client_id);
+    if (it == clients_.end())
+    {
+        return false;
+    }
+    health = it->second.health;
+    return true;
+}
+
+template<typename DrivedT, typename TraitsT>
+inline void TCPServerBase<DrivedT, TraitsT>::set_client_priority(int client_id, ConnectionPriority priority)
+{
+    if (!on_server_thread())
+    {
+        post([this, client_id, priority]() { set_client_priority(client_id, priority); });
+        return;
+    }
+
+    auto it = clients_.find(client_id);
+    if (it != clients_.end())
+    {
+        it->second.priority = priority;
+    }
+}
+
+template<typename DrivedT, typename TraitsT>
+void TCPServerBase<DrivedT, TraitsT>::accept_new_client()
 {
-    sockaddr_in client_addr{};
+    sockaddr_storage client_addr{};
     int addr_len = sizeof(client_addr);
 
     SOCKET client_socket = accept(server_socket_, (sockaddr*)&client_addr, &addr_len);
@@ -361,43 +744,60 @@ void TCPServerBase<DrivedT>::accept_new_client()
         return;
     }
 
-    // Get client address
-    char addr_str[INET_ADDRSTRLEN];
-    inet_ntop(AF_INET, &client_addr.sin_addr, addr_str, INET_ADDRSTRLEN);
+    Endpoint endpoint;
+    endpoint.from_sockaddr((sockaddr*)&client_addr);
 
     int client_id = next_client_id_.fetch_add(1);
-    std::string client_address = addr_str;
+    std::string client_address = endpoint.address_string();
 
     // Add client to maps
-    clients_[client_id] = {client_socket, client_address};
+    clients_[client_id] = {client_socket, endpoint};
     socket_to_client_id_[client_socket] = client_id;
+    track_activity(client_id, clients_[client_id]);
 
     // Notify about new client
+    auto timing = callback_scope(LoopCallback::Connected, client_id);
     derived().onClientConnected(client_id, client_address);
 }
 
-template<typename DrivedT>
-void TCPServerBase<DrivedT>::handle_client_data(int client_id, std::vector<uint8_t>& buffer)
+template<typename DrivedT, typename TraitsT>
+bool TCPServerBase<DrivedT, TraitsT>::handle_client_data(int client_id, ReceiveBuffer<TraitsT>& buffer, size_t* byte_budget)
 {
+    // Events other than EPOLLIN still arrive for paused clients; leave their data in the kernel
     auto it = clients_.find(client_id);
-    if (it == clients_.end())
+    if (it == clients_.end() || it->second.read_paused)
     {
-        return;
+        return false;
+    }
+
+    // Level-triggered: one read per event, the remainder is reported again
+    size_t request = buffer.size();
+    if (byte_budget)
+    {
+        request = (std::min)(request, *byte_budget);
     }
 
     SOCKET socket = it->second.socket;
-    int received = recv(socket, (char*)buffer.data(), (int)buffer.size(), 0);
+    int received = recv(socket, (char*)buffer.data(), (int)request, 0);
 
     if (received > 0)
     {
+        if (byte_budget)
+        {
+            *byte_budget -= static_cast<size_t>(received);
+        }
+        note_inbound(it->second);
+        auto timing = callback_scope(LoopCallback::Data, client_id);
         derived().onClientData(client_id, buffer.data(), received);
     }
     else if (received == 0)
     {
         // Client disconnected
         close_socket(socket);
+        untrack_activity(it->second);
         clients_.erase(it);
         // Notify about client disconnection
+        auto timing = callback_scope(LoopCallback::Disconnected, client_id);
         derived().onClientDisconnected(client_id);
     }
     else
@@ -408,10 +808,13 @@ void TCPServerBase<DrivedT>::handle_client_data(int client_id, std::vector<uint8
         {
             LOG_ERROR("Receive error for client ID={}", client_id);
             close_socket(socket);
+            untrack_activity(it->second);
             clients_.erase(it);
+            auto timing = callback_scope(LoopCallback::Disconnected, client_id);
             derived().onClientDisconnected(client_id);
         }
     }
+    return false;
 }
 
 } // namespace slick::socket
@@ -0,0 +1,402 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <slick/socket/logger.h>
+
+#if defined(SLICK_SOCKET_ENABLE_TLS)
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#endif
+
+namespace slick::socket
+{
+
+// Optional TLS for TCPServerBase and TCPClientBase (Unix). Requires building with
+// SLICK_SOCKET_ENABLE_TLS (OpenSSL); start()/connect() fail when TLS is enabled without it.
+struct TLSConfig
+{
+    bool enabled = false;
+    std::string certificate_file;       // PEM chain; required on the server, optional client certificate
+    std::string private_key_file;       // PEM key for certificate_file
+    std::string ca_file;                // verify the peer against these CAs; empty = system CAs (client) or none (server)
+    bool verify_peer = true;            // client: check the server certificate and host name
+    std::string server_name;            // client: SNI and expected host name, empty = server_address
+    bool kernel_offload = true;         // move the record layer into the kernel (kTLS) after the handshake
+};
+
+// Directions whose record layer runs in the kernel (kTLS) rather than in OpenSSL
+struct TLSOffload
+{
+    bool send = false;
+    bool receive = false;
+};
+
+enum class TLSHandshakeStatus : uint8_t
+{
+    Done,
+    WantRead,
+    WantWrite,
+    Failed,
+};
+
+#if defined(SLICK_SOCKET_ENABLE_TLS)
+
+namespace tls_detail
+{
+
+inline std::string last_error()
+{
+    unsigned long code = ERR_get_error();
+    if (code == 0)
+    {
+        return "unknown error";
+    }
+    char text[256];
+    ERR_error_string_n(code, text, sizeof(text));
+    ERR_clear_error();
+    return text;
+}
+
+} // namespace tls_detail
+
+// SSL_CTX shared by the connections of one server or client
+class TLSContext
+{
+public:
+    TLSContext() = default;
+    ~TLSContext() { reset(); }
+
+    TLSContext(const TLSContext&) = delete;
+    TLSContext& operator=(const TLSContext&) = delete;
+
+    TLSContext(TLSContext&& other) noexcept
+        : ctx_(std::exchange(other.ctx_, nullptr))
+        , verify_peer_(other.verify_peer_)
+    {
+    }
+
+    TLSContext& operator=(TLSContext&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            ctx_ = std::exchange(other.ctx_, nullptr);
+            verify_peer_ = other.verify_peer_;
+        }
+        return *this;
+    }
+
+    bool open(const TLSConfig& config, bool server)
+    {
+        reset();
+        ctx_ = SSL_CTX_new(server ? TLS_server_method() : TLS_client_method());
+        if (!ctx_)
+        {
+            LOG_ERROR("Failed to create TLS context: {}", tls_detail::last_error());
+            return false;
+        }
+
+        SSL_CTX_set_min_proto_version(ctx_, TLS1_2_VERSION);
+        // Partial writes let send paths queue the remainder like they do for plain sockets
+        SSL_CTX_set_mode(ctx_, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+#if defined(SSL_OP_ENABLE_KTLS)
+        if (config.kernel_offload)
+        {
+            SSL_CTX_set_options(ctx_, SSL_OP_ENABLE_KTLS);
+        }
+#endif
+        if (server)
+        {
+            // No session tickets: nothing but application data follows the handshake, which
+            // keeps the receive side eligible for kTLS with older OpenSSL releases
+            SSL_CTX_set_num_tickets(ctx_, 0);
+        }
+
+        if (!config.certificate_file.empty())
+        {
+            if (SSL_CTX_use_certificate_chain_file(ctx_, config.certificate_file.c_str()) != 1 ||
+                SSL_CTX_use_PrivateKey_file(ctx_, config.private_key_file.c_str(), SSL_FILETYPE_PEM) != 1 ||
+                SSL_CTX_check_private_key(ctx_) != 1)
+            {
+                LOG_ERROR("Failed to load TLS certificate {}: {}", config.certificate_file, tls_detail::last_error());
+                reset();
+                return false;
+            }
+        }
+        else if (server)
+        {
+            LOG_ERROR("TLS server requires certificate_file and private_key_file");
+            reset();
+            return false;
+        }
+
+        verify_peer_ = server ? !config.ca_file.empty() : config.verify_peer;
+        if (verify_peer_)
+        {
+            bool loaded = config.ca_file.empty() ? SSL_CTX_set_default_verify_paths(ctx_) == 1
+                                                 : SSL_CTX_load_verify_locations(ctx_, config.ca_file.c_str(), nullptr) == 1;
+            if (!loaded)
+            {
+                LOG_ERROR("Failed to load TLS CA certificates: {}", tls_detail::last_error());
+                reset();
+                return false;
+            }
+            SSL_CTX_set_verify(ctx_, SSL_VERIFY_PEER | (server ? SSL_VERIFY_FAIL_IF_NO_PEER_CERT : 0), nullptr);
+        }
+        return true;
+    }
+
+    void reset()
+    {
+        if (ctx_)
+        {
+            SSL_CTX_free(ctx_);
+            ctx_ = nullptr;
+        }
+    }
+
+    SSL_CTX* get() const noexcept { return ctx_; }
+    bool verify_peer() const noexcept { return verify_peer_; }
+    explicit operator bool() const noexcept { return ctx_ != nullptr; }
+
+private:
+    SSL_CTX* ctx_ = nullptr;
+    bool verify_peer_ = false;
+};
+
+// One TLS connection over a non-blocking socket. read()/write() follow recv()/send():
+// bytes transferred, 0 when the peer closed, -1 with errno EAGAIN when the record layer needs
+// the socket to become readable/writable, or EIO. With kTLS active OpenSSL passes plaintext
+// straight to the kernel, so no record is encrypted or decrypted in user space.
+class TLSSession
+{
+public:
+    TLSSession() = default;
+    ~TLSSession() { reset(); }
+
+    TLSSession(const TLSSession&) = delete;
+    TLSSession& operator=(const TLSSession&) = delete;
+
+    TLSSession(TLSSession&& other) noexcept
+        : ssl_(std::exchange(other.ssl_, nullptr))
+        , established_(other.established_)
+    {
+    }
+
+    TLSSession& operator=(TLSSession&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            ssl_ = std::exchange(other.ssl_, nullptr);
+            established_ = other.established_;
+        }
+        return *this;
+    }
+
+    // host: SNI and certificate name for client sessions
+    bool open(const TLSContext& context, int socket, bool server, const std::string& host = {})
+    {
+        reset();
+        ssl_ = SSL_new(context.get());
+        if (!ssl_ || SSL_set_fd(ssl_, socket) != 1)
+        {
+            LOG_ERROR("Failed to create TLS session: {}", tls_detail::last_error());
+            reset();
+            return false;
+        }
+        if (server)
+        {
+            SSL_set_accept_state(ssl_);
+        }
+        else
+        {
+            SSL_set_connect_state(ssl_);
+            if (!host.empty())
+            {
+                SSL_set_tlsext_host_name(ssl_, host.c_str());
+                if (context.verify_peer())
+                {
+                    SSL_set1_host(ssl_, host.c_str());
+                }
+            }
+        }
+        return true;
+    }
+
+    TLSHandshakeStatus handshake()
+    {
+        ERR_clear_error();
+        int result = SSL_do_handshake(ssl_);
+        if (result == 1)
+        {
+            established_ = true;
+            return TLSHandshakeStatus::Done;
+        }
+        switch (SSL_get_error(ssl_, result))
+        {
+        case SSL_ERROR_WANT_READ:
+            return TLSHandshakeStatus::WantRead;
+        case SSL_ERROR_WANT_WRITE:
+            return TLSHandshakeStatus::WantWrite;
+        default:
+            LOG_WARN("TLS handshake failed: {}", tls_detail::last_error());
+            return TLSHandshakeStatus::Failed;
+        }
+    }
+
+    std::ptrdiff_t read(void* data, size_t size)
+    {
+        ERR_clear_error();
+        errno = 0;      // map_error() tells an EOF from a socket error by errno
+        int result = SSL_read(ssl_, data, static_cast<int>(size < INT_MAX ? size : INT_MAX));
+        return result > 0 ? result : map_error(result);
+    }
+
+    std::ptrdiff_t write(const void* data, size_t size)
+    {
+        if (size == 0)
+        {
+            return 0;
+        }
+        ERR_clear_error();
+        errno = 0;
+        int result = SSL_write(ssl_, data, static_cast<int>(size < INT_MAX ? size : INT_MAX));
+        return result > 0 ? result : map_error(result);
+    }
+
+    // File to socket without user-space copies; only possible once the kernel owns the send side
+    std::ptrdiff_t sendfile(int fd, uint64_t offset, size_t size)
+    {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_NO_KTLS)
+        ERR_clear_error();
+        errno = 0;
+        ossl_ssize_t result = SSL_sendfile(ssl_, fd, static_cast<off_t>(offset), size, 0);
+        return result >= 0 ? result : map_error(static_cast<int>(result));
+#else
+        (void)fd;
+        (void)offset;
+        (void)size;
+        errno = EOPNOTSUPP;
+        return -1;
+#endif
+    }
+
+    // Send close_notify; the socket is shut down separately
+    void shutdown()
+    {
+        if (ssl_ && established_)
+        {
+            ERR_clear_error();
+            SSL_shutdown(ssl_);
+        }
+    }
+
+    // True when the kernel took over the record layer in that direction
+    bool kernel_send() const noexcept
+    {
+#if !defined(OPENSSL_NO_KTLS)
+        return ssl_ && BIO_get_ktls_send(SSL_get_wbio(ssl_));
+#else
+        return false;
+#endif
+    }
+
+    bool kernel_receive() const noexcept
+    {
+#if !defined(OPENSSL_NO_KTLS)
+        return ssl_ && BIO_get_ktls_recv(SSL_get_rbio(ssl_));
+#else
+        return false;
+#endif
+    }
+
+    TLSOffload offload() const noexcept { return {kernel_send(), kernel_receive()}; }
+    bool established() const noexcept { return established_; }
+    explicit operator bool() const noexcept { return ssl_ != nullptr; }
+
+    void reset()
+    {
+        if (ssl_)
+        {
+            SSL_free(ssl_);     // the socket is owned and closed by the caller
+            ssl_ = nullptr;
+        }
+        established_ = false;
+    }
+
+private:
+    std::ptrdiff_t map_error(int result)
+    {
+        switch (SSL_get_error(ssl_, result))
+        {
+        case SSL_ERROR_WANT_READ:
+        case SSL_ERROR_WANT_WRITE:
+            errno = EAGAIN;
+            return -1;
+        case SSL_ERROR_ZERO_RETURN:
+            return 0;
+        case SSL_ERROR_SYSCALL:
+            // EOF without close_notify is reported as a close, socket errors keep their errno.
+            // Callers clear errno first, or a stale EAGAIN would hide the EOF.
+            if (errno == 0)
+            {
+                return 0;
+            }
+            return -1;
+        default:
+            LOG_ERROR("TLS error: {}", tls_detail::last_error());
+            errno = EIO;
+            return -1;
+        }
+    }
+
+    SSL* ssl_ = nullptr;
+    bool established_ = false;
+};
+
+#else
+
+// Built without SLICK_SOCKET_ENABLE_TLS: sessions never open and the plain socket path is used
+class TLSContext
+{
+public:
+    bool open(const TLSConfig&, bool)
+    {
+        LOG_ERROR("TLS requested but slick-socket was built without SLICK_SOCKET_ENABLE_TLS");
+        return false;
+    }
+    void reset() {}
+    bool verify_peer() const noexcept { return false; }
+    explicit operator bool() const noexcept { return false; }
+};
+
+class TLSSession
+{
+public:
+    bool open(const TLSContext&, int, bool, const std::string& = {}) { return false; }
+    TLSHandshakeStatus handshake() { return TLSHandshakeStatus::Failed; }
+    std::ptrdiff_t read(void*, size_t) { errno = EIO; return -1; }
+    std::ptrdiff_t write(const void*, size_t) { errno = EIO; return -1; }
+    std::ptrdiff_t sendfile(int, uint64_t, size_t) { errno = EOPNOTSUPP; return -1; }
+    void shutdown() {}
+    bool kernel_send() const noexcept { return false; }
+    bool kernel_receive() const noexcept { return false; }
+    TLSOffload offload() const noexcept { return {}; }
+    bool established() const noexcept { return false; }
+    explicit operator bool() const noexcept { return false; }
+    void reset() {}
+};
+
+#endif
+
+} // namespace slick::socket
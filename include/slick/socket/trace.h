@@ -0,0 +1,455 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <slick/socket/cache_line.h>
+#include <slick/socket/clock.h>
+#include <slick/socket/watchdog.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace slick::socket
+{
+
+// Spans recorded on the I/O path (TraitsT::enable_tracing)
+enum class TraceKind : uint8_t
+{
+    Wait,       // epoll/kqueue wait that returned events; value = event count
+    Receive,    // recv()/recvfrom(); value = bytes
+    Callback,   // user callback, named by its LoopCallback
+    Send,       // send()/sendmsg(); value = bytes
+    Flush,      // flush of a client's queued output on EPOLLOUT
+};
+
+struct TraceRecord
+{
+    uint64_t begin = 0;         // TscClock ticks
+    uint64_t end = 0;
+    int32_t client_id = -1;
+    uint32_t value = 0;
+    TraceKind kind = TraceKind::Wait;
+    LoopCallback callback = LoopCallback::None;
+};
+
+// Ring of the spans recorded by one thread. Only that thread writes; a dump may read at any time,
+// so it returns the last capacity - 1 spans (the oldest slot may be mid-overwrite) and skips slots
+// overwritten while it copied them. Slots are relaxed atomic words, plain stores on x86-64 and ARM64.
+class TraceBuffer
+{
+public:
+    TraceBuffer(std::string thread_name, bool named, uint32_t thread_index, size_t capacity)
+        : thread_name_(std::move(thread_name))
+        , named_(named)
+        , thread_index_(thread_index)
+        , mask_(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1)
+        , slots_(std::make_unique<Slot[]>(mask_ + 1))
+    {
+        // Fault the pages in now rather than on the loop's first spans
+        for (size_t i = 0; i <= mask_; ++i)
+        {
+            slots_[i].words[0].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void push(const TraceRecord& record) noexcept
+    {
+        uint64_t index = written_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[index & mask_];
+        slot.words[0].store(record.begin, std::memory_order_relaxed);
+        slot.words[1].store(record.end, std::memory_order_relaxed);
+        slot.words[2].store(static_cast<uint32_t>(record.client_id) | (static_cast<uint64_t>(record.value) << 32),
+                            std::memory_order_relaxed);
+        slot.words[3].store(static_cast<uint64_t>(record.kind) | (static_cast<uint64_t>(record.callback) << 8),
+                            std::memory_order_relaxed);
+        written_.store(index + 1, std::memory_order_release);
+    }
+
+    // Spans still in the ring and recorded since the last clear(), oldest first
+    std::vector<TraceRecord> snapshot() const
+    {
+        uint64_t last = written_.load(std::memory_order_acquire);
+        uint64_t first = std::max(cleared_.load(std::memory_order_relaxed), last > mask_ ? last - mask_ - 1 : 0);
+        std::vector<TraceRecord> records;
+        records.reserve(static_cast<size_t>(last - first));
+        for (uint64_t i = first; i < last; ++i)
+        {
+            const Slot& slot = slots_[i & mask_];
+            TraceRecord record;
+            record.begin = slot.words[0].load(std::memory_order_relaxed);
+            record.end = slot.words[1].load(std::memory_order_relaxed);
+            uint64_t detail = slot.words[2].load(std::memory_order_relaxed);
+            uint64_t kind = slot.words[3].load(std::memory_order_relaxed);
+            record.client_id = static_cast<int32_t>(static_cast<uint32_t>(detail));
+            record.value = static_cast<uint32_t>(detail >> 32);
+            record.kind = static_cast<TraceKind>(kind & 0xFF);
+            record.callback = static_cast<LoopCallback>((kind >> 8) & 0xFF);
+            records.push_back(record);
+        }
+
+        // Slots the writer lapped while they were copied are dropped
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t now = written_.load(std::memory_order_relaxed);
+        uint64_t valid = now > mask_ ? now - mask_ : 0;     // the writer may be in slot now - capacity
+        if (valid > first)
+        {
+            records.erase(records.begin(), records.begin() + static_cast<ptrdiff_t>(std::min(valid - first, last - first)));
+        }
+        return records;
+    }
+
+    void clear() noexcept
+    {
+        cleared_.store(written_.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    const std::string& thread_name() const noexcept { return thread_name_; }
+    bool named() const noexcept { return named_; }
+    uint32_t thread_index() const noexcept { return thread_index_; }
+
+    // Owned by a running thread; released buffers are handed to the next thread of the same name
+    bool in_use = true;     // guarded by the Tracer registry mutex
+
+private:
+    struct Slot
+    {
+        std::array<std::atomic<uint64_t>, 4> words;
+    };
+
+    std::string thread_name_;
+    bool named_;
+    uint32_t thread_index_;
+    size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(cache_line_size) std::atomic<uint64_t> written_{0};
+    alignas(cache_line_size) std::atomic<uint64_t> cleared_{0};    // written by clear(), read by dumps
+};
+
+// Process-wide registry of the per-thread rings. Buffers outlive their threads so that a dump after
+// stop() still shows the loop's last spans. When a thread exits its buffer goes to the next thread
+// attached under the same name, so reconnecting clients do not add a ring each time.
+//
+// Dumps are Chrome trace event JSON, which chrome://tracing and ui.perfetto.dev both open.
+class Tracer
+{
+public:
+    // Ring size of buffers created from now on, in spans (32 bytes each), rounded up to a power of two
+    static void set_buffer_capacity(size_t spans) noexcept
+    {
+        capacity().store(spans, std::memory_order_relaxed);
+    }
+
+    // Creates the calling thread's buffer under name; loops call it when they start
+    static void attach_thread(std::string name)
+    {
+        Owner& owner = local();
+        if (owner.buffer == nullptr)
+        {
+            owner.buffer = create(std::move(name));
+        }
+    }
+
+    static void record(const TraceRecord& record) noexcept
+    {
+        Owner& owner = local();
+        if (owner.buffer == nullptr) [[unlikely]]
+        {
+            if (owner.unavailable)
+            {
+                return;
+            }
+            // Spans end in destructors on the I/O path: a ring that cannot be allocated leaves
+            // the thread untraced rather than terminating it
+            try
+            {
+                owner.buffer = create({});
+            }
+            catch (...)
+            {
+                owner.unavailable = true;
+                return;
+            }
+        }
+        owner.buffer->push(record);
+    }
+
+    // Forgets the spans recorded so far; safe while threads record
+    static void clear()
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        for (auto& buffer : registry().buffers)
+        {
+            buffer->clear();
+        }
+    }
+
+    static std::vector<std::pair<std::string, std::vector<TraceRecord>>> snapshot()
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        std::vector<std::pair<std::string, std::vector<TraceRecord>>> result;
+        for (auto& buffer : registry().buffers)
+        {
+            result.emplace_back(buffer->thread_name(), buffer->snapshot());
+        }
+        return result;
+    }
+
+    // Every thread's spans as Chrome trace event JSON ("X" complete events, timestamps in
+    // microseconds of steady_clock)
+    static std::string chrome_trace_json()
+    {
+        std::vector<const TraceBuffer*> buffers;
+        std::vector<std::vector<TraceRecord>> spans;
+        {
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            for (auto& buffer : registry().buffers)
+            {
+                buffers.push_back(buffer.get());
+                spans.push_back(buffer->snapshot());
+            }
+        }
+
+        // Ticks to steady_clock nanoseconds through one reference point taken after the copies
+        const uint64_t reference_ticks = TscClock::ticks();
+        const int64_t reference_ns = TscClock::now_ns();
+        auto to_us = [&](uint64_t ticks) {
+            int64_t ns = ticks <= reference_ticks ? reference_ns - static_cast<int64_t>(TscClock::to_ns(reference_ticks - ticks))
+                                                  : reference_ns + static_cast<int64_t>(TscClock::to_ns(ticks - reference_ticks));
+            return static_cast<double>(ns) / 1000.0;
+        };
+
+        std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        char line[256];
+        for (size_t t = 0; t < buffers.size(); ++t)
+        {
+            uint32_t tid = buffers[t]->thread_index();
+            json += first ? "\n" : ",\n";
+            first = false;
+            json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(tid) +
+                    ",\"args\":{\"name\":\"";
+            append_escaped(json, buffers[t]->thread_name());
+            json += "\"}}";
+
+            for (const TraceRecord& span : spans[t])
+            {
+                double begin = to_us(span.begin);
+                double duration = span.end > span.begin ? TscClock::to_ns(span.end - span.begin) / 1000.0 : 0.0;
+                int length = std::snprintf(line, sizeof(line),
+                                           ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                                           "\"pid\":1,\"tid\":%u,\"args\":{",
+                                           span_name(span), category(span.kind), begin, duration, tid);
+                json.append(line, static_cast<size_t>(length));
+                const char* separator = "";
+                if (span.client_id >= 0)
+                {
+                    json += "\"client\":" + std::to_string(span.client_id);
+                    separator = ",";
+                }
+                if (span.kind == TraceKind::Wait || span.kind == TraceKind::Receive || span.kind == TraceKind::Send)
+                {
+                    json += separator;
+                    json += span.kind == TraceKind::Wait ? "\"events\":" : "\"bytes\":";
+                    json += std::to_string(span.value);
+                }
+                json += "}}";
+            }
+        }
+        json += "\n]}\n";
+        return json;
+    }
+
+    // Writes chrome_trace_json() to path; false when the file cannot be written
+    static bool write_chrome_trace(const std::string& path)
+    {
+        std::string json = chrome_trace_json();
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+        bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+        return std::fclose(file) == 0 && written;
+    }
+
+private:
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<TraceBuffer>> buffers;
+    };
+
+    static Registry& registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    static std::atomic<size_t>& capacity() noexcept
+    {
+        static std::atomic<size_t> spans{size_t(1) << 16};
+        return spans;
+    }
+
+    // Releases the thread's buffer when the thread exits
+    struct Owner
+    {
+        TraceBuffer* buffer = nullptr;
+        bool unavailable = false;   // record() could not create the buffer
+
+        ~Owner()
+        {
+            if (buffer != nullptr)
+            {
+                std::lock_guard<std::mutex> lock(registry().mutex);
+                buffer->in_use = false;
+            }
+        }
+    };
+
+    static Owner& local() noexcept
+    {
+        thread_local Owner owner;
+        return owner;
+    }
+
+    static TraceBuffer* create(std::string name)
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        bool named = !name.empty();
+        for (auto& buffer : registry().buffers)
+        {
+            if (!buffer->in_use && buffer->named() == named && (!named || buffer->thread_name() == name))
+            {
+                buffer->in_use = true;
+                return buffer.get();
+            }
+        }
+        uint32_t index = static_cast<uint32_t>(registry().buffers.size()) + 1;
+        if (!named)
+        {
+            name = "thread " + std::to_string(index);
+        }
+        registry().buffers.push_back(std::make_unique<TraceBuffer>(std::move(name), named, index,
+                                                                   capacity().load(std::memory_order_relaxed)));
+        return registry().buffers.back().get();
+    }
+
+    static const char* span_name(const TraceRecord& span) noexcept
+    {
+        switch (span.kind)
+        {
+        case TraceKind::Wait: return "wait";
+        case TraceKind::Receive: return "recv";
+        case TraceKind::Send: return "send";
+        case TraceKind::Flush: return "flush";
+        default: return to_string(span.callback);
+        }
+    }
+
+    static const char* category(TraceKind kind) noexcept
+    {
+        return kind == TraceKind::Callback ? "callback" : "io";
+    }
+
+    static void append_escaped(std::string& out, const std::string& text)
+    {
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += c;
+            }
+            else if (static_cast<unsigned char>(c) >= 0x20)
+            {
+                out += c;
+            }
+        }
+    }
+};
+
+// Records one span from construction to end() or destruction: two counter reads and four stores
+class TraceSpan
+{
+public:
+    explicit TraceSpan(TraceKind kind, int client_id = -1, LoopCallback callback = LoopCallback::None) noexcept
+    {
+        record_.begin = TscClock::ticks();
+        record_.client_id = client_id;
+        record_.kind = kind;
+        record_.callback = callback;
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    ~TraceSpan()
+    {
+        if (record_.begin != 0)
+        {
+            end(0);
+        }
+    }
+
+    // Records the span now with value (bytes or events; negative results count as 0)
+    template<typename ValueT>
+    void end(ValueT value) noexcept
+    {
+        record_.end = TscClock::ticks();
+        record_.value = value > 0 ? static_cast<uint32_t>(std::min<uint64_t>(static_cast<uint64_t>(value), UINT32_MAX)) : 0;
+        Tracer::record(record_);
+        record_.begin = 0;
+    }
+
+    // As end(), but drops the span when value is not positive, e.g. a wait that returned nothing
+    template<typename ValueT>
+    void end_or_discard(ValueT value) noexcept
+    {
+        if (value > 0)
+        {
+            end(value);
+        }
+        record_.begin = 0;
+    }
+
+private:
+    TraceRecord record_;
+};
+
+// Stand-in when TraitsT::enable_tracing is false
+struct [[maybe_unused]] NoTraceSpan
+{
+    explicit NoTraceSpan(TraceKind, int = -1, LoopCallback = LoopCallback::None) noexcept {}
+    ~NoTraceSpan() {}   // not trivial, so an unused CallbackScope draws no warning
+
+    template<typename ValueT>
+    void end(ValueT) noexcept {}
+    template<typename ValueT>
+    void end_or_discard(ValueT) noexcept {}
+};
+
+template<typename TraitsT>
+using TraceSpanFor = std::conditional_t<TraitsT::enable_tracing, TraceSpan, NoTraceSpan>;
+
+// A user callback as seen by the loop monitor and the trace; both end when it goes out of scope
+template<typename TraitsT>
+struct [[maybe_unused]] CallbackScope
+{
+    typename LoopMonitorFor<TraitsT>::Scope timing;
+    TraceSpanFor<TraitsT> span;
+};
+
+} // namespace slick::socket
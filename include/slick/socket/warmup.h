@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace slick::socket
+{
+
+// Optional warm-up performed by start() before it returns, so the first real messages
+// do not pay for page faults, lazy allocation and cold code paths.
+struct WarmupConfig
+{
+    bool enabled = false;           // Wait for the loop thread to pre-touch its buffers and reserve its tables
+    bool lock_memory = false;       // mlock the BufferPool arenas (bounded by RLIMIT_MEMLOCK)
+    int loopback_messages = 0;      // Synthetic messages sent over loopback through accept/epoll/recv (TCP server)
+    size_t message_size = 64;       // Size of each synthetic message
+};
+
+// Phase timings of the last start(), available once it returns
+struct StartupReport
+{
+    std::chrono::microseconds socket_setup{0};  // socket creation, options, bind and listen/join
+    std::chrono::microseconds loop_ready{0};    // thread start, placement and loop state warm-up
+    std::chrono::microseconds memory_lock{0};
+    std::chrono::microseconds priming{0};       // synthetic loopback traffic
+    std::chrono::microseconds total{0};
+    size_t bytes_prefaulted = 0;                // buffer arena and loop buffer bytes touched
+    size_t bytes_locked = 0;
+    int primed_messages = 0;
+};
+
+inline std::chrono::microseconds elapsed_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+} // namespace slick::socket
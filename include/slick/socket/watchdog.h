@@ -0,0 +1,328 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <slick/socket/logger.h>
+#include <slick/socket/cache_line.h>
+#include <slick/socket/clock.h>
+#include <slick/socket/latency.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace slick::socket
+{
+
+// User callbacks an event loop runs, for stall reports and duration histograms
+enum class LoopCallback : uint8_t
+{
+    None,
+    Connected,      // onClientConnected / onConnected
+    Disconnected,   // onClientDisconnected / onDisconnected
+    Data,           // onClientData / onData / handle_multicast_data
+    Task,           // functions queued with post()
+    Heartbeat,      // onHeartbeatTimeout
+    HealthAlert,    // onConnectionHealthAlert
+    Count,
+};
+
+inline const char* to_string(LoopCallback callback) noexcept
+{
+    switch (callback)
+    {
+    case LoopCallback::None: return "none";
+    case LoopCallback::Connected: return "connected";
+    case LoopCallback::Disconnected: return "disconnected";
+    case LoopCallback::Data: return "data";
+    case LoopCallback::Task: return "task";
+    case LoopCallback::Heartbeat: return "heartbeat";
+    case LoopCallback::HealthAlert: return "health alert";
+    default: return "unknown";
+    }
+}
+
+// What a loop thread is doing, published for a Watchdog, plus the duration of every callback it
+// runs. Written by the loop thread only (TraitsT::enable_loop_monitor): a counter read and a few
+// relaxed stores per wake-up, two more counter reads per callback. Any thread may read.
+class alignas(cache_line_size) LoopMonitor
+{
+public:
+    struct Snapshot
+    {
+        uint64_t iteration = 0;         // wake-ups so far
+        bool busy = false;              // false while the loop waits for events
+        uint64_t busy_ns = 0;           // since the loop woke up
+        LoopCallback callback = LoopCallback::None;
+        int client_id = -1;             // of the running callback, -1 when not per client
+        uint64_t callback_ns = 0;       // since the running callback started
+    };
+
+    // Callback in progress; restored when a nested callback (e.g. a disconnect from within
+    // onClientData) returns
+    struct Frame
+    {
+        LoopCallback callback;
+        int client_id;
+        uint64_t started;
+    };
+
+    // Ends the callback it was created for when it goes out of scope
+    class Scope
+    {
+    public:
+        Scope(LoopMonitor& monitor, Frame outer) noexcept
+            : monitor_(&monitor)
+            , outer_(outer)
+        {
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope() { monitor_->callback_end(outer_); }
+
+    private:
+        LoopMonitor* monitor_;
+        Frame outer_;
+    };
+
+    // Loop thread: the wait returned / is about to be entered
+    void loop_busy() noexcept
+    {
+        busy_since_.store(TscClock::ticks(), std::memory_order_relaxed);
+        iteration_.store(iteration_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    void loop_idle() noexcept
+    {
+        busy_since_.store(0, std::memory_order_relaxed);
+    }
+
+    // Loop thread: times a callback until the returned scope ends
+    [[nodiscard]] Scope callback_scope(LoopCallback callback, int client_id) noexcept
+    {
+        Frame outer{callback_.load(std::memory_order_relaxed), client_id_.load(std::memory_order_relaxed),
+                    callback_started_.load(std::memory_order_relaxed)};
+        callback_.store(callback, std::memory_order_relaxed);
+        client_id_.store(client_id, std::memory_order_relaxed);
+        callback_started_.store(TscClock::ticks(), std::memory_order_relaxed);
+        return Scope(*this, outer);
+    }
+
+    Snapshot snapshot() const noexcept
+    {
+        Snapshot result;
+        result.iteration = iteration_.load(std::memory_order_acquire);
+        uint64_t busy_since = busy_since_.load(std::memory_order_relaxed);
+        uint64_t callback_started = callback_started_.load(std::memory_order_relaxed);
+        result.callback = callback_.load(std::memory_order_relaxed);
+        result.client_id = client_id_.load(std::memory_order_relaxed);
+        uint64_t now = TscClock::ticks();
+        result.busy = busy_since != 0;
+        result.busy_ns = result.busy && now > busy_since ? TscClock::to_ns(now - busy_since) : 0;
+        if (result.callback != LoopCallback::None && now > callback_started)
+        {
+            result.callback_ns = TscClock::to_ns(now - callback_started);
+        }
+        return result;
+    }
+
+    // Durations of completed callbacks of one kind, in nanoseconds
+    const LatencyHistogram& callback_histogram(LoopCallback callback) const noexcept
+    {
+        return histograms_[static_cast<size_t>(callback)];
+    }
+
+private:
+    void callback_end(const Frame& outer) noexcept
+    {
+        uint64_t elapsed = TscClock::ticks() - callback_started_.load(std::memory_order_relaxed);
+        histograms_[static_cast<size_t>(callback_.load(std::memory_order_relaxed))].record(TscClock::to_ns(elapsed));
+        callback_.store(outer.callback, std::memory_order_relaxed);
+        client_id_.store(outer.client_id, std::memory_order_relaxed);
+        callback_started_.store(outer.started, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> iteration_{0};
+    std::atomic<uint64_t> busy_since_{0};       // TscClock ticks, 0 while waiting
+    std::atomic<uint64_t> callback_started_{0};
+    std::atomic<LoopCallback> callback_{LoopCallback::None};
+    std::atomic<int> client_id_{-1};
+    std::array<LatencyHistogram, static_cast<size_t>(LoopCallback::Count)> histograms_;
+};
+
+// Stand-in when TraitsT::enable_loop_monitor is false; every call compiles to nothing
+struct NoLoopMonitor
+{
+    struct [[maybe_unused]] Scope
+    {
+    };
+
+    void loop_busy() noexcept {}
+    void loop_idle() noexcept {}
+    Scope callback_scope(LoopCallback, int) noexcept { return {}; }
+};
+
+template<typename TraitsT>
+using LoopMonitorFor = std::conditional_t<TraitsT::enable_loop_monitor, LoopMonitor, NoLoopMonitor>;
+
+struct WatchdogConfig
+{
+    std::chrono::milliseconds stall_threshold{100}; // report a loop busy for longer than this
+    std::chrono::milliseconds check_interval{10};   // how often the watchdog thread looks
+};
+
+struct StallReport
+{
+    std::string loop;               // name given to Watchdog::watch()
+    LoopCallback callback;          // running when the stall was seen
+    int client_id;
+    std::chrono::nanoseconds duration;  // busy time so far, or in total once ended
+    bool ended;                     // false when first detected, true once the loop moved on
+};
+
+// Side thread that reports loops stuck in one wake-up for longer than stall_threshold, e.g. a
+// handler blocking in onClientData. Each stall is reported when detected and again when the loop
+// moves on; without a handler both are logged. Watch the LoopMonitor of each loop:
+//   Watchdog watchdog;
+//   watchdog.watch("feed", server.get_loop_monitor());
+//   watchdog.start();
+class Watchdog
+{
+public:
+    using StallHandler = std::function<void(const StallReport&)>;
+
+    explicit Watchdog(const WatchdogConfig& config = WatchdogConfig(), StallHandler on_stall = {})
+        : config_(config)
+        , on_stall_(std::move(on_stall))
+    {
+    }
+
+    ~Watchdog() { stop(); }
+
+    Watchdog(const Watchdog&) = delete;
+    Watchdog& operator=(const Watchdog&) = delete;
+
+    // The monitor must outlive the watchdog's use of it (stop() or unwatch())
+    void watch(std::string name, const LoopMonitor& monitor)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loops_.push_back(Watched{std::move(name), &monitor});
+    }
+
+    void unwatch(const LoopMonitor& monitor)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::erase_if(loops_, [&](const Watched& loop) { return loop.monitor == &monitor; });
+    }
+
+    bool start()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (thread_.joinable())
+        {
+            return false;
+        }
+        stopping_ = false;
+        thread_ = std::thread([this]() { run(); });
+        return true;
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+    }
+
+    uint64_t get_stall_count() const noexcept
+    {
+        return stall_count_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Watched
+    {
+        std::string name;
+        const LoopMonitor* monitor;
+        uint64_t stalled_iteration = 0;     // wake-up already reported, 0 = none
+        LoopMonitor::Snapshot last{};
+    };
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const uint64_t threshold_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(config_.stall_threshold).count());
+        while (!wake_.wait_for(lock, config_.check_interval, [this]() { return stopping_; }))
+        {
+            for (Watched& loop : loops_)
+            {
+                LoopMonitor::Snapshot now = loop.monitor->snapshot();
+                bool same_wakeup = now.busy && now.iteration == loop.stalled_iteration;
+                if (loop.stalled_iteration != 0 && !same_wakeup)
+                {
+                    report(loop, loop.last, true);
+                    loop.stalled_iteration = 0;
+                }
+                if (now.busy && now.busy_ns >= threshold_ns && loop.stalled_iteration == 0)
+                {
+                    loop.stalled_iteration = now.iteration;
+                    stall_count_.fetch_add(1, std::memory_order_relaxed);
+                    report(loop, now, false);
+                }
+                if (loop.stalled_iteration != 0)
+                {
+                    loop.last = now;
+                }
+            }
+        }
+    }
+
+    void report(const Watched& loop, const LoopMonitor::Snapshot& snapshot, bool ended)
+    {
+        StallReport stall{loop.name, snapshot.callback, snapshot.client_id,
+                          std::chrono::nanoseconds(snapshot.busy_ns), ended};
+        if (on_stall_)
+        {
+            on_stall_(stall);
+            return;
+        }
+        [[maybe_unused]] auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(stall.duration).count();
+        if (ended)
+        {
+            LOG_WARN("{} loop recovered after a stall of at least {} ms in {} (client {})", stall.loop, ms,
+                     to_string(stall.callback), stall.client_id);
+        }
+        else
+        {
+            LOG_WARN("{} loop stalled for {} ms in {} (client {})", stall.loop, ms, to_string(stall.callback),
+                     stall.client_id);
+        }
+    }
+
+    WatchdogConfig config_;
+    StallHandler on_stall_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    std::vector<Watched> loops_;
+    std::thread thread_;
+    std::atomic<uint64_t> stall_count_{0};
+};
+
+} // namespace slick::socket
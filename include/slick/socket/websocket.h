@@ -0,0 +1,737 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define SLICK_SOCKET_WEBSOCKET_X86 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SLICK_SOCKET_WEBSOCKET_NEON 1
+#endif
+
+namespace slick::socket
+{
+
+// RFC 6455 building blocks shared by WebSocketServerBase and WebSocketClientBase
+
+enum class WebSocketOpcode : uint8_t
+{
+    Continuation = 0x0,
+    Text = 0x1,
+    Binary = 0x2,
+    Close = 0x8,
+    Ping = 0x9,
+    Pong = 0xA,
+};
+
+namespace websocket_close
+{
+constexpr uint16_t normal = 1000;
+constexpr uint16_t going_away = 1001;
+constexpr uint16_t protocol_error = 1002;
+constexpr uint16_t no_status = 1005;
+constexpr uint16_t abnormal = 1006;             // never sent: the connection dropped without a close frame
+constexpr uint16_t message_too_big = 1009;
+} // namespace websocket_close
+
+// Largest frame header: 2 bytes, 8-byte extended length, 4-byte mask key
+constexpr size_t websocket_max_header_size = 14;
+
+struct WebSocketConfig
+{
+    std::string path = "/";                         // request path sent by the client
+    size_t max_message_size = 16 * 1024 * 1024;     // larger messages close the connection with 1009
+    size_t max_handshake_size = 8192;               // upgrade request/response header limit
+};
+
+namespace websocket_detail
+{
+
+inline uint32_t rotl(uint32_t value, int bits) noexcept
+{
+    return (value << bits) | (value >> (32 - bits));
+}
+
+// SHA-1, only used for Sec-WebSocket-Accept
+inline std::array<uint8_t, 20> sha1(std::string_view input)
+{
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+    std::string message(input);
+    uint64_t bit_length = static_cast<uint64_t>(input.size()) * 8;
+    message.push_back(static_cast<char>(0x80));
+    while (message.size() % 64 != 56)
+    {
+        message.push_back('\0');
+    }
+    for (int i = 7; i >= 0; --i)
+    {
+        message.push_back(static_cast<char>((bit_length >> (i * 8)) & 0xFF));
+    }
+
+    for (size_t chunk = 0; chunk < message.size(); chunk += 64)
+    {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i)
+        {
+            const auto* p = reinterpret_cast<const uint8_t*>(message.data() + chunk + i * 4);
+            w[i] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+        }
+        for (int i = 16; i < 80; ++i)
+        {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i)
+        {
+            uint32_t f, k;
+            if (i < 20)
+            {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            }
+            else if (i < 40)
+            {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            }
+            else if (i < 60)
+            {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            }
+            else
+            {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotl(b, 30);
+            b = a;
+            a = temp;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    std::array<uint8_t, 20> digest;
+    for (int i = 0; i < 5; ++i)
+    {
+        digest[i * 4] = static_cast<uint8_t>(h[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(h[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(h[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(h[i]);
+    }
+    return digest;
+}
+
+inline std::string base64_encode(const uint8_t* data, size_t length)
+{
+    static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((length + 2) / 3 * 4);
+    for (size_t i = 0; i < length; i += 3)
+    {
+        uint32_t chunk = uint32_t(data[i]) << 16;
+        if (i + 1 < length)
+        {
+            chunk |= uint32_t(data[i + 1]) << 8;
+        }
+        if (i + 2 < length)
+        {
+            chunk |= data[i + 2];
+        }
+        out.push_back(alphabet[(chunk >> 18) & 0x3F]);
+        out.push_back(alphabet[(chunk >> 12) & 0x3F]);
+        out.push_back(i + 1 < length ? alphabet[(chunk >> 6) & 0x3F] : '=');
+        out.push_back(i + 2 < length ? alphabet[chunk & 0x3F] : '=');
+    }
+    return out;
+}
+
+inline bool iequals(std::string_view a, std::string_view b) noexcept
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        char x = a[i] >= 'A' && a[i] <= 'Z' ? static_cast<char>(a[i] + 32) : a[i];
+        char y = b[i] >= 'A' && b[i] <= 'Z' ? static_cast<char>(b[i] + 32) : b[i];
+        if (x != y)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline std::string_view trim(std::string_view text) noexcept
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+    {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+    {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// Comma-separated header value containing token, case-insensitively ("keep-alive, Upgrade")
+inline bool header_has_token(std::string_view value, std::string_view token) noexcept
+{
+    while (!value.empty())
+    {
+        size_t comma = value.find(',');
+        if (iequals(trim(value.substr(0, comma)), token))
+        {
+            return true;
+        }
+        if (comma == std::string_view::npos)
+        {
+            break;
+        }
+        value.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+// Value of an HTTP header in head (start line and headers, CRLF separated), case-insensitive name
+inline bool find_header(std::string_view head, std::string_view name, std::string_view& value) noexcept
+{
+    size_t line_start = head.find("\r\n");
+    while (line_start != std::string_view::npos)
+    {
+        line_start += 2;
+        size_t line_end = head.find("\r\n", line_start);
+        std::string_view line = head.substr(line_start, line_end == std::string_view::npos ? std::string_view::npos : line_end - line_start);
+        size_t colon = line.find(':');
+        if (colon != std::string_view::npos && iequals(trim(line.substr(0, colon)), name))
+        {
+            value = trim(line.substr(colon + 1));
+            return true;
+        }
+        line_start = line_end;
+    }
+    return false;
+}
+
+inline void unmask_scalar(uint8_t* dst, const uint8_t* src, size_t length, const uint8_t key[4], size_t phase) noexcept
+{
+    // 8 bytes at a time with the key rotated to the current phase
+    uint8_t rotated[8];
+    for (size_t i = 0; i < 8; ++i)
+    {
+        rotated[i] = key[(phase + i) & 3];
+    }
+    uint64_t key64;
+    std::memcpy(&key64, rotated, 8);
+
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, src + i, 8);
+        word ^= key64;
+        std::memcpy(dst + i, &word, 8);
+    }
+    for (; i < length; ++i)
+    {
+        dst[i] = src[i] ^ rotated[i & 7];
+    }
+}
+
+#if defined(SLICK_SOCKET_WEBSOCKET_X86)
+
+inline void unmask_sse2(uint8_t* dst, const uint8_t* src, size_t length, const uint8_t key[4], size_t phase) noexcept
+{
+    uint8_t rotated[16];
+    for (size_t i = 0; i < 16; ++i)
+    {
+        rotated[i] = key[(phase + i) & 3];
+    }
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rotated));
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(block, mask));
+    }
+    unmask_scalar(dst + i, src + i, length - i, key, phase + i);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+inline void unmask_avx2(uint8_t* dst, const uint8_t* src, size_t length, const uint8_t key[4], size_t phase) noexcept
+{
+    uint8_t rotated[32];
+    for (size_t i = 0; i < 32; ++i)
+    {
+        rotated[i] = key[(phase + i) & 3];
+    }
+    const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rotated));
+
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(first, mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32), _mm256_xor_si256(second, mask));
+    }
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(block, mask));
+    }
+    unmask_sse2(dst + i, src + i, length - i, key, phase + i);
+}
+
+inline bool cpu_has_avx2() noexcept
+{
+#if defined(__AVX2__)
+    return true;
+#elif defined(__GNUC__) || defined(__clang__)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;   // MSVC without /arch:AVX2: SSE2 only
+#endif
+}
+
+#elif defined(SLICK_SOCKET_WEBSOCKET_NEON)
+
+inline void unmask_neon(uint8_t* dst, const uint8_t* src, size_t length, const uint8_t key[4], size_t phase) noexcept
+{
+    uint8_t rotated[16];
+    for (size_t i = 0; i < 16; ++i)
+    {
+        rotated[i] = key[(phase + i) & 3];
+    }
+    const uint8x16_t mask = vld1q_u8(rotated);
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        vst1q_u8(dst + i, veorq_u8(vld1q_u8(src + i), mask));
+    }
+    unmask_scalar(dst + i, src + i, length - i, key, phase + i);
+}
+
+#endif
+
+} // namespace websocket_detail
+
+// Sec-WebSocket-Accept value for a client's Sec-WebSocket-Key
+inline std::string websocket_accept_key(std::string_view client_key)
+{
+    std::string input(client_key);
+    input += "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    auto digest = websocket_detail::sha1(input);
+    return websocket_detail::base64_encode(digest.data(), digest.size());
+}
+
+// XOR length bytes of src with the 4-byte masking key into dst (dst may equal src).
+// phase is the position of src[0] within the masked payload, for payloads split across reads.
+// Uses AVX2 where the CPU has it (checked once), SSE2 or NEON otherwise.
+inline void websocket_unmask(uint8_t* dst, const uint8_t* src, size_t length, const uint8_t key[4], size_t phase = 0) noexcept
+{
+#if defined(SLICK_SOCKET_WEBSOCKET_X86)
+    if (length >= 32 && websocket_detail::cpu_has_avx2())
+    {
+        websocket_detail::unmask_avx2(dst, src, length, key, phase);
+        return;
+    }
+    websocket_detail::unmask_sse2(dst, src, length, key, phase);
+#elif defined(SLICK_SOCKET_WEBSOCKET_NEON)
+    websocket_detail::unmask_neon(dst, src, length, key, phase);
+#else
+    websocket_detail::unmask_scalar(dst, src, length, key, phase);
+#endif
+}
+
+// Writes a frame header into out (at least websocket_max_header_size bytes) and returns its size.
+// mask_key is null for server frames and the 4-byte key for client frames.
+inline size_t encode_websocket_header(uint8_t* out, WebSocketOpcode opcode, size_t payload_length,
+                                      bool fin = true, const uint8_t* mask_key = nullptr) noexcept
+{
+    size_t size = 0;
+    out[size++] = static_cast<uint8_t>((fin ? 0x80 : 0x00) | static_cast<uint8_t>(opcode));
+    const uint8_t mask_bit = mask_key ? 0x80 : 0x00;
+    if (payload_length < 126)
+    {
+        out[size++] = static_cast<uint8_t>(mask_bit | payload_length);
+    }
+    else if (payload_length <= 0xFFFF)
+    {
+        out[size++] = static_cast<uint8_t>(mask_bit | 126);
+        out[size++] = static_cast<uint8_t>(payload_length >> 8);
+        out[size++] = static_cast<uint8_t>(payload_length);
+    }
+    else
+    {
+        out[size++] = static_cast<uint8_t>(mask_bit | 127);
+        for (int i = 7; i >= 0; --i)
+        {
+            out[size++] = static_cast<uint8_t>(static_cast<uint64_t>(payload_length) >> (i * 8));
+        }
+    }
+    if (mask_key)
+    {
+        std::memcpy(out + size, mask_key, 4);
+        size += 4;
+    }
+    return size;
+}
+
+// Incremental RFC 6455 frame parser for one connection. feed() takes bytes as they arrive and
+// calls on_frame(WebSocketOpcode, const uint8_t* payload, size_t length) for each complete
+// message (fragments reassembled, opcode Text or Binary) and each control frame (Close, Ping,
+// Pong). If on_frame returns bool, false stops feed() right after that frame. An unmasked frame that arrives whole is delivered straight from the caller's buffer;
+// masked payloads are unmasked while being copied into the parser's reusable buffer.
+class WebSocketParser
+{
+public:
+    // expect_masked: true on the server (client frames are masked), false on the client
+    explicit WebSocketParser(bool expect_masked = true, size_t max_message_size = 16 * 1024 * 1024)
+        : expect_masked_(expect_masked)
+        , max_message_size_(max_message_size)
+    {
+    }
+
+    // Returns false on a protocol violation; close_code() tells which
+    template<typename FrameHandlerT>
+    bool feed(const uint8_t* data, size_t length, FrameHandlerT&& on_frame)
+    {
+        while (length > 0 || (state_ == State::Payload && payload_left_ == 0))
+        {
+            if (state_ == State::Header)
+            {
+                // Whole unfragmented, unmasked frame in the caller's buffer: no copy
+                if (header_size_ == 0 && !expect_masked_)
+                {
+                    size_t consumed = try_deliver_direct(data, length, on_frame);
+                    if (consumed == SIZE_MAX)
+                    {
+                        return false;
+                    }
+                    if (consumed == stop)
+                    {
+                        return true;
+                    }
+                    if (consumed > 0)
+                    {
+                        data += consumed;
+                        length -= consumed;
+                        continue;
+                    }
+                }
+
+                header_[header_size_++] = *data++;
+                --length;
+                int status = parse_header();
+                if (status < 0)
+                {
+                    return false;
+                }
+                if (status > 0)
+                {
+                    if (!begin_payload())
+                    {
+                        return false;
+                    }
+                }
+                continue;
+            }
+
+            // Payload
+            size_t chunk = payload_left_ < length ? static_cast<size_t>(payload_left_) : length;
+            if (chunk > 0)
+            {
+                std::vector<uint8_t>& target = is_control() ? control_ : message_;
+                size_t at = target.size();
+                target.resize(at + chunk);
+                if (masked_)
+                {
+                    websocket_unmask(target.data() + at, data, chunk, mask_key_, mask_phase_);
+                    mask_phase_ += chunk;
+                }
+                else
+                {
+                    std::memcpy(target.data() + at, data, chunk);
+                }
+                data += chunk;
+                length -= chunk;
+                payload_left_ -= chunk;
+            }
+
+            if (payload_left_ == 0)
+            {
+                state_ = State::Header;
+                header_size_ = 0;
+                if (!finish_frame(on_frame))
+                {
+                    return true;
+                }
+            }
+        }
+        return true;
+    }
+
+    uint16_t close_code() const noexcept { return close_code_; }
+
+    void reset()
+    {
+        state_ = State::Header;
+        header_size_ = 0;
+        in_message_ = false;
+        message_.clear();
+        control_.clear();
+        close_code_ = websocket_close::normal;
+    }
+
+private:
+    enum class State : uint8_t
+    {
+        Header,
+        Payload,
+    };
+
+    bool is_control() const noexcept
+    {
+        return (static_cast<uint8_t>(opcode_) & 0x08) != 0;
+    }
+
+    bool fail(uint16_t code) noexcept
+    {
+        close_code_ = code;
+        return false;
+    }
+
+    // Decodes whatever header bytes are in header_. 1 when complete, 0 when more are needed, -1 on error.
+    int parse_header()
+    {
+        if (header_size_ < 2)
+        {
+            return 0;
+        }
+        bool masked = (header_[1] & 0x80) != 0;
+        size_t length_code = header_[1] & 0x7F;
+        size_t needed = 2 + (length_code == 126 ? 2 : length_code == 127 ? 8 : 0) + (masked ? 4 : 0);
+        if (header_size_ < needed)
+        {
+            return 0;
+        }
+
+        fin_ = (header_[0] & 0x80) != 0;
+        opcode_ = static_cast<WebSocketOpcode>(header_[0] & 0x0F);
+        masked_ = masked;
+        size_t at = 2;
+        if (length_code == 126)
+        {
+            payload_left_ = (uint64_t(header_[2]) << 8) | header_[3];
+            at = 4;
+        }
+        else if (length_code == 127)
+        {
+            // RFC 6455 5.2: the most significant bit of a 64-bit length must be 0
+            if (header_[2] & 0x80)
+            {
+                fail(websocket_close::protocol_error);
+                return -1;
+            }
+            payload_left_ = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                payload_left_ = (payload_left_ << 8) | header_[2 + i];
+            }
+            at = 10;
+        }
+        else
+        {
+            payload_left_ = length_code;
+        }
+        if (masked_)
+        {
+            std::memcpy(mask_key_, header_ + at, 4);
+        }
+        mask_phase_ = 0;
+        return (header_[0] & 0x70) != 0 || masked_ != expect_masked_ ? (fail(websocket_close::protocol_error), -1) : 1;
+    }
+
+    bool begin_payload()
+    {
+        switch (opcode_)
+        {
+        case WebSocketOpcode::Continuation:
+            if (!in_message_)
+            {
+                return fail(websocket_close::protocol_error);
+            }
+            break;
+        case WebSocketOpcode::Text:
+        case WebSocketOpcode::Binary:
+            if (in_message_)
+            {
+                return fail(websocket_close::protocol_error);
+            }
+            in_message_ = true;
+            message_opcode_ = opcode_;
+            message_.clear();
+            break;
+        case WebSocketOpcode::Close:
+        case WebSocketOpcode::Ping:
+        case WebSocketOpcode::Pong:
+            if (!fin_ || payload_left_ > 125)
+            {
+                return fail(websocket_close::protocol_error);
+            }
+            control_.clear();
+            break;
+        default:
+            return fail(websocket_close::protocol_error);
+        }
+
+        if (!is_control() && payload_left_ > max_message_size_ - message_.size())
+        {
+            return fail(websocket_close::message_too_big);
+        }
+        state_ = State::Payload;
+        return true;
+    }
+
+    // False when the handler asked to stop
+    template<typename FrameHandlerT>
+    static bool deliver(FrameHandlerT& on_frame, WebSocketOpcode opcode, const uint8_t* payload, size_t length)
+    {
+        if constexpr (std::is_same_v<std::invoke_result_t<FrameHandlerT&, WebSocketOpcode, const uint8_t*, size_t>, bool>)
+        {
+            return on_frame(opcode, payload, length);
+        }
+        else
+        {
+            on_frame(opcode, payload, length);
+            return true;
+        }
+    }
+
+    template<typename FrameHandlerT>
+    bool finish_frame(FrameHandlerT& on_frame)
+    {
+        if (is_control())
+        {
+            return deliver(on_frame, opcode_, control_.data(), control_.size());
+        }
+        if (fin_)
+        {
+            in_message_ = false;
+            bool more = deliver(on_frame, message_opcode_, message_.data(), message_.size());
+            message_.clear();
+            return more;
+        }
+        return true;
+    }
+
+    static constexpr size_t stop = SIZE_MAX - 1;
+
+    // Frame fully inside [data, data + length): deliver it in place. Returns the bytes consumed,
+    // 0 to fall back to the byte-wise path, SIZE_MAX on a protocol error, stop when the handler
+    // asked to stop.
+    template<typename FrameHandlerT>
+    size_t try_deliver_direct(const uint8_t* data, size_t length, FrameHandlerT& on_frame)
+    {
+        if (length < 2 || (data[1] & 0x80) != 0)
+        {
+            return 0;
+        }
+        size_t length_code = data[1] & 0x7F;
+        size_t header_size = length_code == 126 ? 4 : length_code == 127 ? 10 : 2;
+        if (length < header_size)
+        {
+            return 0;
+        }
+        uint64_t payload_length = length_code;
+        if (length_code == 126)
+        {
+            payload_length = (uint64_t(data[2]) << 8) | data[3];
+        }
+        else if (length_code == 127)
+        {
+            payload_length = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                payload_length = (payload_length << 8) | data[2 + i];
+            }
+        }
+        if (length - header_size < payload_length)
+        {
+            return 0;
+        }
+
+        auto opcode = static_cast<WebSocketOpcode>(data[0] & 0x0F);
+        bool fin = (data[0] & 0x80) != 0;
+        bool data_frame = opcode == WebSocketOpcode::Text || opcode == WebSocketOpcode::Binary;
+        if (!fin || !data_frame || in_message_)
+        {
+            return 0;   // fragments and control frames take the general path
+        }
+        if ((data[0] & 0x70) != 0)
+        {
+            fail(websocket_close::protocol_error);
+            return SIZE_MAX;
+        }
+        if (payload_length > max_message_size_)
+        {
+            fail(websocket_close::message_too_big);
+            return SIZE_MAX;
+        }
+
+        if (!deliver(on_frame, opcode, data + header_size, static_cast<size_t>(payload_length)))
+        {
+            return stop;
+        }
+        return header_size + static_cast<size_t>(payload_length);
+    }
+
+    bool expect_masked_;
+    size_t max_message_size_;
+    State state_ = State::Header;
+    uint8_t header_[websocket_max_header_size] = {};
+    size_t header_size_ = 0;
+    bool fin_ = false;
+    bool masked_ = false;
+    WebSocketOpcode opcode_ = WebSocketOpcode::Continuation;
+    uint8_t mask_key_[4] = {};
+    size_t mask_phase_ = 0;
+    uint64_t payload_left_ = 0;
+    bool in_message_ = false;
+    WebSocketOpcode message_opcode_ = WebSocketOpcode::Binary;
+    std::vector<uint8_t> message_;      // reassembled data message, capacity kept across messages
+    std::vector<uint8_t> control_;      // payload of the current control frame
+    uint16_t close_code_ = websocket_close::normal;
+};
+
+} // namespace slick::socket
@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <slick/socket/tcp_client.h>
+#include <slick/socket/websocket.h>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace slick::socket
+{
+
+// WebSocket (RFC 6455) client on top of TCPClientBase. The upgrade request is the connection's
+// first payload (so it rides the SYN with fast_open). Derived classes implement
+//   void onMessage(const uint8_t* data, size_t length, bool binary);
+// and optionally
+//   void onWebSocketOpen();
+//   void onWebSocketClose(uint16_t code);     // 1006 when the connection dropped without a close frame
+// Callbacks run on the client thread. Sends are allowed from any thread once is_open().
+template<typename DerivedT, typename TraitsT = DefaultSocketTraits>
+class WebSocketClientBase : public TCPClientBase<WebSocketClientBase<DerivedT, TraitsT>, TraitsT>
+{
+    using Base = TCPClientBase<WebSocketClientBase<DerivedT, TraitsT>, TraitsT>;
+    friend Base;
+
+public:
+    explicit WebSocketClientBase(std::string name, const TCPClientConfig& config = TCPClientConfig(),
+                                 const WebSocketConfig& websocket_config = WebSocketConfig())
+        : Base(std::move(name), config)
+        , websocket_config_(websocket_config)
+        , parser_(false, websocket_config.max_message_size)
+    {
+    }
+
+    // Connects and sends the upgrade request; onWebSocketOpen() follows once the server accepts
+    bool connect()
+    {
+        uint8_t nonce[16];
+        std::random_device random;
+        for (size_t i = 0; i < sizeof(nonce); i += 4)
+        {
+            uint32_t value = random();
+            std::memcpy(nonce + i, &value, 4);
+        }
+        std::string key = websocket_detail::base64_encode(nonce, sizeof(nonce));
+        expected_accept_ = websocket_accept_key(key);
+        response_.clear();
+        parser_.reset();
+        close_code_.store(websocket_close::abnormal, std::memory_order_relaxed);
+
+        const std::string& address = this->config_.server_address;
+        std::string host = address.find(':') != std::string::npos ? "[" + address + "]" : address;
+        std::string request =
+            "GET " + websocket_config_.path + " HTTP/1.1\r\n"
+            "Host: " + host + ":" + std::to_string(this->config_.server_port) + "\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            "Sec-WebSocket-Key: " + key + "\r\n"
+            "Sec-WebSocket-Version: 13\r\n\r\n";
+        return Base::connect(std::vector<uint8_t>(request.begin(), request.end()));
+    }
+
+    bool is_open() const noexcept
+    {
+        return open_.load(std::memory_order_acquire);
+    }
+
+    bool send_text(std::string_view text)
+    {
+        return send_frame(WebSocketOpcode::Text, reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    }
+
+    bool send_binary(const uint8_t* data, size_t length)
+    {
+        return send_frame(WebSocketOpcode::Binary, data, length);
+    }
+
+    bool ping(std::string_view payload = {})
+    {
+        return payload.size() <= 125 &&
+               send_frame(WebSocketOpcode::Ping, reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+    }
+
+    // Send a close frame and disconnect; onWebSocketClose() is called with code
+    void close(uint16_t code = websocket_close::normal)
+    {
+        if (is_open())
+        {
+            close_code_.store(code, std::memory_order_relaxed);
+            uint8_t payload[2] = {static_cast<uint8_t>(code >> 8), static_cast<uint8_t>(code)};
+            send_frame(WebSocketOpcode::Close, payload, sizeof(payload));
+        }
+        Base::disconnect();
+    }
+
+protected:
+    DerivedT& derived() { return static_cast<DerivedT&>(*this); }
+
+private:
+    // Client frames must be masked, which costs one copy. The frame is built in a per-thread
+    // buffer so concurrent senders need no lock and the buffer is reused.
+    bool send_frame(WebSocketOpcode opcode, const uint8_t* data, size_t length)
+    {
+        if (!is_open())
+        {
+            return false;
+        }
+
+        thread_local std::vector<uint8_t> frame;
+        thread_local uint64_t mask_state = std::random_device()() | (uint64_t(std::random_device()()) << 32) | 1;
+        mask_state ^= mask_state << 13;
+        mask_state ^= mask_state >> 7;
+        mask_state ^= mask_state << 17;
+        uint8_t key[4];
+        std::memcpy(key, &mask_state, 4);
+
+        frame.resize(websocket_max_header_size + length);
+        size_t header_size = encode_websocket_header(frame.data(), opcode, length, true, key);
+        websocket_unmask(frame.data() + header_size, data, length, key);
+        frame.resize(header_size + length);
+        return Base::send_data(frame);
+    }
+
+    void onConnected()
+    {
+    }
+
+    void onData(const uint8_t* data, size_t length)
+    {
+        if (!is_open())
+        {
+            size_t consumed = 0;
+            if (!handshake(data, length, consumed))
+            {
+                return;
+            }
+            data += consumed;
+            length -= consumed;
+        }
+
+        bool ok = parser_.feed(data, length, [this](WebSocketOpcode opcode, const uint8_t* payload, size_t size) {
+            on_frame(opcode, payload, size);
+            return this->is_connected();
+        });
+        if (!ok)
+        {
+            LOG_WARN("{}: WebSocket protocol error, closing with {}", this->name_, parser_.close_code());
+            close(parser_.close_code());
+        }
+    }
+
+    void onDisconnected()
+    {
+        if (open_.exchange(false, std::memory_order_acq_rel))
+        {
+            if constexpr (requires { derived().onWebSocketClose(websocket_close::normal); })
+            {
+                derived().onWebSocketClose(close_code_.load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    void on_frame(WebSocketOpcode opcode, const uint8_t* payload, size_t size)
+    {
+        switch (opcode)
+        {
+        case WebSocketOpcode::Text:
+        case WebSocketOpcode::Binary:
+            derived().onMessage(payload, size, opcode == WebSocketOpcode::Binary);
+            break;
+        case WebSocketOpcode::Ping:
+            send_frame(WebSocketOpcode::Pong, payload, size);
+            break;
+        case WebSocketOpcode::Close:
+        {
+            uint16_t code = size >= 2 ? static_cast<uint16_t>((payload[0] << 8) | payload[1]) : websocket_close::no_status;
+            close_code_.store(code, std::memory_order_relaxed);
+            send_frame(WebSocketOpcode::Close, payload, size >= 2 ? 2 : 0);
+            Base::disconnect();
+            break;
+        }
+        default:
+            break;      // Pong
+        }
+    }
+
+    // Consumes the 101 response; true once open, consumed is the part of data it took
+    bool handshake(const uint8_t* data, size_t length, size_t& consumed)
+    {
+        size_t previous = response_.size();
+        response_.append(reinterpret_cast<const char*>(data), length);
+        size_t end = response_.find("\r\n\r\n", previous >= 3 ? previous - 3 : 0);
+        if (end == std::string::npos)
+        {
+            if (response_.size() > websocket_config_.max_handshake_size)
+            {
+                LOG_ERROR("{}: WebSocket upgrade response too large", this->name_);
+                Base::disconnect();
+            }
+            return false;
+        }
+        consumed = end + 4 - previous;
+
+        std::string_view head(response_.data(), end + 2);
+        std::string_view accept;
+        if (!head.starts_with("HTTP/1.1 101") ||
+            !websocket_detail::find_header(head, "Sec-WebSocket-Accept", accept) || accept != expected_accept_)
+        {
+            LOG_ERROR("{}: WebSocket upgrade rejected: {}", this->name_, head.substr(0, head.find('\r')));
+            Base::disconnect();
+            return false;
+        }
+
+        response_.clear();
+        open_.store(true, std::memory_order_release);
+        if constexpr (requires { derived().onWebSocketOpen(); })
+        {
+            derived().onWebSocketOpen();
+        }
+        return this->is_connected();
+    }
+
+    WebSocketConfig websocket_config_;
+    WebSocketParser parser_;                // client thread only
+    std::string response_;                  // upgrade response while the handshake is pending
+    std::string expected_accept_;
+    std::atomic<bool> open_{false};
+    std::atomic<uint16_t> close_code_{websocket_close::abnormal};
+};
+
+} // namespace slick::socket
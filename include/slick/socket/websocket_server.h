@@ -0,0 +1,276 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025-2026 Slick Quant
+// https://github.com/SlickQuant/slick-socket
+
+#pragma once
+
+#include <slick/socket/tcp_server.h>
+#include <slick/socket/websocket.h>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace slick::socket
+{
+
+// WebSocket (RFC 6455) server on top of TCPServerBase. Derived classes implement
+//   void onMessage(int client_id, const uint8_t* data, size_t length, bool binary);
+// and optionally
+//   void onWebSocketOpen(int client_id, const std::string& path);
+//   void onWebSocketClose(int client_id, uint16_t code);    // 1006 when the peer just dropped
+// All callbacks run on the server thread. Pings are answered and close frames echoed here.
+template<typename DerivedT, typename TraitsT = DefaultSocketTraits>
+class WebSocketServerBase : public TCPServerBase<WebSocketServerBase<DerivedT, TraitsT>, TraitsT>
+{
+    using Base = TCPServerBase<WebSocketServerBase<DerivedT, TraitsT>, TraitsT>;
+    friend Base;
+
+public:
+    explicit WebSocketServerBase(std::string name, const TCPServerConfig& config = TCPServerConfig(),
+                                 const WebSocketConfig& websocket_config = WebSocketConfig())
+        : Base(std::move(name), config)
+        , websocket_config_(websocket_config)
+    {
+    }
+
+protected:
+    DerivedT& derived() { return static_cast<DerivedT&>(*this); }
+
+    // Server thread only, like send_data(). Header and payload are written with one writev;
+    // the payload is not copied unless the socket cannot take it all.
+    bool send_text(int client_id, std::string_view text)
+    {
+        return send_frame(client_id, WebSocketOpcode::Text, reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    }
+
+    bool send_binary(int client_id, const uint8_t* data, size_t length)
+    {
+        return send_frame(client_id, WebSocketOpcode::Binary, data, length);
+    }
+
+    bool ping(int client_id, std::string_view payload = {})
+    {
+        return payload.size() <= 125 &&
+               send_frame(client_id, WebSocketOpcode::Ping, reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+    }
+
+    // Send a close frame and drop the connection once it is flushed; onWebSocketClose() is called with code
+    void close(int client_id, uint16_t code = websocket_close::normal)
+    {
+        auto it = sessions_.find(client_id);
+        if (it == sessions_.end() || it->second.ended)
+        {
+            return;
+        }
+        if (it->second.open)
+        {
+            uint8_t payload[2] = {static_cast<uint8_t>(code >> 8), static_cast<uint8_t>(code)};
+            send_frame(client_id, WebSocketOpcode::Close, payload, sizeof(payload));
+        }
+        end_session(client_id, code);
+    }
+
+    bool is_websocket_open(int client_id) const
+    {
+        auto it = sessions_.find(client_id);
+        return it != sessions_.end() && it->second.open && !it->second.ended;
+    }
+
+private:
+    struct Session
+    {
+        explicit Session(size_t max_message_size)
+            : parser(true, max_message_size)
+        {
+        }
+
+        std::string request;    // upgrade request while the handshake is pending
+        WebSocketParser parser;
+        bool open = false;
+        bool ended = false;
+    };
+
+    bool send_frame(int client_id, WebSocketOpcode opcode, const uint8_t* data, size_t length)
+    {
+        uint8_t header[websocket_max_header_size];
+        size_t header_size = encode_websocket_header(header, opcode, length);
+        std::array<ConstBuffer, 2> buffers = {ConstBuffer{header, header_size}, ConstBuffer{data, length}};
+        return Base::send_data(client_id, std::span<const ConstBuffer>(buffers));
+    }
+
+    void onClientConnected(int client_id, const std::string&)
+    {
+        sessions_.insert_or_assign(client_id, Session(websocket_config_.max_message_size));
+    }
+
+    void onClientDisconnected(int client_id)
+    {
+        end_session(client_id, websocket_close::abnormal, false);
+    }
+
+    void onClientData(int client_id, const uint8_t* data, size_t length)
+    {
+        auto it = sessions_.find(client_id);
+        if (it == sessions_.end())
+        {
+            return;
+        }
+
+        if (!it->second.open)
+        {
+            size_t consumed = 0;
+            if (!handshake(client_id, it->second, data, length, consumed))
+            {
+                return;
+            }
+            data += consumed;
+            length -= consumed;
+            // The open callback may have closed the connection
+            it = sessions_.find(client_id);
+            if (it == sessions_.end() || it->second.ended || length == 0)
+            {
+                return;
+            }
+        }
+
+        // The session outlives callbacks that close it until the parser returns
+        Session& session = it->second;
+        feeding_ = client_id;
+        bool ok = session.parser.feed(data, length, [&](WebSocketOpcode opcode, const uint8_t* payload, size_t size) {
+            on_frame(client_id, opcode, payload, size);
+            return !session.ended;
+        });
+        feeding_ = -1;
+        if (session.ended)
+        {
+            sessions_.erase(client_id);
+        }
+        else if (!ok)
+        {
+            close(client_id, session.parser.close_code());
+        }
+    }
+
+    void on_frame(int client_id, WebSocketOpcode opcode, const uint8_t* payload, size_t size)
+    {
+        switch (opcode)
+        {
+        case WebSocketOpcode::Text:
+        case WebSocketOpcode::Binary:
+            derived().onMessage(client_id, payload, size, opcode == WebSocketOpcode::Binary);
+            break;
+        case WebSocketOpcode::Ping:
+            send_frame(client_id, WebSocketOpcode::Pong, payload, size);
+            break;
+        case WebSocketOpcode::Close:
+        {
+            uint16_t code = size >= 2 ? static_cast<uint16_t>((payload[0] << 8) | payload[1]) : websocket_close::no_status;
+            send_frame(client_id, WebSocketOpcode::Close, payload, size >= 2 ? 2 : 0);
+            end_session(client_id, code);
+            break;
+        }
+        default:
+            break;      // Pong
+        }
+    }
+
+    // Consumes the upgrade request. Returns true once the connection is open; consumed is the
+    // number of bytes of data that belonged to the request.
+    bool handshake(int client_id, Session& session, const uint8_t* data, size_t length, size_t& consumed)
+    {
+        size_t previous = session.request.size();
+        session.request.append(reinterpret_cast<const char*>(data), length);
+        size_t end = session.request.find("\r\n\r\n", previous >= 3 ? previous - 3 : 0);
+        if (end == std::string::npos)
+        {
+            if (session.request.size() > websocket_config_.max_handshake_size)
+            {
+                reject(client_id);
+            }
+            return false;
+        }
+        consumed = end + 4 - previous;
+
+        std::string_view head(session.request.data(), end + 2);
+        std::string_view upgrade, connection, key, version;
+        bool valid = head.starts_with("GET ") &&
+                     websocket_detail::find_header(head, "Upgrade", upgrade) &&
+                     websocket_detail::iequals(upgrade, "websocket") &&
+                     websocket_detail::find_header(head, "Connection", connection) &&
+                     websocket_detail::header_has_token(connection, "Upgrade") &&
+                     websocket_detail::find_header(head, "Sec-WebSocket-Key", key) && !key.empty() &&
+                     websocket_detail::find_header(head, "Sec-WebSocket-Version", version) && version == "13";
+        if (!valid)
+        {
+            LOG_WARN("Invalid WebSocket upgrade request from client ID={}", client_id);
+            reject(client_id);
+            return false;
+        }
+
+        std::string response =
+            "HTTP/1.1 101 Switching Protocols\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            "Sec-WebSocket-Accept: " + websocket_accept_key(key) + "\r\n\r\n";
+        size_t path_start = 4;
+        size_t path_end = head.find(' ', path_start);
+        std::string path(head.substr(path_start, path_end == std::string_view::npos ? std::string_view::npos : path_end - path_start));
+
+        session.open = true;
+        session.request.clear();
+        session.request.shrink_to_fit();
+        if (!Base::send_data(client_id, response))
+        {
+            return false;
+        }
+
+        if constexpr (requires { derived().onWebSocketOpen(client_id, path); })
+        {
+            derived().onWebSocketOpen(client_id, path);
+        }
+        return true;
+    }
+
+    void reject(int client_id)
+    {
+        Base::send_data(client_id, std::string("HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"));
+        end_session(client_id, websocket_close::protocol_error);
+    }
+
+    // Forget the session and, unless the socket is already gone, drop the connection once the
+    // close frame or rejection queued ahead of it has been flushed
+    void end_session(int client_id, uint16_t code, bool disconnect = true)
+    {
+        auto it = sessions_.find(client_id);
+        if (it == sessions_.end() || it->second.ended)
+        {
+            return;
+        }
+        bool was_open = it->second.open;
+        it->second.ended = true;
+        if (feeding_ != client_id)
+        {
+            sessions_.erase(it);
+        }
+        if (disconnect)
+        {
+            Base::disconnect_client_after_flush(client_id);
+        }
+        if constexpr (requires { derived().onWebSocketClose(client_id, code); })
+        {
+            if (was_open)
+            {
+                derived().onWebSocketClose(client_id, code);
+            }
+        }
+    }
+
+    WebSocketConfig websocket_config_;
+    std::unordered_map<int, Session> sessions_;     // server thread only
+    int feeding_ = -1;                              // client whose data the parser is consuming
+};
+
+} // namespace slick::socket
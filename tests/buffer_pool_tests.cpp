@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <slick/socket/buffer_pool.h>
+#include <thread>
+#include <vector>
+
+using slick::socket::BufferPool;
+using slick::socket::PooledBuffer;
+
+TEST(BufferPoolTest, AcquireRoundsUpToSlabClass) {
+    auto& pool = BufferPool::instance();
+
+    PooledBuffer small = pool.acquire(100);
+    ASSERT_FALSE(small.empty());
+    EXPECT_EQ(small.size(), 100u);
+    EXPECT_EQ(small.capacity(), BufferPool::min_class_size);
+
+    PooledBuffer medium = pool.acquire(4097);
+    ASSERT_FALSE(medium.empty());
+    EXPECT_EQ(medium.capacity(), 8192u);
+
+    // Buffers are usable across their whole capacity
+    std::fill(medium.data(), medium.data() + medium.capacity(), uint8_t{0xAB});
+    EXPECT_EQ(medium.data()[medium.capacity() - 1], 0xAB);
+    EXPECT_GT(pool.arena_size(), 0u);
+    EXPECT_EQ(pool.arena_size() % BufferPool::huge_page_size, 0u);
+}
+
+TEST(BufferPoolTest, ReleasedBufferIsReusedByTheSameThread) {
+    auto& pool = BufferPool::instance();
+
+    uint8_t* first = nullptr;
+    {
+        PooledBuffer buffer = pool.acquire(4096);
+        first = buffer.data();
+    }
+    PooledBuffer again = pool.acquire(4096);
+    EXPECT_EQ(again.data(), first);
+}
+
+TEST(BufferPoolTest, OversizedRequestsFallBackToHeap) {
+    auto& pool = BufferPool::instance();
+    uint64_t fallbacks = pool.heap_fallbacks();
+
+    PooledBuffer big = pool.acquire(BufferPool::max_class_size + 1);
+    ASSERT_FALSE(big.empty());
+    EXPECT_EQ(big.capacity(), BufferPool::max_class_size + 1);
+    EXPECT_EQ(pool.heap_fallbacks(), fallbacks + 1);
+}
+
+TEST(BufferPoolTest, MoveTransfersOwnership) {
+    PooledBuffer a = BufferPool::instance().acquire(2048);
+    uint8_t* data = a.data();
+
+    PooledBuffer b = std::move(a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(b.data(), data);
+
+    b.reset();
+    EXPECT_TRUE(b.empty());
+}
+
+TEST(BufferPoolTest, BuffersCanBeReleasedOnAnotherThread) {
+    std::vector<PooledBuffer> buffers;
+    for (int i = 0; i < 100; ++i) {
+        buffers.push_back(BufferPool::instance().acquire(16 * 1024));
+    }
+
+    std::thread([&buffers]() {
+        buffers.clear();
+    }).join();
+
+    // The exiting thread returned its cache to the shared list
+    for (int i = 0; i < 100; ++i) {
+        PooledBuffer buffer = BufferPool::instance().acquire(16 * 1024);
+        EXPECT_FALSE(buffer.empty());
+    }
+}
+
+TEST(BufferPoolTest, ConfigureFailsOnceArenaIsMapped) {
+    PooledBuffer buffer = BufferPool::instance().acquire(1024);
+    EXPECT_FALSE(BufferPool::instance().configure(slick::socket::BufferPoolConfig{}));
+}
+
+TEST(BufferPoolTest, ExhaustedArenaStaysWithinItsSize) {
+    auto& pool = BufferPool::instance();
+    constexpr int node = BufferPool::max_arena_nodes - 1;   // an arena no other test draws from
+
+    std::thread([&pool]() {
+        pool.set_thread_node(node);
+        std::vector<PooledBuffer> buffers;
+        uint64_t fallbacks = pool.heap_fallbacks();
+        while (pool.heap_fallbacks() == fallbacks) {
+            buffers.push_back(pool.acquire(BufferPool::max_class_size));
+        }
+        size_t slabs = buffers.size() - 1;     // the last one came from the heap
+        ASSERT_GT(slabs, 0u);
+        buffers.push_back(pool.acquire(BufferPool::max_class_size));
+        buffers.push_back(pool.acquire(1024));
+        EXPECT_GT(pool.arena_size(node), 0u);
+        EXPECT_LE(pool.arena_used(node), pool.arena_size(node));
+
+        // Slabs start on a class-size boundary, up to a page
+        for (size_t i = 0; i < slabs; ++i) {
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(buffers[i].data()) % 4096, 0u);
+        }
+    }).join();
+}
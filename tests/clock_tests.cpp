@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <slick/socket/clock.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+using namespace slick::socket;
+
+namespace
+{
+
+int64_t steady_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+TEST(TscClockTest, TracksSteadyClock) {
+    // Past the calibration baseline, which starts on first use, so readings come from the counter
+    // when there is one
+    TscClock::invariant();
+    std::this_thread::sleep_for(std::chrono::milliseconds(15));
+
+    int64_t previous = 0;
+    for (int i = 0; i < 200; ++i)
+    {
+        int64_t before = steady_ns();
+        int64_t now = TscClock::now_ns();
+        int64_t after = steady_ns();
+        EXPECT_GE(now, previous);
+        previous = now;
+        if (after - before < 2000)  // not preempted in between
+        {
+            EXPECT_GT(now, before - 20'000) << "iteration " << i;
+            EXPECT_LT(now, after + 20'000) << "iteration " << i;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+
+    auto system = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::system_clock::now().time_since_epoch()).count();
+    EXPECT_NEAR(static_cast<double>(TscClock::realtime_ns()), static_cast<double>(system), 1e6);
+}
+
+TEST(TscClockTest, TickDifferencesConvertToNanoseconds) {
+    TscClock::invariant();     // each test may run in its own process: start the baseline here
+    std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    auto start = std::chrono::steady_clock::now();
+    uint64_t first = TscClock::ticks();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t last = TscClock::ticks_ordered();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    uint64_t converted = TscClock::to_ns(last - first);
+    EXPECT_GE(converted, 19'000'000u);
+    EXPECT_LE(converted, static_cast<uint64_t>(elapsed.count()) + 100'000u);
+
+    // Usable wherever a steady_clock time point is
+    std::chrono::steady_clock::time_point point = TscClock::now();
+    EXPECT_GE(point, start);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <slick/socket/crc32c.h>
+#include <slick/socket/packet_header.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace slick::socket;
+
+TEST(Crc32cTest, KnownVectors) {
+    EXPECT_EQ(crc32c("123456789", 9), 0xE3069283u);
+    EXPECT_EQ(crc32c("", 0), 0u);
+
+    // RFC 3720 (iSCSI) appendix B.4
+    std::vector<uint8_t> zeros(32, 0x00);
+    std::vector<uint8_t> ones(32, 0xFF);
+    std::vector<uint8_t> ascending(32);
+    for (size_t i = 0; i < ascending.size(); ++i)
+    {
+        ascending[i] = static_cast<uint8_t>(i);
+    }
+    EXPECT_EQ(crc32c(zeros.data(), zeros.size()), 0x8A9136AAu);
+    EXPECT_EQ(crc32c(ones.data(), ones.size()), 0x62A8AB43u);
+    EXPECT_EQ(crc32c(ascending.data(), ascending.size()), 0x46DD794Eu);
+}
+
+TEST(Crc32cTest, HardwareMatchesTablesAtEveryLength) {
+    std::vector<uint8_t> data(5000 + 5);   // room for the longest length at the largest offset
+    uint32_t state = 2463534242u;
+    for (auto& byte : data)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        byte = static_cast<uint8_t>(state);
+    }
+
+    for (size_t length : {1, 3, 7, 8, 15, 100, 383, 384, 385, 1500, 3071, 3072, 4999})
+    {
+        for (size_t offset : {0, 1, 5})
+        {
+            uint32_t expected = ~crc32c_detail::update_software(~0u, data.data() + offset, length);
+            EXPECT_EQ(crc32c(data.data() + offset, length), expected) << "length " << length << " offset " << offset;
+        }
+    }
+
+    // Continuing a previous result equals one pass over the concatenation
+    uint32_t whole = crc32c(data.data(), data.size());
+    EXPECT_EQ(crc32c(data.data() + 1234, data.size() - 1234, crc32c(data.data(), 1234)), whole);
+}
+
+TEST(Crc32cTest, PacketHeaderRoundTripsAndDetectsDamage) {
+    const char text[] = "sequenced payload";
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(text);
+    std::vector<uint8_t> packet(packet_header_size);
+    write_packet_header(packet.data(), 0x0102030405060708ull, packet_flag_checksum, payload, sizeof(text));
+    packet.insert(packet.end(), payload, payload + sizeof(text));
+    EXPECT_EQ(packet[0], 0x08);     // little endian
+
+    PacketHeader header;
+    ASSERT_TRUE(read_packet_header(packet.data(), packet.size(), header));
+    EXPECT_EQ(header.sequence, 0x0102030405060708ull);
+    EXPECT_EQ(header.flags, packet_flag_checksum);
+    EXPECT_TRUE(verify_packet(packet.data(), packet.size(), header));
+
+    // A single flipped bit, in the payload or the sequence, fails the check
+    packet[packet_header_size + 3] ^= 0x10;
+    EXPECT_FALSE(verify_packet(packet.data(), packet.size(), header));
+    packet[packet_header_size + 3] ^= 0x10;
+    packet[2] ^= 0x01;
+    ASSERT_TRUE(read_packet_header(packet.data(), packet.size(), header));
+    EXPECT_FALSE(verify_packet(packet.data(), packet.size(), header));
+
+    EXPECT_FALSE(read_packet_header(packet.data(), packet_header_size - 1, header));
+}
+
+TEST(Crc32cTest, PacketHeaderCarriesAScheduledSendTime) {
+    const uint8_t payload[] = {1, 2, 3};
+    uint8_t header_bytes[packet_header_max_size];
+    const uint64_t departure = 1234567890123456789ull;
+    size_t size = write_packet_header(header_bytes, 7, packet_flag_timestamp | packet_flag_checksum, payload,
+                                      sizeof(payload), departure);
+    ASSERT_EQ(size, packet_header_size + packet_timestamp_size);
+
+    std::vector<uint8_t> packet(header_bytes, header_bytes + size);
+    packet.insert(packet.end(), payload, payload + sizeof(payload));
+    PacketHeader header;
+    ASSERT_TRUE(read_packet_header(packet.data(), packet.size(), header));
+    EXPECT_EQ(header.send_time, departure);
+    EXPECT_TRUE(verify_packet(packet.data(), packet.size(), header));
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <slick/socket/endpoint.h>
+
+using namespace slick::socket;
+
+TEST(EndpointTest, ParsesIPv4) {
+    Endpoint endpoint;
+    ASSERT_TRUE(Endpoint::parse("10.1.2.3", 5000, endpoint));
+    EXPECT_TRUE(endpoint.is_v4());
+    EXPECT_EQ(endpoint.port, 5000);
+    EXPECT_EQ(endpoint.address_string(), "10.1.2.3");
+    EXPECT_EQ(endpoint.to_string(), "10.1.2.3:5000");
+    EXPECT_EQ(endpoint.socket_family(), AF_INET);
+}
+
+TEST(EndpointTest, ParsesIPv6WithBracketsAndScope) {
+    Endpoint endpoint;
+    ASSERT_TRUE(Endpoint::parse("[ff02::1:3]", 6000, endpoint));
+    EXPECT_TRUE(endpoint.is_v6());
+    EXPECT_TRUE(endpoint.is_multicast());
+    EXPECT_EQ(endpoint.to_string(), "[ff02::1:3]:6000");
+
+    ASSERT_TRUE(Endpoint::parse("fe80::1%1", 0, endpoint));
+    EXPECT_EQ(endpoint.scope_id, 1u);
+
+    EXPECT_FALSE(Endpoint::parse("localhost", 0, endpoint));
+    EXPECT_FALSE(Endpoint::parse("10.0.0.1%1", 0, endpoint));
+    EXPECT_FALSE(Endpoint::parse("fe80::1%no-such-interface", 0, endpoint));
+}
+
+TEST(EndpointTest, ClassifiesAddresses) {
+    Endpoint endpoint;
+    ASSERT_TRUE(Endpoint::parse("::", 0, endpoint));
+    EXPECT_TRUE(endpoint.is_unspecified());
+    ASSERT_TRUE(Endpoint::parse("::1", 0, endpoint));
+    EXPECT_TRUE(endpoint.is_loopback());
+    ASSERT_TRUE(Endpoint::parse("239.1.1.1", 0, endpoint));
+    EXPECT_TRUE(endpoint.is_multicast());
+    EXPECT_FALSE(Endpoint{}.is_unspecified());
+}
+
+TEST(EndpointTest, SockaddrRoundTrip) {
+    Endpoint original;
+    ASSERT_TRUE(Endpoint::parse("2001:db8::7", 443, original));
+    sockaddr_storage storage;
+    socklen_t length = original.to_sockaddr(storage);
+    EXPECT_EQ(length, sizeof(sockaddr_in6));
+
+    Endpoint copy;
+    ASSERT_TRUE(copy.from_sockaddr(reinterpret_cast<sockaddr*>(&storage)));
+    EXPECT_EQ(copy, original);
+}
+
+TEST(EndpointTest, MappedIPv4IsStoredAsIPv4) {
+    Endpoint mapped;
+    ASSERT_TRUE(Endpoint::parse("::ffff:192.168.1.9", 80, mapped));
+    sockaddr_storage storage;
+    mapped.to_sockaddr(storage);
+
+    Endpoint endpoint;
+    ASSERT_TRUE(endpoint.from_sockaddr(reinterpret_cast<sockaddr*>(&storage)));
+    EXPECT_TRUE(endpoint.is_v4());
+    EXPECT_EQ(endpoint.to_string(), "192.168.1.9:80");
+}
+
+TEST(EndpointTest, InterfaceIndex) {
+    EXPECT_EQ(interface_index(""), 0u);
+    EXPECT_EQ(interface_index("0.0.0.0"), 0u);
+    EXPECT_EQ(interface_index("3"), 3u);
+#if defined(__linux__)
+    EXPECT_GT(interface_index("lo"), 0u);
+    EXPECT_EQ(interface_index("127.0.0.1"), interface_index("lo"));
+#endif
+}
@@ -2,9 +2,19 @@
 #include "../examples/logger.h"
 #include <slick/socket/tcp_server.h>
 #include <slick/socket/tcp_client.h>
+#include <slick/socket/redundant_tcp_client.h>
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fcntl.h>
+#include <mutex>
+#if defined(_WIN32) || defined(_WIN64)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 class IntegrationTestServer : public slick::socket::TCPServerBase<IntegrationTestServer>
 {
@@ -12,10 +22,17 @@ public:
     using slick::socket::TCPServerBase<IntegrationTestServer>::TCPServerBase;
     using slick::socket::TCPServerBase<IntegrationTestServer>::get_connected_client_count;
     using slick::socket::TCPServerBase<IntegrationTestServer>::send_data;
+    using slick::socket::TCPServerBase<IntegrationTestServer>::send_file;
+    using slick::socket::TCPServerBase<IntegrationTestServer>::disconnect_client_after_flush;
+    using slick::socket::TCPServerBase<IntegrationTestServer>::get_connection_health;
+    using slick::socket::TCPServerBase<IntegrationTestServer>::get_client_endpoint;
     
     void onClientConnected(int client_id, const std::string& client_address) {
         connected_clients++;
         last_connected_client_id = client_id;
+        if (!greeting.empty()) {
+            send_data(client_id, greeting);
+        }
     }
     
     void onClientDisconnected(int client_id) {
@@ -24,6 +41,8 @@ public:
     }
     
     void onClientData(int client_id, const uint8_t* data, size_t length) {
+        data_order.push_back(client_id);
+        bytes_received += length;
         data_received++;
         last_received_data = std::string((const char*)data, length);
         last_data_client_id = client_id;
@@ -40,6 +59,20 @@ public:
     std::atomic<int> last_disconnected_client_id{-1};
     std::atomic<int> last_data_client_id{-1};
     std::string last_received_data;
+    std::vector<uint8_t> greeting;  // sent to every client on connect
+    void onConnectionHealthAlert(int client_id, const slick::socket::TCPConnectionHealth& health) {
+        health_alerts++;
+    }
+
+    void onHeartbeatTimeout(int client_id) {
+        heartbeat_timeouts++;
+    }
+
+    std::atomic<int> heartbeat_timeouts{0};
+
+    std::vector<int> data_order;    // client id of every onClientData call, server thread only
+    std::atomic<int> health_alerts{0};
+    std::atomic<size_t> bytes_received{0};
 };
 
 class IntegrationTestClient : public slick::socket::TCPClientBase<IntegrationTestClient>
@@ -59,6 +92,7 @@ public:
     
     void onData(const uint8_t* data, size_t length) {
         data_received_count++;
+        bytes_received += length;
         last_received_data = std::string((const char*)data, length);
         data_received_flag = true;
     }
@@ -68,9 +102,89 @@ public:
     std::atomic<int> data_received_count{0};
     std::atomic<bool> connection_established{false};
     std::atomic<bool> data_received_flag{false};
+    void onConnectionHealthAlert(const slick::socket::TCPConnectionHealth& health) {
+        health_alerts++;
+    }
+
+    void onHeartbeatTimeout() {
+        heartbeat_timeouts++;
+    }
+
+    std::atomic<int> heartbeat_timeouts{0};
+
+    std::atomic<size_t> bytes_received{0};
+    std::atomic<int> health_alerts{0};
     std::string last_received_data;
 };
 
+// Fixed stack buffer, small event batch, busy polling and no per-message logging
+struct EchoTraits : slick::socket::DefaultSocketTraits
+{
+    static constexpr size_t receive_buffer_size = 2048;
+    static constexpr int max_events = 8;
+    static constexpr bool enable_logging = false;
+    static constexpr bool enable_timestamps = true;
+    static constexpr slick::socket::PollingStrategy polling = slick::socket::PollingStrategy::BusyPoll;
+};
+
+class TraitsEchoServer : public slick::socket::TCPServerBase<TraitsEchoServer, EchoTraits>
+{
+public:
+    using slick::socket::TCPServerBase<TraitsEchoServer, EchoTraits>::TCPServerBase;
+
+    void onClientConnected(int client_id, const std::string& client_address) {}
+    void onClientDisconnected(int client_id) {}
+    void onClientData(int client_id, const uint8_t* data, size_t length) {
+        stamped = last_receive_time().time_since_epoch().count() != 0;
+        send_data(client_id, std::vector<uint8_t>(data, data + length));
+    }
+
+    std::atomic<bool> stamped{false};
+};
+
+// Keeps every byte received, for checking stream contents and order
+class CollectingClient : public slick::socket::TCPClientBase<CollectingClient>
+{
+public:
+    using slick::socket::TCPClientBase<CollectingClient>::TCPClientBase;
+
+    void onConnected() {}
+    void onDisconnected() {}
+    void onData(const uint8_t* data, size_t length) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.insert(received.end(), data, data + length);
+    }
+
+    size_t received_size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return received.size();
+    }
+
+    std::mutex mutex;
+    std::vector<uint8_t> received;
+};
+
+class RedundantTestClient : public slick::socket::RedundantTCPClientBase<RedundantTestClient>
+{
+public:
+    using slick::socket::RedundantTCPClientBase<RedundantTestClient>::RedundantTCPClientBase;
+
+    ~RedundantTestClient() override {
+        stop();
+    }
+
+    void onData(const uint8_t* data, size_t length) {
+        data_received_count++;
+    }
+
+    void onFailover(int from, int to) {
+        failover_at = std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    std::atomic<int> data_received_count{0};
+    std::atomic<int64_t> failover_at{0};
+};
+
 class TCPIntegrationTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -179,4 +293,577 @@ TEST_F(TCPIntegrationTest, ServerStatsWithClients) {
     EXPECT_EQ(client_->connected_count.load(), 0);
     EXPECT_EQ(client_->disconnected_count.load(), 0);
     EXPECT_EQ(client_->data_received_count.load(), 0);
-}
\ No newline at end of file
+}
+TEST_F(TCPIntegrationTest, GracefulStopFlushesQueuedData) {
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    // Much larger than the socket buffers so most of it sits in the outbound queue
+    server_->greeting.assign(16 * 1024 * 1024, 0x5A);
+    ASSERT_TRUE(server_->start());
+    ASSERT_NE(server_->get_port(), 0);
+
+    client_config_.server_port = server_->get_port();
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+    ASSERT_TRUE(waitForCondition([this]() { return server_->connected_clients.load() == 1; }));
+
+    server_->stop_gracefully(std::chrono::milliseconds(5000));
+    EXPECT_FALSE(server_->is_running());
+
+    // Everything queued before the stop reached the client, followed by an orderly close
+    EXPECT_EQ(client_->bytes_received.load(), server_->greeting.size());
+    EXPECT_TRUE(waitForCondition([this]() { return client_->disconnected_count.load() == 1; }));
+}
+
+TEST_F(TCPIntegrationTest, DisconnectAfterFlushDeliversQueuedData) {
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    server_->greeting.assign(16 * 1024 * 1024, 0x5A);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+    ASSERT_TRUE(waitForCondition([this]() { return server_->connected_clients.load() == 1; }));
+
+    std::atomic<bool> closing{false};
+    std::atomic<bool> refused{false};
+    server_->post([&]() {
+        int id = server_->last_connected_client_id.load();
+        server_->disconnect_client_after_flush(id);
+        refused = !server_->send_data(id, std::string("late"));
+        closing = true;
+    });
+
+    // The queued greeting arrives in full before the close, and the server reports no disconnect
+    ASSERT_TRUE(waitForCondition([this]() { return client_->disconnected_count.load() == 1; }, 10000));
+    EXPECT_TRUE(closing.load());
+    EXPECT_TRUE(refused.load());
+    EXPECT_EQ(client_->bytes_received.load(), server_->greeting.size());
+    EXPECT_TRUE(waitForCondition([this]() { return server_->get_connected_client_count() == 0; }));
+    EXPECT_EQ(server_->disconnected_clients.load(), 0);
+}
+
+TEST_F(TCPIntegrationTest, StopIsPromptWhenIdle) {
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    auto start = std::chrono::steady_clock::now();
+    server_->stop_gracefully(std::chrono::milliseconds(5000));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_FALSE(server_->is_running());
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 100);
+}
+
+TEST_F(TCPIntegrationTest, EchoRoundTrip) {
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+
+    ASSERT_TRUE(client_->send_data(std::string("ping")));
+    ASSERT_TRUE(waitForCondition([this]() { return client_->data_received_flag.load(); }));
+    EXPECT_EQ(client_->last_received_data, "ping");
+    EXPECT_EQ(server_->last_received_data, "ping");
+}
+
+TEST_F(TCPIntegrationTest, ConnectWithFirstPayload) {
+    server_config_.tcp_fastopen_queue = 16;
+    server_config_.defer_accept_seconds = 1;
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_config_.fast_open = true;
+
+    // The first connection fetches the Fast Open cookie, later ones may carry data in the SYN
+    for (int i = 0; i < 3; ++i) {
+        client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+        std::string request = "hello " + std::to_string(i);
+        ASSERT_TRUE(client_->connect(std::vector<uint8_t>(request.begin(), request.end())));
+        ASSERT_TRUE(waitForCondition([this]() { return client_->data_received_flag.load(); }));
+        EXPECT_EQ(client_->last_received_data, request);
+        client_->disconnect();
+    }
+}
+
+TEST_F(TCPIntegrationTest, DualStackServerAcceptsIPv4AndIPv6) {
+    server_config_.bind_address = "::";
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_config_.server_address = "::1";
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+    ASSERT_TRUE(client_->send_data(std::string("six")));
+    ASSERT_TRUE(waitForCondition([this]() { return client_->data_received_flag.load(); }));
+    EXPECT_EQ(client_->last_received_data, "six");
+
+    // IPv4 clients arrive as ::ffff:127.0.0.1 and are reported as IPv4
+    client_config_.server_address = "127.0.0.1";
+    IntegrationTestClient v4_client("IntegrationClientV4", client_config_);
+    ASSERT_TRUE(v4_client.connect());
+    ASSERT_TRUE(waitForCondition([this]() { return server_->connected_clients.load() == 2; }));
+
+    // Shared so that a task still queued when the wait ends stays valid
+    auto families = std::make_shared<std::atomic<int>>(0);
+    server_->post([server = server_.get(), families]() {
+        slick::socket::Endpoint endpoint;
+        if (server->get_client_endpoint(server->last_connected_client_id.load(), endpoint) && endpoint.is_v4()) {
+            *families |= 1;
+        }
+        if (server->get_client_endpoint(server->last_connected_client_id.load() - 1, endpoint) && endpoint.is_v6()) {
+            *families |= 2;
+        }
+    });
+    EXPECT_TRUE(waitForCondition([&]() { return families->load() == 3; }));
+    v4_client.disconnect();
+}
+
+TEST_F(TCPIntegrationTest, ClientResolvesHostName) {
+    // Dual-stack so that whichever of ::1 and 127.0.0.1 "localhost" yields first is accepted
+    server_config_.bind_address = "::";
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_config_.server_address = "localhost";
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+    ASSERT_TRUE(client_->send_data(std::string("resolved")));
+    ASSERT_TRUE(waitForCondition([this]() { return client_->data_received_flag.load(); }));
+    EXPECT_EQ(client_->last_received_data, "resolved");
+}
+
+TEST_F(TCPIntegrationTest, NumaPlacedLoopsEcho) {
+    server_config_.numa_node = 0;
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_config_.numa_interface = "127.0.0.1";    // loopback has no NIC node, client stays unplaced
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+
+    ASSERT_TRUE(client_->send_data(std::string("numa")));
+    ASSERT_TRUE(waitForCondition([this]() { return client_->data_received_flag.load(); }));
+    EXPECT_EQ(client_->last_received_data, "numa");
+}
+
+TEST_F(TCPIntegrationTest, WarmupTrafficIsHiddenFromCallbacks) {
+    server_config_.warmup.enabled = true;
+    server_config_.warmup.loopback_messages = 32;
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    const auto& report = server_->get_startup_report();
+    EXPECT_EQ(report.primed_messages, 32);
+    EXPECT_GT(report.bytes_prefaulted, 0u);
+    EXPECT_GE(report.total, report.socket_setup + report.loop_ready);
+    EXPECT_EQ(server_->connected_clients.load(), 0);
+    EXPECT_EQ(server_->data_received.load(), 0);
+
+    client_config_.server_port = server_->get_port();
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+    ASSERT_TRUE(client_->send_data(std::string("warm")));
+    ASSERT_TRUE(waitForCondition([this]() { return client_->data_received_flag.load(); }));
+    EXPECT_EQ(client_->last_received_data, "warm");
+    EXPECT_EQ(server_->connected_clients.load(), 1);
+    EXPECT_EQ(server_->bytes_received.load(), 4u);
+}
+
+TEST_F(TCPIntegrationTest, PostRunsOnLoopThreads) {
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+
+    std::atomic<std::thread::id> server_thread_id{};
+    std::atomic<std::thread::id> client_thread_id{};
+    server_->post([&]() { server_thread_id = std::this_thread::get_id(); });
+    client_->post([&]() { client_thread_id = std::this_thread::get_id(); });
+
+    // Both loops are blocked in their pollers; the wake-up must run the tasks promptly
+    ASSERT_TRUE(waitForCondition([&]() {
+        return server_thread_id.load() != std::thread::id{} && client_thread_id.load() != std::thread::id{};
+    }, 1000));
+    EXPECT_NE(server_thread_id.load(), std::this_thread::get_id());
+    EXPECT_NE(client_thread_id.load(), std::this_thread::get_id());
+    EXPECT_NE(server_thread_id.load(), client_thread_id.load());
+}
+
+TEST_F(TCPIntegrationTest, PauseAndResumeReading) {
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+    ASSERT_TRUE(waitForCondition([this]() { return server_->connected_clients.load() == 1; }));
+
+    int client_id = server_->last_connected_client_id.load();
+    server_->pause_reading(client_id);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    ASSERT_TRUE(client_->send_data(std::string("held back")));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(server_->data_received.load(), 0);
+
+    // Data queued in the kernel while paused is delivered once resumed
+    server_->resume_reading(client_id);
+    ASSERT_TRUE(waitForCondition([this]() { return server_->data_received.load() > 0; }, 1000));
+    EXPECT_EQ(server_->last_received_data, "held back");
+}
+
+TEST_F(TCPIntegrationTest, GracefulStopSeesPausedClientClose) {
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+    ASSERT_TRUE(waitForCondition([this]() { return server_->connected_clients.load() == 1; }));
+    server_->pause_reading(server_->last_connected_client_id.load());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // The client closes as soon as it reads the server's FIN; the drain must see that close
+    auto start = std::chrono::steady_clock::now();
+    server_->stop_gracefully(std::chrono::milliseconds(5000));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 1000);
+    EXPECT_EQ(server_->disconnected_clients.load(), 1);
+}
+
+TEST_F(TCPIntegrationTest, HighPriorityClientsAreServedFirst) {
+    server_config_.low_priority_read_budget = 4096;
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+    client_config_.server_port = server_->get_port();
+
+    auto bulk_client = std::make_unique<IntegrationTestClient>("BulkClient", client_config_);
+    ASSERT_TRUE(bulk_client->connect());
+    ASSERT_TRUE(waitForCondition([this]() { return server_->connected_clients.load() == 1; }));
+    int bulk_id = server_->last_connected_client_id.load();
+
+    client_ = std::make_unique<IntegrationTestClient>("OrderClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+    ASSERT_TRUE(waitForCondition([this]() { return server_->connected_clients.load() == 2; }));
+    int order_id = server_->last_connected_client_id.load();
+
+    server_->set_client_priority(bulk_id, slick::socket::ConnectionPriority::Low);
+
+    // Hold the server thread so both sockets are readable when it next polls
+    std::atomic<bool> held{false};
+    std::atomic<bool> release{false};
+    server_->post([&held, &release]() {
+        held = true;
+        while (!release.load()) std::this_thread::yield();
+    });
+    ASSERT_TRUE(waitForCondition([&]() { return held.load(); }));
+
+    std::string bulk(64 * 1024, 'b');
+    ASSERT_TRUE(bulk_client->send_data(bulk));
+    ASSERT_TRUE(client_->send_data(std::string("order")));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    release = true;
+
+    ASSERT_TRUE(waitForCondition([&]() { return server_->bytes_received.load() == bulk.size() + 5; }));
+    ASSERT_FALSE(server_->data_order.empty());
+    EXPECT_EQ(server_->data_order.front(), order_id);
+
+    bulk_client->disconnect();
+}
+
+#if defined(__linux__)
+TEST_F(TCPIntegrationTest, TcpInfoSamplingAndAlerts) {
+    server_config_.tcp_info_interval = std::chrono::milliseconds(10);
+    server_config_.health_thresholds.max_rtt_us = 1;    // any real sample crosses this
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_config_.tcp_info_interval = std::chrono::milliseconds(10);
+    client_config_.health_thresholds.max_rtt_us = 1;
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+    ASSERT_TRUE(client_->send_data(std::string("ping")));
+    ASSERT_TRUE(waitForCondition([this]() { return client_->data_received_flag.load(); }));
+
+    ASSERT_TRUE(waitForCondition([this]() { return client_->get_connection_health().samples >= 3; }, 1000));
+    EXPECT_GT(client_->get_connection_health().snd_cwnd, 0u);
+    EXPECT_TRUE(waitForCondition([this]() { return client_->health_alerts.load() == 1; }, 1000));
+
+    // Shared so that a task still queued when the wait ends stays valid
+    auto server_samples = std::make_shared<std::atomic<uint64_t>>(0);
+    ASSERT_TRUE(waitForCondition([&]() {
+        server_->post([server = server_.get(), server_samples]() {
+            slick::socket::TCPConnectionHealth health;
+            if (server->get_connection_health(server->last_connected_client_id.load(), health)) {
+                *server_samples = health.samples;
+            }
+        });
+        return server_samples->load() >= 3;
+    }, 1000));
+    // Alerts fire on crossing, not on every sample over the threshold
+    EXPECT_EQ(server_->health_alerts.load(), 1);
+}
+#endif
+
+TEST_F(TCPIntegrationTest, CustomTraitsEcho) {
+    server_config_.receive_buffer_size = 16;    // ignored, EchoTraits fixes the buffer at 2048 bytes
+    TraitsEchoServer server("TraitsEchoServer", server_config_);
+    ASSERT_TRUE(server.start());
+
+    client_config_.server_port = server.get_port();
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+
+    std::string payload(1024, 't');
+    ASSERT_TRUE(client_->send_data(payload));
+    ASSERT_TRUE(waitForCondition([this]() { return client_->bytes_received.load() == 1024; }));
+    EXPECT_TRUE(server.stamped.load());
+
+    client_->disconnect();
+    server.stop();
+}
+
+TEST_F(TCPIntegrationTest, RedundantClientFailsOverOnResetAndReplays) {
+    IntegrationTestServer primary("PrimaryServer", server_config_);
+    IntegrationTestServer backup("BackupServer", server_config_);
+    ASSERT_TRUE(primary.start());
+    ASSERT_TRUE(backup.start());
+
+    slick::socket::RedundantTCPClientConfig config;
+    config.primary = client_config_;
+    config.primary.server_port = primary.get_port();
+    config.backup = client_config_;
+    config.backup.server_port = backup.get_port();
+    config.heartbeat_timeout = std::chrono::milliseconds(0);
+
+    RedundantTestClient client("RedundantClient", config);
+    ASSERT_TRUE(client.start());
+    EXPECT_EQ(client.active_link(), RedundantTestClient::primary_link);
+    ASSERT_TRUE(waitForCondition([&]() { return client.is_link_up(RedundantTestClient::backup_link); }));
+
+    ASSERT_TRUE(client.send_data(std::string("first")));
+    ASSERT_TRUE(waitForCondition([&]() { return primary.data_received.load() == 1; }));
+    client.acknowledge(1);
+    ASSERT_TRUE(client.send_data(std::string("second")));
+    EXPECT_EQ(client.unacknowledged(), 1u);
+
+    // The reset is seen by the link thread, which switches and replays without waiting for a timer
+    auto failed_at = std::chrono::steady_clock::now().time_since_epoch().count();
+    primary.stop();
+    ASSERT_TRUE(waitForCondition([&]() { return client.failover_at.load() != 0; }));
+    EXPECT_EQ(client.active_link(), RedundantTestClient::backup_link);
+    auto failover_us = (client.failover_at.load() - failed_at) / 1000;
+    RecordProperty("failover_us", static_cast<int>(failover_us));
+    RecordProperty("switch_and_replay_ns", static_cast<int>(client.last_failover_duration().count()));
+    EXPECT_LT(failover_us, 1000000);
+    EXPECT_EQ(client.failover_count(), 1u);
+
+    ASSERT_TRUE(waitForCondition([&]() { return backup.data_received.load() >= 1; }));
+    EXPECT_EQ(backup.last_received_data, "second");
+
+    ASSERT_TRUE(client.send_data(std::string("third")));
+    ASSERT_TRUE(waitForCondition([&]() { return backup.data_received.load() >= 2; }));
+    client.stop();
+    backup.stop();
+}
+
+TEST_F(TCPIntegrationTest, RedundantClientFailsOverOnHeartbeatTimeout) {
+    IntegrationTestServer primary("PrimaryServer", server_config_);
+    IntegrationTestServer backup("BackupServer", server_config_);
+    ASSERT_TRUE(primary.start());
+    ASSERT_TRUE(backup.start());
+
+    slick::socket::RedundantTCPClientConfig config;
+    config.primary = client_config_;
+    config.primary.server_port = primary.get_port();
+    config.backup = client_config_;
+    config.backup.server_port = backup.get_port();
+    config.heartbeat_interval = std::chrono::milliseconds(20);
+    config.heartbeat_timeout = std::chrono::milliseconds(100);
+    config.heartbeat_message = {'h', 'b'};
+
+    RedundantTestClient client("RedundantClient", config);
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(waitForCondition([&]() { return primary.connected_clients.load() == 1 && client.data_received_count.load() > 2; }));
+
+    // A stalled primary stops echoing heartbeats while its connection stays open
+    auto stalled_at = std::chrono::steady_clock::now().time_since_epoch().count();
+    primary.pause_reading(primary.last_connected_client_id.load());
+    ASSERT_TRUE(waitForCondition([&]() { return client.failover_at.load() != 0; }));
+    EXPECT_EQ(client.active_link(), RedundantTestClient::backup_link);
+    auto detection_ms = (client.failover_at.load() - stalled_at) / 1000000;
+    RecordProperty("detection_ms", static_cast<int>(detection_ms));
+    EXPECT_GE(detection_ms, 50);
+    EXPECT_LT(detection_ms, 1000);
+    EXPECT_TRUE(client.is_link_up(RedundantTestClient::backup_link));
+
+    client.stop();
+    primary.stop();
+    backup.stop();
+}
+
+TEST_F(TCPIntegrationTest, ServerHeartbeatsIdleClientsAndDropsSilentOnes) {
+    server_config_.heartbeat.idle_interval = std::chrono::milliseconds(30);
+    server_config_.heartbeat.peer_timeout = std::chrono::milliseconds(150);
+    server_config_.heartbeat.frame = {'H', 'B'};
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+
+    // Nothing is sent by the application, so every frame the client sees is a heartbeat
+    ASSERT_TRUE(waitForCondition([this]() { return client_->data_received_count.load() >= 3; }));
+    EXPECT_EQ(client_->last_received_data, "HB");
+
+    // The client never writes, so the server declares it dead after peer_timeout
+    auto connected_at = std::chrono::steady_clock::now();
+    ASSERT_TRUE(waitForCondition([this]() { return server_->heartbeat_timeouts.load() == 1; }));
+    EXPECT_LT(std::chrono::steady_clock::now() - connected_at, std::chrono::milliseconds(1000));
+    EXPECT_TRUE(waitForCondition([this]() { return server_->disconnected_clients.load() == 1; }));   // reported after the timeout
+    EXPECT_TRUE(waitForCondition([this]() { return !client_->is_connected(); }));
+}
+
+TEST_F(TCPIntegrationTest, PausedClientIsExemptFromPeerTimeout) {
+    server_config_.heartbeat.peer_timeout = std::chrono::milliseconds(100);
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+    ASSERT_TRUE(waitForCondition([this]() { return server_->connected_clients.load() == 1; }));
+
+    // Nothing can be received from a paused client, so its silence is not a failure
+    int client_id = server_->last_connected_client_id.load();
+    server_->pause_reading(client_id);
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    EXPECT_EQ(server_->heartbeat_timeouts.load(), 0);
+    EXPECT_TRUE(client_->is_connected());
+
+    // Resumed, the timer starts over
+    auto resumed_at = std::chrono::steady_clock::now();
+    server_->resume_reading(client_id);
+    ASSERT_TRUE(waitForCondition([this]() { return server_->heartbeat_timeouts.load() == 1; }, 1000));
+    EXPECT_GE(std::chrono::steady_clock::now() - resumed_at, std::chrono::milliseconds(100));
+}
+
+TEST_F(TCPIntegrationTest, ClientHeartbeatKeepsAliveAndDetectsStalledServer) {
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_config_.heartbeat.idle_interval = std::chrono::milliseconds(20);
+    client_config_.heartbeat.peer_timeout = std::chrono::milliseconds(150);
+    client_config_.heartbeat.frame = {'p', 'i', 'n', 'g'};
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+
+    // The echo server returns every heartbeat, which keeps the client's peer timer fresh
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    EXPECT_TRUE(client_->is_connected());
+    EXPECT_GT(server_->data_received.load(), 5);
+    EXPECT_EQ(client_->heartbeat_timeouts.load(), 0);
+
+    server_->pause_reading(server_->last_connected_client_id.load());
+    ASSERT_TRUE(waitForCondition([this]() { return client_->heartbeat_timeouts.load() == 1; }, 1000));
+    EXPECT_TRUE(waitForCondition([this]() { return client_->disconnected_count.load() == 1; }));
+    EXPECT_FALSE(client_->is_connected());
+}
+
+TEST_F(TCPIntegrationTest, ClientKeepsReadingWhileAnApplicationSendIsBlocked) {
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+
+    client_config_.server_port = server_->get_port();
+    client_config_.heartbeat.idle_interval = std::chrono::milliseconds(20);
+    client_config_.heartbeat.frame = {'h', 'b'};
+    client_ = std::make_unique<IntegrationTestClient>("IntegrationClient", client_config_);
+    ASSERT_TRUE(client_->connect());
+    ASSERT_TRUE(waitForCondition([this]() { return server_->connected_clients.load() == 1; }));
+
+    // The server stops reading, so this send holds the send lock until it is resumed
+    int client_id = server_->last_connected_client_id.load();
+    server_->pause_reading(client_id);
+    std::atomic<bool> sent{false};
+    std::thread sender([&]() { sent = client_->send_data(std::vector<uint8_t>(32 * 1024 * 1024, 0x42)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(sent.load());
+
+    // Heartbeats fall due meanwhile; they must not stop the client thread from reading
+    server_->post([&]() { server_->send_data(client_id, std::string("still reading")); });
+    EXPECT_TRUE(waitForCondition([this]() { return client_->data_received_flag.load(); }, 1000));
+
+    server_->resume_reading(client_id);
+    sender.join();
+    EXPECT_TRUE(sent.load());
+}
+
+TEST_F(TCPIntegrationTest, SendFileStreamsInOrderWithQueuedData) {
+    // Larger than the socket buffers, so the file is resumed from EPOLLOUT several times
+    std::vector<uint8_t> contents(8 * 1024 * 1024);
+    for (size_t i = 0; i < contents.size(); ++i) {
+        contents[i] = static_cast<uint8_t>(i * 11 + (i >> 16));
+    }
+    std::string path = (std::filesystem::temp_directory_path() / "slick_socket_send_file_test.bin").string();
+    FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fwrite(contents.data(), 1, contents.size(), file), contents.size());
+    std::fclose(file);
+#if defined(_WIN32) || defined(_WIN64)
+    int fd = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+#endif
+    ASSERT_GE(fd, 0);
+
+    server_ = std::make_unique<IntegrationTestServer>("IntegrationServer", server_config_);
+    ASSERT_TRUE(server_->start());
+    client_config_.server_port = server_->get_port();
+    CollectingClient client("CollectingClient", client_config_);
+    ASSERT_TRUE(client.connect());
+    ASSERT_TRUE(waitForCondition([this]() { return server_->connected_clients.load() == 1; }));
+
+    // Bytes, the whole file, bytes, a slice of the file, bytes; all queued in one go
+    const std::vector<uint8_t> head(300000, 'H'), middle(5, 'M'), tail(3, 'T');
+    const uint64_t slice_offset = 1000003, slice_length = 65537;
+    std::atomic<bool> queued{false};
+    server_->post([&]() {
+        int id = server_->last_connected_client_id.load();
+        bool ok = server_->send_data(id, head) && server_->send_file(id, fd) && server_->send_data(id, middle) &&
+                  server_->send_file(id, fd, slice_offset, slice_length) && server_->send_data(id, tail);
+        queued = ok;
+    });
+
+    std::vector<uint8_t> expected = head;
+    expected.insert(expected.end(), contents.begin(), contents.end());
+    expected.insert(expected.end(), middle.begin(), middle.end());
+    expected.insert(expected.end(), contents.begin() + slice_offset, contents.begin() + slice_offset + slice_length);
+    expected.insert(expected.end(), tail.begin(), tail.end());
+
+    ASSERT_TRUE(waitForCondition([&]() { return client.received_size() >= expected.size(); }, 10000));
+    EXPECT_TRUE(queued.load());
+    {
+        std::lock_guard<std::mutex> lock(client.mutex);
+        EXPECT_TRUE(client.received == expected);
+    }
+
+    client.disconnect();
+#if defined(_WIN32) || defined(_WIN64)
+    _close(fd);
+#else
+    close(fd);
+#endif
+    std::remove(path.c_str());
+}
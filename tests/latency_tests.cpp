@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <slick/socket/latency.h>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+
+using namespace slick::socket;
+
+TEST(LatencyHistogramTest, BucketsBoundRelativeError) {
+    for (uint64_t value : std::initializer_list<uint64_t>{0, 1, 15, 16, 17, 31, 32, 1000, 123456789, UINT64_MAX})
+    {
+        size_t bucket = LatencyHistogram::bucket_of(value);
+        ASSERT_LT(bucket, LatencyHistogram::bucket_count);
+        uint64_t upper = LatencyHistogram::bucket_upper(bucket);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(upper - value, value / 16) << value;
+        if (bucket > 0)
+        {
+            EXPECT_LT(LatencyHistogram::bucket_upper(bucket - 1), value);
+        }
+    }
+}
+
+TEST(LatencyHistogramTest, PercentilesAndSkew) {
+    auto histogram = std::make_unique<LatencyHistogram>();
+    EXPECT_EQ(histogram->percentile(0.5), 0u);
+
+    for (uint64_t value = 1; value <= 1000; ++value)
+    {
+        histogram->record(value * 1000);
+    }
+    EXPECT_EQ(histogram->count(), 1000u);
+    EXPECT_EQ(histogram->min(), 1000u);
+    EXPECT_EQ(histogram->max(), 1000000u);
+    EXPECT_DOUBLE_EQ(histogram->mean(), 500500.0);
+    EXPECT_NEAR(static_cast<double>(histogram->percentile(0.5)), 500000.0, 500000.0 / 16);
+    EXPECT_NEAR(static_cast<double>(histogram->percentile(0.99)), 990000.0, 990000.0 / 16);
+    EXPECT_EQ(histogram->percentile(1.0), 1000000u);
+
+    histogram->record_since(2000, 1500);    // sender clock ahead
+    EXPECT_EQ(histogram->clock_skew(), 1u);
+    EXPECT_EQ(histogram->min(), 0u);
+
+    histogram->reset();
+    EXPECT_EQ(histogram->count(), 0u);
+    EXPECT_EQ(histogram->max(), 0u);
+}
@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include <slick/socket/message.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace slick::socket;
+
+namespace
+{
+
+enum class Side : uint8_t
+{
+    Buy = 'B',
+    Sell = 'S',
+};
+
+using AddOrder = MessageSchema<1, ByteOrder::Big,
+    Field<"order_id", uint64_t>,
+    Field<"side", Side>,
+    Field<"quantity", uint32_t>,
+    Field<"symbol", char[8]>,
+    Field<"price", double>>;
+
+using CancelOrder = MessageSchema<3, ByteOrder::Little,
+    Field<"order_id", uint64_t>,
+    Field<"partial", bool>,
+    Field<"remaining", int32_t>>;
+
+static_assert(AddOrder::size == 29);
+static_assert(AddOrder::offsets[3] == 13);
+static_assert(AddOrder::index_of("price") == 4);
+static_assert(AddOrder::index_of("missing") == AddOrder::field_count);
+
+struct RecordingHandler
+{
+    void onMessage(MessageView<AddOrder> order)
+    {
+        added.push_back(order.get<"order_id">());
+        symbols.emplace_back(order.get<"symbol">());
+    }
+
+    void onMessage(MessageView<CancelOrder> cancel)
+    {
+        cancelled.push_back(cancel.get<"order_id">());
+    }
+
+    void onUnknownMessage(uint16_t type, const uint8_t*, size_t)
+    {
+        unknown.push_back(type);
+    }
+
+    std::vector<uint64_t> added;
+    std::vector<std::string> symbols;
+    std::vector<uint64_t> cancelled;
+    std::vector<uint16_t> unknown;
+};
+
+void append_add(std::vector<uint8_t>& out, uint64_t id, const char* symbol)
+{
+    append_message<AddOrder>(out)
+        .set<"order_id">(id)
+        .set<"side">(Side::Sell)
+        .set<"quantity">(100u)
+        .set<"symbol">(symbol)
+        .set<"price">(101.25);
+}
+
+} // namespace
+
+TEST(MessageTest, FieldsUseTheSchemaByteOrderAtPackedOffsets) {
+    std::vector<uint8_t> out;
+    append_add(out, 0x0102030405060708ull, "AAPL");
+    ASSERT_EQ(out.size(), message_header_size + AddOrder::size);
+
+    const uint8_t* body = out.data() + message_header_size;
+    EXPECT_EQ(body[0], 0x01);          // big endian on the wire
+    EXPECT_EQ(body[7], 0x08);
+    EXPECT_EQ(body[8], 'S');
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(body + 13), 8), std::string("AAPL\0\0\0\0", 8));
+
+    // Read from an odd address: loads must not assume alignment
+    std::vector<uint8_t> shifted(1, 0);
+    shifted.insert(shifted.end(), body, body + AddOrder::size);
+    MessageView<AddOrder> view(shifted.data() + 1);
+    EXPECT_EQ(view.get<"order_id">(), 0x0102030405060708ull);
+    EXPECT_EQ(view.get<"side">(), Side::Sell);
+    EXPECT_EQ(view.get<"quantity">(), 100u);
+    EXPECT_EQ(view.get<"symbol">(), "AAPL");
+    EXPECT_EQ(view.get<"price">(), 101.25);
+
+    uint8_t little[CancelOrder::size];
+    MessageWriter<CancelOrder>(little).set<"order_id">(7).set<"partial">(true).set<"remaining">(-5);
+    EXPECT_EQ(little[0], 7);
+    MessageView<CancelOrder> cancel(little);
+    EXPECT_TRUE(cancel.get<"partial">());
+    EXPECT_EQ(cancel.get<"remaining">(), -5);
+}
+
+TEST(MessageTest, FullWidthTextHasNoTerminator) {
+    uint8_t body[AddOrder::size];
+    MessageWriter<AddOrder> writer(body);
+    writer.set<"symbol">(std::string_view("ABCDEFGHIJ"));
+    EXPECT_EQ(writer.view().get<"symbol">(), "ABCDEFGH");
+}
+
+TEST(MessageTest, FramerDispatchesAcrossArbitrarySplits) {
+    std::vector<uint8_t> stream;
+    append_add(stream, 1, "MSFT");
+    append_message<CancelOrder>(stream).set<"order_id">(1);
+    // Unknown type 2 and a truncated AddOrder (type 1 with a 4-byte body)
+    stream.insert(stream.end(), {2, 0, 2, 0, 0xAA, 0xBB});
+    stream.insert(stream.end(), {4, 0, 1, 0, 1, 2, 3, 4});
+    append_add(stream, 2, "IBM");
+
+    for (size_t split = 1; split <= stream.size(); ++split)
+    {
+        RecordingHandler handler;
+        MessageDispatcher<RecordingHandler, AddOrder, CancelOrder> dispatcher(handler);
+        MessageFramer framer;
+        for (size_t at = 0; at < stream.size(); at += split)
+        {
+            size_t chunk = std::min(split, stream.size() - at);
+            ASSERT_TRUE(framer.feed(stream.data() + at, chunk, dispatcher));
+        }
+
+        EXPECT_EQ(handler.added, (std::vector<uint64_t>{1, 2})) << "split " << split;
+        EXPECT_EQ(handler.symbols, (std::vector<std::string>{"MSFT", "IBM"}));
+        EXPECT_EQ(handler.cancelled, (std::vector<uint64_t>{1}));
+        EXPECT_EQ(handler.unknown, (std::vector<uint16_t>{2}));
+        EXPECT_EQ(dispatcher.unknown_count(), 1u);
+        EXPECT_EQ(dispatcher.malformed_count(), 1u);
+        EXPECT_EQ(framer.buffered(), 0u);
+    }
+}
+
+TEST(MessageTest, WholeMessagesAreDeliveredInPlace) {
+    std::vector<uint8_t> stream;
+    append_message<CancelOrder>(stream);
+    append_message<CancelOrder>(stream);
+
+    std::vector<const uint8_t*> bodies;
+    MessageFramer framer;
+    ASSERT_TRUE(framer.feed(stream.data(), stream.size(), [&](uint16_t, const uint8_t* body, size_t) {
+        bodies.push_back(body);
+    }));
+    ASSERT_EQ(bodies.size(), 2u);
+    EXPECT_EQ(bodies[0], stream.data() + message_header_size);
+    EXPECT_EQ(bodies[1], stream.data() + 2 * message_header_size + CancelOrder::size);
+}
+
+TEST(MessageTest, OversizedAndTruncatedInputIsRejected) {
+    auto noop = [](uint16_t, const uint8_t*, size_t) {};
+    const uint8_t oversized[] = {0x00, 0x10, 1, 0};
+    MessageFramer limited(1024);
+    EXPECT_FALSE(limited.feed(oversized, sizeof(oversized), noop));
+
+    std::vector<uint8_t> datagram;
+    append_message<CancelOrder>(datagram);
+    EXPECT_TRUE(MessageFramer::for_each_message(datagram.data(), datagram.size(), noop));
+    EXPECT_FALSE(MessageFramer::for_each_message(datagram.data(), datagram.size() - 1, noop));
+}
+
+TEST(MessageTest, CorruptMessagesAreDroppedAndCounted) {
+    std::vector<uint8_t> stream;
+    for (uint64_t id = 1; id <= 3; ++id)
+    {
+        size_t at = stream.size();
+        append_add(stream, id, "AMZN");
+        seal_message(stream, at);
+    }
+    const size_t frame = message_header_size + AddOrder::size + message_trailer_size(MessageIntegrity::CRC32C);
+    ASSERT_EQ(stream.size(), 3 * frame);
+    stream[frame + message_header_size + 2] ^= 0x04;   // damage a field of the second message
+
+    for (size_t split : {stream.size(), size_t(5)})
+    {
+        RecordingHandler handler;
+        MessageDispatcher<RecordingHandler, AddOrder, CancelOrder> dispatcher(handler);
+        MessageFramer framer(0xFFFF, MessageIntegrity::CRC32C);
+        for (size_t at = 0; at < stream.size(); at += split)
+        {
+            ASSERT_TRUE(framer.feed(stream.data() + at, std::min(split, stream.size() - at), dispatcher));
+        }
+        EXPECT_EQ(handler.added, (std::vector<uint64_t>{1, 3})) << "split " << split;
+        EXPECT_EQ(framer.corrupt_count(), 1u);
+        EXPECT_EQ(framer.buffered(), 0u);
+    }
+
+    size_t delivered = 0;
+    auto count = [&](uint16_t, const uint8_t*, size_t) { ++delivered; };
+    EXPECT_TRUE(MessageFramer::for_each_message(stream.data(), frame, count, MessageIntegrity::CRC32C));
+    EXPECT_FALSE(MessageFramer::for_each_message(stream.data() + frame, frame, count, MessageIntegrity::CRC32C));
+    EXPECT_EQ(delivered, 1u);
+}
+
+TEST(MessageTest, TimestampedMessagesRecordLatency) {
+    std::vector<uint8_t> stream;
+    for (uint64_t id = 1; id <= 2; ++id)
+    {
+        size_t at = stream.size();
+        append_message<CancelOrder>(stream).set<"order_id">(id);
+        stamp_message(stream);
+        seal_message(stream, at);
+    }
+    ASSERT_EQ(stream.size(), 2 * (message_header_size + CancelOrder::size +
+                                  message_trailer_size(MessageIntegrity::CRC32C, MessageTimestamp::Send)));
+
+    auto latency = std::make_unique<LatencyHistogram>();
+    RecordingHandler handler;
+    MessageDispatcher<RecordingHandler, AddOrder, CancelOrder> dispatcher(handler);
+    MessageFramer framer(0xFFFF, MessageIntegrity::CRC32C, MessageTimestamp::Send);
+    framer.set_latency_histogram(latency.get());
+    ASSERT_TRUE(framer.feed(stream.data(), 7, dispatcher));     // first message split across reads
+    ASSERT_TRUE(framer.feed(stream.data() + 7, stream.size() - 7, dispatcher));
+
+    EXPECT_EQ(handler.cancelled, (std::vector<uint64_t>{1, 2}));
+    EXPECT_EQ(framer.corrupt_count(), 0u);
+    EXPECT_EQ(latency->count(), 2u);
+    EXPECT_EQ(latency->clock_skew(), 0u);
+    EXPECT_LT(latency->max(), 10'000'000'000u);
+
+    size_t delivered = 0;
+    EXPECT_TRUE(MessageFramer::for_each_message(stream.data(), stream.size(),
+                                                [&](uint16_t, const uint8_t*, size_t) { ++delivered; },
+                                                MessageIntegrity::CRC32C, MessageTimestamp::Send));
+    EXPECT_EQ(delivered, 2u);
+}
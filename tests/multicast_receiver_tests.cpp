@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <slick/socket/multicast_receiver.h>
+#include <slick/socket/multicast_sender.h>
 #include <thread>
 #include <chrono>
 #include <atomic>
@@ -26,6 +27,84 @@ public:
     std::string last_sender_address;
 };
 
+// Uses the zero-copy handler, so the receiver loop reads into a BufferPool buffer
+class RawMulticastReceiver : public slick::socket::MulticastReceiverBase<RawMulticastReceiver>
+{
+public:
+    using slick::socket::MulticastReceiverBase<RawMulticastReceiver>::MulticastReceiverBase;
+
+    void handle_multicast_data(const uint8_t* data, size_t length, const std::string& sender_address)
+    {
+        data_received_count++;
+    }
+
+    std::atomic<int> data_received_count{0};
+};
+
+struct QuietTraits : slick::socket::DefaultSocketTraits
+{
+    static constexpr size_t receive_buffer_size = 1500;
+    static constexpr bool enable_stats = false;
+    static constexpr bool enable_logging = false;
+};
+
+class QuietMulticastReceiver : public slick::socket::MulticastReceiverBase<QuietMulticastReceiver, QuietTraits>
+{
+public:
+    using slick::socket::MulticastReceiverBase<QuietMulticastReceiver, QuietTraits>::MulticastReceiverBase;
+
+    void handle_multicast_data(const uint8_t* data, size_t length, const std::string& sender_address)
+    {
+        data_received_count++;
+    }
+
+    std::atomic<int> data_received_count{0};
+};
+
+// Takes the sender as a binary Endpoint, so no address is formatted per datagram
+class EndpointMulticastReceiver : public slick::socket::MulticastReceiverBase<EndpointMulticastReceiver>
+{
+public:
+    using slick::socket::MulticastReceiverBase<EndpointMulticastReceiver>::MulticastReceiverBase;
+
+    void handle_multicast_data(const uint8_t* data, size_t length, const slick::socket::Endpoint& sender)
+    {
+        last_sender = sender;
+        data_received_count++;
+    }
+
+    slick::socket::Endpoint last_sender;
+    std::atomic<int> data_received_count{0};
+};
+
+// Sequenced group: records payload sizes and the integrity hooks
+class SequencedMulticastReceiver : public slick::socket::MulticastReceiverBase<SequencedMulticastReceiver>
+{
+public:
+    using slick::socket::MulticastReceiverBase<SequencedMulticastReceiver>::MulticastReceiverBase;
+
+    void handle_multicast_data(const uint8_t* data, size_t length, const slick::socket::Endpoint& sender)
+    {
+        last_length = length;
+        data_received_count++;
+    }
+
+    void onCorruptPacket(const uint8_t* data, size_t length, const slick::socket::Endpoint& sender)
+    {
+        corrupt_count++;
+    }
+
+    void onSequenceGap(uint64_t expected, uint64_t received)
+    {
+        gap_size = received - expected;
+    }
+
+    std::atomic<size_t> last_length{0};
+    std::atomic<int> data_received_count{0};
+    std::atomic<int> corrupt_count{0};
+    std::atomic<uint64_t> gap_size{0};
+};
+
 class MulticastReceiverTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -131,6 +210,65 @@ TEST_F(MulticastReceiverTest, ReceiverRestart) {
     receiver_->stop();
 }
 
+TEST_F(MulticastReceiverTest, RawHandlerReceiverStartAndStop) {
+    RawMulticastReceiver receiver("RawMulticastReceiver", config_);
+    EXPECT_TRUE(receiver.start());
+    EXPECT_TRUE(receiver.is_running());
+    receiver.stop();
+    EXPECT_FALSE(receiver.is_running());
+    EXPECT_EQ(receiver.data_received_count.load(), 0);
+}
+
+TEST_F(MulticastReceiverTest, CustomTraitsReceiverStartAndStop) {
+    QuietMulticastReceiver receiver("QuietMulticastReceiver", config_);
+    EXPECT_TRUE(receiver.start());
+    EXPECT_TRUE(receiver.is_running());
+    receiver.stop();
+    EXPECT_FALSE(receiver.is_running());
+    // Counters are compiled out
+    EXPECT_EQ(receiver.get_packets_received(), 0u);
+    EXPECT_EQ(receiver.get_receive_errors(), 0u);
+}
+
+TEST_F(MulticastReceiverTest, IPv6GroupDeliversEndpoint) {
+    config_.multicast_address = "ff02::1:7";
+    config_.interface_address = "";
+    EndpointMulticastReceiver receiver("EndpointMulticastReceiver", config_);
+    if (!receiver.start()) {
+        GTEST_SKIP() << "no IPv6 multicast route";
+    }
+
+    slick::socket::MulticastSenderConfig sender_config;
+    sender_config.multicast_address = config_.multicast_address;
+    sender_config.port = config_.port;
+    sender_config.enable_loopback = true;
+    slick::socket::MulticastSender sender("IPv6Sender", sender_config);
+    ASSERT_TRUE(sender.start());
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (receiver.data_received_count.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        sender.send_data(std::string("v6"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    sender.stop();
+    receiver.stop();
+    if (receiver.data_received_count.load() == 0) {
+        GTEST_SKIP() << "IPv6 multicast loopback unavailable";
+    }
+    EXPECT_TRUE(receiver.last_sender.is_v6());
+}
+
+TEST_F(MulticastReceiverTest, WarmupReportsStartupPhases) {
+    config_.warmup.enabled = true;
+    receiver_ = std::make_unique<TestMulticastReceiver>("TestMulticastReceiver", config_);
+    ASSERT_TRUE(receiver_->start());
+
+    const auto& report = receiver_->get_startup_report();
+    EXPECT_GE(report.bytes_prefaulted, static_cast<size_t>(config_.receive_buffer_size));
+    EXPECT_GE(report.total, report.socket_setup);
+    receiver_->stop();
+}
+
 TEST_F(MulticastReceiverTest, InvalidMulticastAddress) {
     // Test with invalid multicast address
     config_.multicast_address = "invalid.address";
@@ -192,4 +330,67 @@ TEST_F(MulticastReceiverTest, ReceiverPortBinding) {
     EXPECT_TRUE(receiver_->is_running());
     
     receiver_->stop();
-}
\ No newline at end of file
+}
+TEST_F(MulticastReceiverTest, SequencedGroupDropsCorruptDatagramsAndCountsGaps) {
+    config_.multicast_address = "224.0.0.102";
+    config_.port = 12347;
+    config_.sequenced = true;
+    SequencedMulticastReceiver receiver("SequencedMulticastReceiver", config_);
+    ASSERT_TRUE(receiver.start());
+
+    slick::socket::MulticastSenderConfig sender_config;
+    sender_config.multicast_address = config_.multicast_address;
+    sender_config.port = config_.port;
+    sender_config.enable_loopback = true;
+    sender_config.sequenced = true;
+    sender_config.checksum = true;
+    sender_config.timestamp = true;
+    slick::socket::MulticastSender sender("SequencedSender", sender_config);
+    ASSERT_TRUE(sender.start());
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (receiver.data_received_count.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        sender.send_data(std::string("hello"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    if (receiver.data_received_count.load() == 0) {
+        sender.stop();
+        receiver.stop();
+        GTEST_SKIP() << "multicast loopback unavailable";
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(receiver.last_length.load(), 5u);    // header stripped
+    EXPECT_EQ(receiver.get_sequence_gaps(), 0u);
+    EXPECT_EQ(receiver.get_latency_histogram().count(), static_cast<uint64_t>(receiver.data_received_count.load()));
+
+    // Datagrams crafted through a plain sender: one damaged in flight, then one after a gap
+    sender_config.sequenced = false;
+    slick::socket::MulticastSender raw("RawSender", sender_config);
+    ASSERT_TRUE(raw.start());
+    const std::string payload = "payload";
+    uint64_t next = sender.get_next_sequence();
+    std::vector<uint8_t> packet(slick::socket::packet_header_size);
+    slick::socket::write_packet_header(packet.data(), next + 5, slick::socket::packet_flag_checksum,
+                                       reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+    packet.insert(packet.end(), payload.begin(), payload.end());
+    packet.back() ^= 0x01;
+    int delivered = receiver.data_received_count.load();
+    ASSERT_TRUE(raw.send_data(packet));
+    packet.back() ^= 0x01;
+    ASSERT_TRUE(raw.send_data(packet));
+
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (receiver.data_received_count.load() == delivered && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    raw.stop();
+    sender.stop();
+    receiver.stop();
+
+    EXPECT_EQ(receiver.data_received_count.load(), delivered + 1);
+    EXPECT_EQ(receiver.get_corrupt_packets(), 1u);
+    EXPECT_EQ(receiver.corrupt_count.load(), 1);
+    EXPECT_EQ(receiver.get_sequence_gaps(), 5u);
+    EXPECT_EQ(receiver.gap_size.load(), 5u);
+    EXPECT_EQ(receiver.last_length.load(), payload.size());
+}
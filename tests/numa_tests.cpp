@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <slick/socket/numa.h>
+#include <slick/socket/buffer_pool.h>
+#include <thread>
+
+using namespace slick::socket;
+
+TEST(NumaTest, ExplicitNodeWinsOverInterface) {
+    EXPECT_EQ(resolve_numa_node(1, "eth0"), 1);
+    EXPECT_EQ(resolve_numa_node(-1, ""), -1);
+    EXPECT_EQ(resolve_numa_node(numa_max_nodes, ""), -1);
+}
+
+TEST(NumaTest, UnknownInterfaceHasNoNode) {
+    EXPECT_EQ(numa_node_of_interface("no-such-interface"), -1);
+    EXPECT_EQ(resolve_numa_node(-1, "no-such-interface"), -1);
+}
+
+TEST(NumaTest, CpuListParsing) {
+    EXPECT_EQ(parse_cpu_list("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(parse_cpu_list("5"), (std::vector<int>{5}));
+
+    // Malformed sysfs content means no NUMA information, never an exception
+    EXPECT_TRUE(parse_cpu_list("").empty());
+    EXPECT_TRUE(parse_cpu_list("x").empty());
+    EXPECT_TRUE(parse_cpu_list("0-").empty());
+    EXPECT_TRUE(parse_cpu_list("4-2").empty());
+    EXPECT_TRUE(parse_cpu_list("0-3,junk").empty());
+    EXPECT_TRUE(parse_cpu_list("99999999999").empty());
+}
+
+#if defined(__linux__)
+TEST(NumaTest, LoopbackAddressMapsToLoopbackInterface) {
+    EXPECT_EQ(interface_of_address("127.0.0.1"), "lo");
+    EXPECT_TRUE(interface_of_address("not an address").empty());
+}
+
+TEST(NumaTest, NodeZeroListsItsCpus) {
+    std::vector<int> cpus = numa_node_cpus(0);
+    if (cpus.empty()) {
+        GTEST_SKIP() << "no NUMA topology in sysfs";
+    }
+    EXPECT_GE(cpus.front(), 0);
+}
+#endif
+
+TEST(NumaTest, ThreadBoundToNodeUsesNodeArena) {
+    std::thread([]() {
+        auto& pool = BufferPool::instance();
+        pool.set_thread_node(0);
+        {
+            PooledBuffer buffer = pool.acquire(4096);
+            ASSERT_FALSE(buffer.empty());
+            EXPECT_GT(pool.arena_size(0), 0u);
+            EXPECT_GT(pool.arena_used(0), 0u);
+        }
+        pool.set_thread_node(-1);
+    }).join();
+}
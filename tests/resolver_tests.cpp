@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <slick/socket/resolver.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace slick::socket;
+using namespace std::chrono_literals;
+
+TEST(ResolverTest, NumericAddressesSkipTheCache) {
+    Resolver resolver;
+    std::vector<Endpoint> endpoints;
+    ASSERT_TRUE(resolver.resolve_now("10.1.2.3", 5000, endpoints));
+    ASSERT_EQ(endpoints.size(), 1u);
+    EXPECT_EQ(endpoints[0].to_string(), "10.1.2.3:5000");
+
+    endpoints = resolver.resolve_wait("::1", 6000, 1000ms);
+    ASSERT_EQ(endpoints.size(), 1u);
+    EXPECT_EQ(endpoints[0].to_string(), "[::1]:6000");
+    EXPECT_EQ(resolver.cache_hits(), 0u);
+    EXPECT_EQ(resolver.cache_misses(), 0u);
+}
+
+TEST(ResolverTest, CachesHostNames) {
+    Resolver resolver;
+    auto endpoints = resolver.resolve_wait("localhost", 5000, 5000ms);
+    ASSERT_FALSE(endpoints.empty());
+    for (const auto& endpoint : endpoints) {
+        EXPECT_TRUE(endpoint.is_loopback());
+        EXPECT_EQ(endpoint.port, 5000);
+    }
+    EXPECT_EQ(resolver.cache_misses(), 1u);
+
+    // Served from the cache with the new port
+    std::vector<Endpoint> cached;
+    ASSERT_TRUE(resolver.resolve_now("localhost", 6000, cached));
+    ASSERT_EQ(cached.size(), endpoints.size());
+    EXPECT_EQ(cached[0].port, 6000);
+    EXPECT_EQ(resolver.cache_hits(), 1u);
+
+    resolver.clear_cache();
+    EXPECT_FALSE(resolver.resolve_now("localhost", 6000, cached));
+}
+
+TEST(ResolverTest, FailedLookupIsCachedAsEmpty) {
+    Resolver resolver;
+    EXPECT_TRUE(resolver.resolve_wait("no-such-host.invalid", 80, 5000ms).empty());
+
+    std::vector<Endpoint> endpoints;
+    EXPECT_TRUE(resolver.resolve_now("no-such-host.invalid", 80, endpoints));
+    EXPECT_TRUE(endpoints.empty());
+}
+
+TEST(ResolverTest, ConcurrentLookupsShareOneQuery) {
+    Resolver resolver;
+    std::atomic<int> completed{0};
+    std::atomic<int> resolved{0};
+    for (uint16_t port = 1; port <= 8; ++port) {
+        resolver.resolve("localhost", port, [&, port](const std::vector<Endpoint>& endpoints) {
+            if (!endpoints.empty() && endpoints[0].port == port) {
+                ++resolved;
+            }
+            ++completed;
+        });
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (completed.load() < 8 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(resolved.load(), 8);
+    // The first call misses and queues the lookup; the others either join it or hit the cache
+    EXPECT_EQ(resolver.cache_hits() + resolver.cache_misses(), 8u);
+}
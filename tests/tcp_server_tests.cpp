@@ -80,6 +80,24 @@ TEST_F(TCPServerTest, ServerStatistics) {
     server_->stop();
 }
 
+TEST_F(TCPServerTest, PostWhileStoppedIsDropped) {
+    server_ = std::make_unique<TestServer>("TestServer", config_);
+    std::atomic<int> ran{0};
+    EXPECT_FALSE(server_->post([&ran]() { ran++; }));
+
+    ASSERT_TRUE(server_->start());
+    EXPECT_TRUE(server_->post([&ran]() { ran++; }));
+    server_->stop();
+    EXPECT_FALSE(server_->post([&ran]() { ran++; }));
+
+    // Restarting runs nothing left over from the stopped period
+    int ran_before_restart = ran.load();
+    ASSERT_TRUE(server_->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(ran.load(), ran_before_restart);
+    server_->stop();
+}
+
 TEST_F(TCPServerTest, ConfigurationValidation) {
     // Test valid configuration
     slick::socket::TCPServerConfig valid_config;
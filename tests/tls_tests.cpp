@@ -0,0 +1,290 @@
+#include <gtest/gtest.h>
+#include "../examples/logger.h"
+#include <slick/socket/tcp_server.h>
+#include <slick/socket/tcp_client.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <fcntl.h>
+#include <unistd.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(SLICK_SOCKET_ENABLE_TLS)
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+#endif
+
+using namespace slick::socket;
+
+namespace
+{
+
+class TLSEchoServer : public TCPServerBase<TLSEchoServer>
+{
+public:
+    using TCPServerBase<TLSEchoServer>::TCPServerBase;
+    using TCPServerBase<TLSEchoServer>::get_tls_offload;
+    using TCPServerBase<TLSEchoServer>::send_file;
+
+    void onClientConnected(int client_id, const std::string&)
+    {
+        last_client_id = client_id;
+        ++connected;
+    }
+
+    void onClientDisconnected(int) { ++disconnected; }
+
+    void onClientData(int client_id, const uint8_t* data, size_t length)
+    {
+        send_data(client_id, std::vector<uint8_t>(data, data + length));
+    }
+
+    std::atomic<int> connected{0};
+    std::atomic<int> disconnected{0};
+    std::atomic<int> last_client_id{-1};
+};
+
+class TLSTestClient : public TCPClientBase<TLSTestClient>
+{
+public:
+    using TCPClientBase<TLSTestClient>::TCPClientBase;
+
+    void onConnected() {}
+    void onDisconnected() {}
+    void onData(const uint8_t* data, size_t length)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.insert(received.end(), data, data + length);
+    }
+
+    size_t received_size()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return received.size();
+    }
+
+    std::mutex mutex;
+    std::vector<uint8_t> received;
+};
+
+#if defined(SLICK_SOCKET_ENABLE_TLS)
+bool wait_for(const std::function<bool()>& condition, int timeout_ms = 5000)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (condition())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return condition();
+}
+#endif
+
+TCPServerConfig local_server_config()
+{
+    TCPServerConfig config;
+    config.port = 0;
+    config.bind_address = "127.0.0.1";
+    config.tls.enabled = true;
+    return config;
+}
+
+} // namespace
+
+TEST(TLSTest, ServerWithoutCertificateFailsToStart) {
+    // Also covers builds without SLICK_SOCKET_ENABLE_TLS, where any TLS configuration is refused
+    TLSEchoServer server("TLSServer", local_server_config());
+    EXPECT_FALSE(server.start());
+}
+
+#if defined(SLICK_SOCKET_ENABLE_TLS)
+
+namespace
+{
+
+// Self-signed P-256 certificate for localhost/127.0.0.1, written as PEM files
+struct TestCertificate
+{
+    std::string certificate_file;
+    std::string key_file;
+
+    explicit TestCertificate(const std::string& name)
+    {
+        auto directory = std::filesystem::temp_directory_path();
+        certificate_file = (directory / (name + "_cert.pem")).string();
+        key_file = (directory / (name + "_key.pem")).string();
+
+        EVP_PKEY* key = EVP_EC_gen("P-256");
+        X509* cert = X509_new();
+        X509_set_version(cert, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+        X509_gmtime_adj(X509_getm_notBefore(cert), -60);
+        X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+        X509_set_pubkey(cert, key);
+        X509_NAME* subject = X509_get_subject_name(cert);
+        X509_NAME_add_entry_by_txt(subject, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+        X509_set_issuer_name(cert, subject);
+
+        X509V3_CTX context;
+        X509V3_set_ctx_nodb(&context);
+        X509V3_set_ctx(&context, cert, cert, nullptr, nullptr, 0);
+        X509_EXTENSION* names = X509V3_EXT_conf_nid(nullptr, &context, NID_subject_alt_name, "DNS:localhost,IP:127.0.0.1");
+        X509_add_ext(cert, names, -1);
+        X509_EXTENSION_free(names);
+        X509_sign(cert, key, EVP_sha256());
+
+        FILE* file = std::fopen(certificate_file.c_str(), "w");
+        PEM_write_X509(file, cert);
+        std::fclose(file);
+        file = std::fopen(key_file.c_str(), "w");
+        PEM_write_PrivateKey(file, key, nullptr, nullptr, 0, nullptr, nullptr);
+        std::fclose(file);
+
+        X509_free(cert);
+        EVP_PKEY_free(key);
+    }
+
+    ~TestCertificate()
+    {
+        std::remove(certificate_file.c_str());
+        std::remove(key_file.c_str());
+    }
+};
+
+} // namespace
+
+class TLSIntegrationTest : public ::testing::Test {
+protected:
+    TLSIntegrationTest()
+        : certificate_("slick_socket_tls_test_" + std::to_string(getpid()))   // ctest runs tests in parallel processes
+    {
+        server_config_ = local_server_config();
+        server_config_.tls.certificate_file = certificate_.certificate_file;
+        server_config_.tls.private_key_file = certificate_.key_file;
+    }
+
+    TCPClientConfig client_config(uint16_t port, const std::string& ca_file)
+    {
+        TCPClientConfig config;
+        config.server_address = "127.0.0.1";
+        config.server_port = port;
+        config.connection_timeout = std::chrono::milliseconds(3000);
+        config.tls.enabled = true;
+        config.tls.ca_file = ca_file;
+        config.tls.server_name = "localhost";
+        return config;
+    }
+
+    TestCertificate certificate_;
+    TCPServerConfig server_config_;
+};
+
+TEST_F(TLSIntegrationTest, EchoLargePayloadOverVerifiedSession) {
+    TLSEchoServer server("TLSServer", server_config_);
+    ASSERT_TRUE(server.start());
+
+    TLSTestClient client("TLSClient", client_config(server.get_port(), certificate_.certificate_file));
+    ASSERT_TRUE(client.connect());
+    ASSERT_TRUE(wait_for([&]() { return server.connected.load() == 1; }));
+
+    // Several records, and more than the socket buffers hold, so both queues are exercised
+    std::vector<uint8_t> payload(4 * 1024 * 1024);
+    for (size_t i = 0; i < payload.size(); ++i)
+    {
+        payload[i] = static_cast<uint8_t>(i * 7 + (i >> 12));
+    }
+    ASSERT_TRUE(client.send_data(payload));
+    ASSERT_TRUE(wait_for([&]() { return client.received_size() == payload.size(); }, 10000));
+    {
+        std::lock_guard<std::mutex> lock(client.mutex);
+        EXPECT_TRUE(client.received == payload);
+    }
+
+    // kTLS depends on the kernel's tls module; report rather than require it
+    TLSOffload offload = client.get_tls_offload();
+    RecordProperty("client_kernel_send", offload.send ? "yes" : "no");
+    RecordProperty("client_kernel_receive", offload.receive ? "yes" : "no");
+
+    client.disconnect();
+    EXPECT_TRUE(wait_for([&]() { return server.disconnected.load() == 1; }));
+    server.stop();
+}
+
+TEST_F(TLSIntegrationTest, SendFileOverSession) {
+    // SSL_sendfile when the kernel owns the send side, otherwise the copy path through SSL_write
+    std::vector<uint8_t> contents(3 * 1024 * 1024 + 17);
+    for (size_t i = 0; i < contents.size(); ++i)
+    {
+        contents[i] = static_cast<uint8_t>(i * 5 + (i >> 10));
+    }
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("slick_socket_tls_send_file_" + std::to_string(getpid()) + ".bin")).string();
+    FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(contents.data(), 1, contents.size(), file);
+    std::fclose(file);
+    int fd = open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+
+    TLSEchoServer server("TLSServer", server_config_);
+    ASSERT_TRUE(server.start());
+    TLSTestClient client("TLSClient", client_config(server.get_port(), certificate_.certificate_file));
+    ASSERT_TRUE(client.connect());
+    ASSERT_TRUE(wait_for([&]() { return server.connected.load() == 1; }));
+
+    std::atomic<bool> queued{false};
+    server.post([&]() { queued = server.send_file(server.last_client_id.load(), fd); });
+    ASSERT_TRUE(wait_for([&]() { return client.received_size() >= contents.size(); }, 10000));
+    EXPECT_TRUE(queued.load());
+    {
+        std::lock_guard<std::mutex> lock(client.mutex);
+        EXPECT_TRUE(client.received == contents);
+    }
+
+    client.disconnect();
+    server.stop();
+    close(fd);
+    std::remove(path.c_str());
+}
+
+TEST_F(TLSIntegrationTest, UntrustedCertificateIsRejected) {
+    TLSEchoServer server("TLSServer", server_config_);
+    ASSERT_TRUE(server.start());
+
+    TestCertificate other("slick_socket_tls_other");
+    TLSTestClient client("TLSClient", client_config(server.get_port(), other.certificate_file));
+    EXPECT_FALSE(client.connect());
+    EXPECT_FALSE(client.is_connected());
+
+    // The application never hears about clients whose handshake failed
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(server.connected.load(), 0);
+    server.stop();
+}
+
+TEST_F(TLSIntegrationTest, PlaintextClientIsNotReported) {
+    TLSEchoServer server("TLSServer", server_config_);
+    ASSERT_TRUE(server.start());
+
+    TCPClientConfig config = client_config(server.get_port(), "");
+    config.tls.enabled = false;
+    TLSTestClient client("PlainClient", config);
+    ASSERT_TRUE(client.connect());
+    client.send_data(std::string("GET / HTTP/1.1\r\n\r\n"));
+
+    EXPECT_TRUE(wait_for([&]() { return !client.is_connected(); }));
+    EXPECT_EQ(server.connected.load(), 0);
+    client.disconnect();
+    server.stop();
+}
+
+#endif
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <slick/socket/trace.h>
+#include <slick/socket/tcp_server.h>
+#include <slick/socket/tcp_client.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace slick::socket;
+
+namespace
+{
+
+struct TracedTraits : DefaultSocketTraits
+{
+    static constexpr bool enable_logging = false;
+    static constexpr bool enable_tracing = true;
+};
+
+class TracedEchoServer : public TCPServerBase<TracedEchoServer, TracedTraits>
+{
+public:
+    using TCPServerBase<TracedEchoServer, TracedTraits>::TCPServerBase;
+
+    void onClientConnected(int client_id, const std::string& client_address) { last_client = client_id; }
+    void onClientDisconnected(int client_id) {}
+    void onClientData(int client_id, const uint8_t* data, size_t length) {
+        send_data(client_id, std::vector<uint8_t>(data, data + length));
+    }
+
+    std::atomic<int> last_client{0};
+};
+
+class EchoCounter : public TCPClientBase<EchoCounter>
+{
+public:
+    using TCPClientBase<EchoCounter>::TCPClientBase;
+
+    void onConnected() {}
+    void onDisconnected() {}
+    void onData(const uint8_t* data, size_t length) { received += length; }
+
+    std::atomic<size_t> received{0};
+};
+
+std::vector<TraceRecord> spans_of(const std::string& thread_name)
+{
+    std::vector<TraceRecord> result;
+    for (auto& [name, spans] : Tracer::snapshot())
+    {
+        if (name == thread_name)
+        {
+            result.insert(result.end(), spans.begin(), spans.end());
+        }
+    }
+    return result;
+}
+
+bool wait_for(std::function<bool()> condition, int timeout_ms = 5000)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(TraceBufferTest, KeepsTheLatestSpansInOrder) {
+    TraceBuffer buffer("ring", true, 1, 8);
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        TraceRecord record;
+        record.begin = 100 + i;
+        record.end = 200 + i;
+        record.client_id = static_cast<int32_t>(i);
+        record.value = i * 10;
+        record.kind = TraceKind::Send;
+        buffer.push(record);
+    }
+
+    // The oldest slot is the one the writer would overwrite next, so capacity - 1 are returned
+    auto spans = buffer.snapshot();
+    ASSERT_EQ(spans.size(), 7u);
+    for (size_t i = 0; i < spans.size(); ++i)
+    {
+        EXPECT_EQ(spans[i].begin, 113 + i);
+        EXPECT_EQ(spans[i].end, 213 + i);
+        EXPECT_EQ(spans[i].client_id, static_cast<int32_t>(13 + i));
+        EXPECT_EQ(spans[i].value, (13 + i) * 10);
+        EXPECT_EQ(spans[i].kind, TraceKind::Send);
+    }
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.snapshot().empty());
+    TraceRecord record;
+    record.client_id = -1;
+    record.kind = TraceKind::Callback;
+    record.callback = LoopCallback::Task;
+    buffer.push(record);
+    spans = buffer.snapshot();
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_EQ(spans[0].client_id, -1);
+    EXPECT_EQ(spans[0].callback, LoopCallback::Task);
+}
+
+TEST(TracerTest, RecordsSpansPerThreadAndWritesChromeJson) {
+    // Two threads in turn under one name share a ring
+    for (int round = 0; round < 2; ++round)
+    {
+        std::thread([round]() {
+            Tracer::attach_thread("trace \"test\"");
+            {
+                TraceSpan span(TraceKind::Send, 7);
+                span.end(42 + round);
+            }
+            TraceSpan empty_wait(TraceKind::Wait);
+            empty_wait.end_or_discard(0);
+            TraceSpan callback(TraceKind::Callback, 7, LoopCallback::Data);
+        }).join();
+    }
+
+    auto spans = spans_of("trace \"test\"");
+    ASSERT_EQ(spans.size(), 4u);
+    EXPECT_EQ(spans[0].kind, TraceKind::Send);
+    EXPECT_EQ(spans[0].value, 42u);
+    EXPECT_GE(spans[0].end, spans[0].begin);
+    EXPECT_EQ(spans[1].kind, TraceKind::Callback);
+    EXPECT_EQ(spans[1].callback, LoopCallback::Data);
+    EXPECT_EQ(spans[2].value, 43u);
+
+    std::string json = Tracer::chrome_trace_json();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"trace \\\"test\\\"\"}"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"send\",\"cat\":\"io\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"client\":7,\"bytes\":43}"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"data\",\"cat\":\"callback\""), std::string::npos);
+    EXPECT_EQ(json.find("\"events\":0"), std::string::npos);
+}
+
+TEST(TracerTest, ThreadIsLeftUntracedWhenItsRingCannotBeAllocated) {
+    size_t buffers = Tracer::snapshot().size();
+    Tracer::set_buffer_capacity(size_t(1) << 62);    // more bytes than size_t can count
+    std::thread([]() {
+        for (int i = 0; i < 2; ++i)
+        {
+            TraceSpan span(TraceKind::Send, 3);
+            span.end(1);
+        }
+    }).join();
+    Tracer::set_buffer_capacity(size_t(1) << 16);
+    EXPECT_EQ(Tracer::snapshot().size(), buffers);
+}
+
+TEST(TracerTest, TracesTheServerIOPath) {
+    TCPServerConfig server_config;
+    server_config.port = 0;
+    TracedEchoServer server("TracedEchoServer", server_config);
+    ASSERT_TRUE(server.start());
+
+    TCPClientConfig client_config;
+    client_config.server_address = "127.0.0.1";
+    client_config.server_port = server.get_port();
+    EchoCounter client("EchoCounter", client_config);
+    ASSERT_TRUE(client.connect());
+    ASSERT_TRUE(client.send_data(std::string(100, 'x')));
+    ASSERT_TRUE(wait_for([&]() { return client.received.load() == 100; }));
+    client.disconnect();
+    server.stop();
+
+    auto spans = spans_of("TracedEchoServer");
+    int client_id = server.last_client.load();
+    auto has = [&](TraceKind kind, LoopCallback callback, uint32_t value) {
+        return std::any_of(spans.begin(), spans.end(), [&](const TraceRecord& span) {
+            return span.kind == kind && span.callback == callback && span.value == value &&
+                   (kind == TraceKind::Wait || span.client_id == client_id);
+        });
+    };
+    EXPECT_TRUE(has(TraceKind::Receive, LoopCallback::None, 100));
+    EXPECT_TRUE(has(TraceKind::Send, LoopCallback::None, 100));
+    EXPECT_TRUE(has(TraceKind::Callback, LoopCallback::Connected, 0));
+    EXPECT_TRUE(has(TraceKind::Callback, LoopCallback::Data, 0));
+    EXPECT_TRUE(std::any_of(spans.begin(), spans.end(),
+                            [](const TraceRecord& span) { return span.kind == TraceKind::Wait && span.value > 0; }));
+    for (const TraceRecord& span : spans)
+    {
+        EXPECT_GE(span.end, span.begin);
+    }
+}
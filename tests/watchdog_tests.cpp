@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include <slick/socket/watchdog.h>
+#include <slick/socket/tcp_server.h>
+#include <slick/socket/tcp_client.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace slick::socket;
+
+namespace
+{
+
+struct MonitoredTraits : DefaultSocketTraits
+{
+    static constexpr bool enable_logging = false;
+    static constexpr bool enable_loop_monitor = true;
+};
+
+// onClientData blocks the loop for block_ms
+class SlowServer : public TCPServerBase<SlowServer, MonitoredTraits>
+{
+public:
+    using TCPServerBase<SlowServer, MonitoredTraits>::TCPServerBase;
+
+    void onClientConnected(int client_id, const std::string& client_address) { last_client = client_id; }
+    void onClientDisconnected(int client_id) {}
+    void onClientData(int client_id, const uint8_t* data, size_t length) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(block_ms));
+        handled++;
+    }
+
+    int block_ms = 80;
+    std::atomic<int> last_client{0};
+    std::atomic<int> handled{0};
+};
+
+class PlainClient : public TCPClientBase<PlainClient>
+{
+public:
+    using TCPClientBase<PlainClient>::TCPClientBase;
+
+    void onConnected() {}
+    void onDisconnected() {}
+    void onData(const uint8_t* data, size_t length) {}
+};
+
+// Collects reports from the watchdog thread
+struct StallLog
+{
+    void operator()(const StallReport& report) {
+        std::lock_guard<std::mutex> lock(mutex);
+        reports.push_back(report);
+    }
+
+    std::vector<StallReport> snapshot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return reports;
+    }
+
+    std::mutex mutex;
+    std::vector<StallReport> reports;
+};
+
+bool wait_for(std::function<bool()> condition, int timeout_ms = 5000)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(LoopMonitorTest, TracksNestedCallbacksAndDurations) {
+    LoopMonitor monitor;
+    EXPECT_FALSE(monitor.snapshot().busy);
+
+    monitor.loop_busy();
+    {
+        auto outer = monitor.callback_scope(LoopCallback::Data, 3);
+        {
+            auto inner = monitor.callback_scope(LoopCallback::Disconnected, 3);
+            EXPECT_EQ(monitor.snapshot().callback, LoopCallback::Disconnected);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        LoopMonitor::Snapshot during = monitor.snapshot();
+        EXPECT_TRUE(during.busy);
+        EXPECT_EQ(during.iteration, 1u);
+        EXPECT_EQ(during.callback, LoopCallback::Data);
+        EXPECT_EQ(during.client_id, 3);
+        EXPECT_GE(during.callback_ns, 1'000'000u);
+    }
+    monitor.loop_idle();
+
+    LoopMonitor::Snapshot after = monitor.snapshot();
+    EXPECT_FALSE(after.busy);
+    EXPECT_EQ(after.callback, LoopCallback::None);
+    EXPECT_EQ(after.client_id, -1);
+
+    const LatencyHistogram& data = monitor.callback_histogram(LoopCallback::Data);
+    const LatencyHistogram& disconnected = monitor.callback_histogram(LoopCallback::Disconnected);
+    EXPECT_EQ(data.count(), 1u);
+    EXPECT_EQ(disconnected.count(), 1u);
+    EXPECT_GE(disconnected.max(), 1'000'000u);
+    EXPECT_GE(data.max(), disconnected.max());   // the outer callback includes the nested one
+    EXPECT_EQ(monitor.callback_histogram(LoopCallback::Task).count(), 0u);
+}
+
+TEST(WatchdogTest, ReportsStallOnceAndItsEnd) {
+    LoopMonitor monitor;
+    StallLog log;
+    WatchdogConfig config;
+    config.stall_threshold = std::chrono::milliseconds(20);
+    config.check_interval = std::chrono::milliseconds(2);
+    Watchdog watchdog(config, std::ref(log));
+    watchdog.watch("loop", monitor);
+    ASSERT_TRUE(watchdog.start());
+
+    // Short wake-ups are not stalls
+    for (int i = 0; i < 5; ++i)
+    {
+        monitor.loop_busy();
+        monitor.loop_idle();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_TRUE(log.snapshot().empty());
+
+    monitor.loop_busy();
+    {
+        auto timing = monitor.callback_scope(LoopCallback::Task, -1);
+        ASSERT_TRUE(wait_for([&]() { return !log.snapshot().empty(); }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    monitor.loop_idle();
+    ASSERT_TRUE(wait_for([&]() { return log.snapshot().size() == 2; }));
+    watchdog.stop();
+
+    auto reports = log.snapshot();
+    ASSERT_EQ(reports.size(), 2u);
+    EXPECT_EQ(reports[0].loop, "loop");
+    EXPECT_EQ(reports[0].callback, LoopCallback::Task);
+    EXPECT_FALSE(reports[0].ended);
+    EXPECT_GE(reports[0].duration, std::chrono::milliseconds(20));
+    EXPECT_TRUE(reports[1].ended);
+    EXPECT_GE(reports[1].duration, reports[0].duration);
+    EXPECT_EQ(watchdog.get_stall_count(), 1u);
+}
+
+TEST(WatchdogTest, NamesTheBlockingServerCallback) {
+    TCPServerConfig server_config;
+    server_config.port = 0;
+    SlowServer server("SlowServer", server_config);
+    ASSERT_TRUE(server.start());
+
+    StallLog log;
+    WatchdogConfig config;
+    config.stall_threshold = std::chrono::milliseconds(30);
+    config.check_interval = std::chrono::milliseconds(5);
+    Watchdog watchdog(config, std::ref(log));
+    watchdog.watch("server", server.get_loop_monitor());
+    ASSERT_TRUE(watchdog.start());
+
+    TCPClientConfig client_config;
+    client_config.server_address = "127.0.0.1";
+    client_config.server_port = server.get_port();
+    PlainClient client("PlainClient", client_config);
+    ASSERT_TRUE(client.connect());
+    ASSERT_TRUE(wait_for([&]() { return server.last_client.load() != 0; }));
+    ASSERT_TRUE(client.send_data(std::string("slow")));
+    ASSERT_TRUE(wait_for([&]() { return server.handled.load() == 1; }));
+    ASSERT_TRUE(wait_for([&]() { return log.snapshot().size() >= 2; }));
+
+    auto reports = log.snapshot();
+    EXPECT_EQ(reports[0].loop, "server");
+    EXPECT_EQ(reports[0].callback, LoopCallback::Data);
+    EXPECT_EQ(reports[0].client_id, server.last_client.load());
+
+    const LatencyHistogram& data = server.get_loop_monitor().callback_histogram(LoopCallback::Data);
+    EXPECT_EQ(data.count(), 1u);
+    EXPECT_GE(data.max(), 70'000'000u);
+    EXPECT_EQ(server.get_loop_monitor().callback_histogram(LoopCallback::Connected).count(), 1u);
+
+    watchdog.stop();
+    client.disconnect();
+    server.stop();
+}
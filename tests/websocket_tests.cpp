@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+#include "../examples/logger.h"
+#include <slick/socket/websocket_server.h>
+#include <slick/socket/websocket_client.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace slick::socket;
+
+namespace
+{
+
+class EchoWebSocketServer : public WebSocketServerBase<EchoWebSocketServer>
+{
+public:
+    using WebSocketServerBase<EchoWebSocketServer>::WebSocketServerBase;
+
+    void onMessage(int client_id, const uint8_t* data, size_t length, bool binary)
+    {
+        if (binary)
+        {
+            send_binary(client_id, data, length);
+        }
+        else
+        {
+            send_text(client_id, std::string_view(reinterpret_cast<const char*>(data), length));
+        }
+    }
+
+    void onWebSocketOpen(int, const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        last_path = path;
+        ++opened;
+    }
+
+    void onWebSocketClose(int, uint16_t code)
+    {
+        last_close_code = code;
+        ++closed;
+    }
+
+    std::mutex mutex;
+    std::string last_path;
+    std::atomic<int> opened{0};
+    std::atomic<int> closed{0};
+    std::atomic<uint16_t> last_close_code{0};
+};
+
+class EchoWebSocketClient : public WebSocketClientBase<EchoWebSocketClient>
+{
+public:
+    using WebSocketClientBase<EchoWebSocketClient>::WebSocketClientBase;
+
+    void onMessage(const uint8_t* data, size_t length, bool binary)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.emplace_back(data, data + length);
+        binary_flags.push_back(binary);
+    }
+
+    void onWebSocketClose(uint16_t code)
+    {
+        last_close_code = code;
+    }
+
+    size_t message_count()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return messages.size();
+    }
+
+    std::mutex mutex;
+    std::vector<std::vector<uint8_t>> messages;
+    std::vector<bool> binary_flags;
+    std::atomic<uint16_t> last_close_code{0};
+};
+
+bool wait_for(const std::function<bool()>& condition, int timeout_ms = 5000)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (condition())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return condition();
+}
+
+std::vector<uint8_t> make_frame(WebSocketOpcode opcode, const std::string& payload, bool fin = true, const uint8_t* key = nullptr)
+{
+    std::vector<uint8_t> frame(websocket_max_header_size + payload.size());
+    size_t header_size = encode_websocket_header(frame.data(), opcode, payload.size(), fin, key);
+    if (key)
+    {
+        websocket_unmask(frame.data() + header_size, reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), key);
+    }
+    else
+    {
+        std::memcpy(frame.data() + header_size, payload.data(), payload.size());
+    }
+    frame.resize(header_size + payload.size());
+    return frame;
+}
+
+} // namespace
+
+TEST(WebSocketTest, AcceptKeyMatchesRfcExample) {
+    EXPECT_EQ(websocket_accept_key("dGhlIHNhbXBsZSBub25jZQ=="), "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+TEST(WebSocketTest, UnmaskMatchesScalarAtAnyLengthAndPhase) {
+    const uint8_t key[4] = {0x37, 0xFA, 0x21, 0x3D};
+    std::vector<uint8_t> source(301);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+
+    for (size_t length : {0u, 1u, 3u, 15u, 16u, 17u, 31u, 32u, 33u, 63u, 64u, 65u, 130u, 301u})
+    {
+        for (size_t phase = 0; phase < 4; ++phase)
+        {
+            std::vector<uint8_t> expected(length), actual(length);
+            for (size_t i = 0; i < length; ++i)
+            {
+                expected[i] = source[i] ^ key[(phase + i) & 3];
+            }
+            websocket_unmask(actual.data(), source.data(), length, key, phase);
+            EXPECT_EQ(actual, expected) << "length " << length << " phase " << phase;
+        }
+    }
+}
+
+TEST(WebSocketTest, ParserReassemblesFragmentsAcrossReads) {
+    const uint8_t key[4] = {1, 2, 3, 4};
+    std::vector<uint8_t> stream;
+    auto append = [&](const std::vector<uint8_t>& frame) { stream.insert(stream.end(), frame.begin(), frame.end()); };
+    append(make_frame(WebSocketOpcode::Text, "Hel", false, key));
+    append(make_frame(WebSocketOpcode::Ping, "p", true, key));   // control frames may interleave
+    append(make_frame(WebSocketOpcode::Continuation, "lo", true, key));
+    append(make_frame(WebSocketOpcode::Binary, std::string(70000, 'x'), true, key));
+
+    WebSocketParser parser(true);
+    std::vector<std::pair<WebSocketOpcode, std::string>> frames;
+    // One byte at a time exercises every header and payload split
+    for (uint8_t byte : stream)
+    {
+        ASSERT_TRUE(parser.feed(&byte, 1, [&](WebSocketOpcode opcode, const uint8_t* data, size_t length) {
+            frames.emplace_back(opcode, std::string(reinterpret_cast<const char*>(data), length));
+        }));
+    }
+
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[0].first, WebSocketOpcode::Ping);
+    EXPECT_EQ(frames[0].second, "p");
+    EXPECT_EQ(frames[1].first, WebSocketOpcode::Text);
+    EXPECT_EQ(frames[1].second, "Hello");
+    EXPECT_EQ(frames[2].first, WebSocketOpcode::Binary);
+    EXPECT_EQ(frames[2].second, std::string(70000, 'x'));
+}
+
+TEST(WebSocketTest, ParserDeliversWholeUnmaskedFramesInPlace) {
+    std::vector<uint8_t> stream = make_frame(WebSocketOpcode::Binary, "abcdef");
+    WebSocketParser parser(false);
+    const uint8_t* delivered = nullptr;
+    ASSERT_TRUE(parser.feed(stream.data(), stream.size(), [&](WebSocketOpcode, const uint8_t* data, size_t length) {
+        delivered = data;
+        EXPECT_EQ(length, 6u);
+    }));
+    EXPECT_EQ(delivered, stream.data() + 2);
+}
+
+TEST(WebSocketTest, ParserRejectsProtocolViolations) {
+    const uint8_t key[4] = {9, 8, 7, 6};
+    auto noop = [](WebSocketOpcode, const uint8_t*, size_t) {};
+
+    // Unmasked frame sent to a server
+    WebSocketParser unmasked(true);
+    auto frame = make_frame(WebSocketOpcode::Text, "hi");
+    EXPECT_FALSE(unmasked.feed(frame.data(), frame.size(), noop));
+    EXPECT_EQ(unmasked.close_code(), websocket_close::protocol_error);
+
+    // Fragmented control frame
+    WebSocketParser fragmented(true);
+    frame = make_frame(WebSocketOpcode::Ping, "x", false, key);
+    EXPECT_FALSE(fragmented.feed(frame.data(), frame.size(), noop));
+
+    // Continuation without a message
+    WebSocketParser continuation(true);
+    frame = make_frame(WebSocketOpcode::Continuation, "x", true, key);
+    EXPECT_FALSE(continuation.feed(frame.data(), frame.size(), noop));
+
+    // Over the size limit
+    WebSocketParser limited(true, 100);
+    frame = make_frame(WebSocketOpcode::Binary, std::string(101, 'a'), true, key);
+    EXPECT_FALSE(limited.feed(frame.data(), frame.size(), noop));
+    EXPECT_EQ(limited.close_code(), websocket_close::message_too_big);
+}
+
+TEST(WebSocketTest, ParserRejectsHugeContinuationLengths) {
+    const uint8_t key[4] = {9, 8, 7, 6};
+    auto noop = [](WebSocketOpcode, const uint8_t*, size_t) {};
+    auto huge_continuation = [&](uint64_t length) {
+        std::vector<uint8_t> frame = make_frame(WebSocketOpcode::Text, "start", false, key);
+        frame.push_back(0x80 | uint8_t(WebSocketOpcode::Continuation));
+        frame.push_back(0x80 | 127);
+        for (int shift = 56; shift >= 0; shift -= 8)
+        {
+            frame.push_back(uint8_t(length >> shift));
+        }
+        frame.insert(frame.end(), key, key + 4);
+        return frame;
+    };
+
+    // Would wrap message size + length past zero
+    WebSocketParser limited(true, 100);
+    auto frame = huge_continuation(0x7FFFFFFFFFFFFFFFull);
+    EXPECT_FALSE(limited.feed(frame.data(), frame.size(), noop));
+    EXPECT_EQ(limited.close_code(), websocket_close::message_too_big);
+
+    // Most significant bit of a 64-bit length must be clear
+    WebSocketParser msb(true, 100);
+    frame = huge_continuation(UINT64_MAX - 2);
+    EXPECT_FALSE(msb.feed(frame.data(), frame.size(), noop));
+    EXPECT_EQ(msb.close_code(), websocket_close::protocol_error);
+}
+
+TEST(WebSocketTest, ClientServerEchoAndClose) {
+    TCPServerConfig server_config;
+    server_config.port = 0;
+    server_config.bind_address = "127.0.0.1";
+    EchoWebSocketServer server("WebSocketServer", server_config);
+    ASSERT_TRUE(server.start());
+
+    TCPClientConfig client_config;
+    client_config.server_address = "127.0.0.1";
+    client_config.server_port = server.get_port();
+    WebSocketConfig websocket_config;
+    websocket_config.path = "/feed?depth=5";
+    EchoWebSocketClient client("WebSocketClient", client_config, websocket_config);
+    ASSERT_TRUE(client.connect());
+    ASSERT_TRUE(wait_for([&]() { return client.is_open(); }));
+    EXPECT_TRUE(wait_for([&]() { return server.opened.load() == 1; }));
+    {
+        std::lock_guard<std::mutex> lock(server.mutex);
+        EXPECT_EQ(server.last_path, "/feed?depth=5");
+    }
+
+    std::vector<uint8_t> large(200000);
+    for (size_t i = 0; i < large.size(); ++i)
+    {
+        large[i] = static_cast<uint8_t>(i * 13);
+    }
+    ASSERT_TRUE(client.send_text("hello"));
+    ASSERT_TRUE(client.ping("are you there"));
+    ASSERT_TRUE(client.send_binary(large.data(), large.size()));
+    ASSERT_TRUE(wait_for([&]() { return client.message_count() == 2; }));
+    {
+        std::lock_guard<std::mutex> lock(client.mutex);
+        EXPECT_EQ(std::string(client.messages[0].begin(), client.messages[0].end()), "hello");
+        EXPECT_FALSE(client.binary_flags[0]);
+        EXPECT_EQ(client.messages[1], large);
+        EXPECT_TRUE(client.binary_flags[1]);
+    }
+
+    client.close(websocket_close::going_away);
+    EXPECT_TRUE(wait_for([&]() { return server.closed.load() == 1; }));
+    EXPECT_EQ(server.last_close_code.load(), websocket_close::going_away);
+    EXPECT_EQ(client.last_close_code.load(), websocket_close::going_away);
+    server.stop();
+}